@@ -32,6 +32,7 @@
 #include "company_func.h"
 #include "effectvehicle_func.h"
 #include "station_base.h"
+#include "depot_kdtree.h"
 #include "engine_base.h"
 #include "core/random_func.hpp"
 #include "core/backup_type.hpp"
@@ -123,8 +124,6 @@ enum HelicopterRotorStates : uint8_t {
  */
 static StationID FindNearestHangar(const Aircraft *v)
 {
-	uint best = 0;
-	StationID index = StationID::Invalid();
 	TileIndex vtile = TileVirtXY(v->x_pos, v->y_pos);
 	const AircraftVehicleInfo *avi = AircraftVehInfo(v->engine_type);
 	uint max_range = v->acache.cached_max_range_sqr;
@@ -143,32 +142,26 @@ static StationID FindNearestHangar(const Aircraft *v)
 		}
 	}
 
-	for (const Station *st : Station::Iterate()) {
-		if (st->owner != v->owner || !st->facilities.Test(StationFacility::Airport) || !st->airport.HasHangar()) continue;
-
+	/* v->tile can't be used here, when aircraft is flying v->tile is set to 0 */
+	return FindNearestInKdtree(_hangar_kdtrees[v->owner], vtile, UINT_MAX, [&](StationID index) {
+		const Station *st = Station::Get(index);
 		const AirportFTAClass *afc = st->airport.GetFTA();
 
 		/* don't crash the plane if we know it can't land at the airport */
-		if (afc->flags.Test(AirportFTAClass::Flag::ShortStrip) && (avi->subtype & AIR_FAST) && !_cheats.no_jetcrash.value) continue;
+		if (afc->flags.Test(AirportFTAClass::Flag::ShortStrip) && (avi->subtype & AIR_FAST) && !_cheats.no_jetcrash.value) return false;
 
 		/* the plane won't land at any helicopter station */
-		if (!afc->flags.Test(AirportFTAClass::Flag::Airplanes) && (avi->subtype & AIR_CTOL)) continue;
+		if (!afc->flags.Test(AirportFTAClass::Flag::Airplanes) && (avi->subtype & AIR_CTOL)) return false;
 
 		/* Check if our last and next destinations can be reached from the depot airport. */
 		if (max_range != 0) {
 			uint last_dist = (last_dest != nullptr && last_dest->airport.tile != INVALID_TILE) ? DistanceSquare(st->airport.tile, last_dest->airport.tile) : 0;
 			uint next_dist = (next_dest != nullptr && next_dest->airport.tile != INVALID_TILE) ? DistanceSquare(st->airport.tile, next_dest->airport.tile) : 0;
-			if (last_dist > max_range || next_dist > max_range) continue;
+			if (last_dist > max_range || next_dist > max_range) return false;
 		}
 
-		/* v->tile can't be used here, when aircraft is flying v->tile is set to 0 */
-		uint distance = DistanceSquare(vtile, st->airport.tile);
-		if (distance < best || index == StationID::Invalid()) {
-			best = distance;
-			index = st->index;
-		}
-	}
-	return index;
+		return true;
+	});
 }
 
 void Aircraft::GetImage(Direction direction, EngineImageType image_type, VehicleSpriteSeq *result) const
@@ -0,0 +1,268 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file 32bpp_anim_avx2.cpp Implementation of the AVX2 32 bpp blitter with animation support. */
+
+#ifdef WITH_SSE
+
+#include "../stdafx.h"
+#include "../zoom_func.h"
+#include "../palette_func.h"
+#include "../video/video_driver.hpp"
+#include "../table/sprites.h"
+#include "32bpp_anim_avx2.hpp"
+#include "32bpp_avx2_func.hpp"
+
+#include "../safeguards.h"
+
+/** Instantiation of the AVX2 32bpp blitter factory. */
+static FBlitter_32bppAVX2_Anim iFBlitter_32bppAVX2_Anim;
+
+/**
+ * Replace the colour of the palette animated pixels of a block of AVX2_PIXELS pixels by their current colour.
+ * @param blitter The blitter, to look up colours in its palette.
+ * @param src The source pixels.
+ * @param mvs The map values of the source pixels, as returned by LoadMapValuesAVX2.
+ * @return The source pixels with their current colour.
+ */
+GNU_TARGET("avx2")
+static inline __m256i AnimatePixelsAVX2(Blitter_32bppAVX2_Anim *blitter, __m256i src, __m128i mvs)
+{
+	const __m128i m = _mm_and_si128(mvs, _mm_set1_epi16(0x00FF));
+	if (_mm_movemask_epi8(_mm_cmpgt_epi16(m, _mm_set1_epi16(PALETTE_ANIM_START - 1))) == 0) return src;
+
+	alignas(16) Blitter_32bppSSE_Base::MapValue map_values[AVX2_PIXELS];
+	alignas(32) Colour pixels[AVX2_PIXELS];
+	_mm_store_si128((__m128i *)map_values, mvs);
+	_mm256_store_si256((__m256i *)pixels, src);
+	for (int i = 0; i < AVX2_PIXELS; i++) {
+		if (map_values[i].m < PALETTE_ANIM_START) continue;
+
+		Colour colour = blitter->LookupColourInPalette(map_values[i].m);
+		colour.a = pixels[i].a;
+		pixels[i] = AdjustBrightness(colour, map_values[i].v);
+	}
+	return _mm256_load_si256((const __m256i *)pixels);
+}
+
+/**
+ * Get the values to store in the animation buffer for the opaque pixels of a colour remapped block.
+ * @param mvs The map values of the source pixels, as returned by LoadMapValuesAVX2.
+ * @param remap The colour remap.
+ * @return The remapped colour and brightness of each pixel, or 0 for pixels without a remappable colour.
+ */
+GNU_TARGET("avx2")
+static inline __m128i GetRemappedAnimValuesAVX2(__m128i mvs, const uint8_t *remap)
+{
+	const __m128i m = _mm_and_si128(mvs, _mm_set1_epi16(0x00FF));
+	if (_mm_testz_si128(m, m)) return _mm_setzero_si128();
+
+	alignas(16) uint16_t values[AVX2_PIXELS];
+	_mm_store_si128((__m128i *)values, mvs);
+	for (uint16_t &value : values) {
+		/* Replace the colour index by its remapped index; keep the brightness. */
+		if (GB(value, 0, 8) != 0) SB(value, 0, 8, remap[GB(value, 0, 8)]);
+	}
+	return _mm_andnot_si128(_mm_cmpeq_epi16(m, _mm_setzero_si128()), _mm_load_si128((const __m128i *)values));
+}
+
+/**
+ * Update the animation buffer for a block of at most AVX2_PIXELS pixels.
+ * Opaque pixels get the given value, translucent pixels get 0 and transparent pixels are left alone.
+ * @param anim The animation buffer at the first pixel of the block.
+ * @param src The source pixels.
+ * @param opaque_values The values for opaque pixels.
+ * @param count The number of pixels in the block.
+ */
+GNU_TARGET("avx2")
+static inline void UpdateAnimBufferAVX2(uint16_t *anim, __m256i src, __m128i opaque_values, int count)
+{
+	const __m128i alpha = GetAlphaOfEightPixelsAVX2(src);
+	const __m128i values = _mm_and_si128(opaque_values, _mm_cmpeq_epi16(alpha, _mm_set1_epi16(255)));
+	const __m128i transparent = _mm_cmpeq_epi16(alpha, _mm_setzero_si128());
+
+	if (count == AVX2_PIXELS) {
+		const __m128i old = _mm_loadu_si128((const __m128i *)anim);
+		_mm_storeu_si128((__m128i *)anim, _mm_blendv_epi8(values, old, transparent));
+		return;
+	}
+
+	alignas(16) uint16_t new_values[AVX2_PIXELS];
+	alignas(16) uint16_t keep[AVX2_PIXELS];
+	_mm_store_si128((__m128i *)new_values, values);
+	_mm_store_si128((__m128i *)keep, transparent);
+	for (int i = 0; i < count; i++) {
+		if (keep[i] == 0) anim[i] = new_values[i];
+	}
+}
+
+/**
+ * Draws a sprite to a (screen) buffer. It is templated to allow faster operation.
+ *
+ * @tparam mode blitter mode
+ * @tparam read_mode whether to use the margins of the sprite lines
+ * @tparam translucent whether the sprite has pixels that are neither fully opaque nor fully transparent
+ * @tparam animated whether the sprite has palette animated pixels
+ * @param bp further blitting parameters
+ * @param zoom zoom level at which we are drawing
+ */
+template <BlitterMode mode, Blitter_32bppSSE_Base::ReadMode read_mode, bool translucent, bool animated>
+GNU_TARGET("avx2")
+inline void Blitter_32bppAVX2_Anim::Draw(const Blitter::BlitterParams *bp, ZoomLevel zoom)
+{
+	const uint8_t * const remap = bp->remap;
+	Colour *dst_line = (Colour *) bp->dst + bp->top * bp->pitch + bp->left;
+	uint16_t *anim_line = this->anim_buf + this->ScreenToAnimOffset((uint32_t *)bp->dst) + bp->top * this->anim_buf_pitch + bp->left;
+	int effective_width = bp->width;
+
+	/* Find where to start reading in the source sprite. */
+	const Blitter_32bppSSE_Base::SpriteData * const sd = (const Blitter_32bppSSE_Base::SpriteData *) bp->sprite;
+	const SpriteInfo * const si = &sd->infos[zoom];
+	const MapValue *src_mv_line = (const MapValue *) &sd->data[si->mv_offset] + bp->skip_top * si->sprite_width;
+	const Colour *src_rgba_line = (const Colour *) ((const uint8_t *) &sd->data[si->sprite_offset] + bp->skip_top * si->sprite_line_size);
+
+	if (read_mode != RM_WITH_MARGIN) {
+		src_rgba_line += bp->skip_left;
+		src_mv_line += bp->skip_left;
+	}
+
+	for (int y = bp->height; y != 0; y--) {
+		Colour *dst = dst_line;
+		const Colour *src = src_rgba_line + META_LENGTH;
+		const MapValue *src_mv = src_mv_line;
+		uint16_t *anim = anim_line;
+
+		if (read_mode == RM_WITH_MARGIN) {
+			anim += src_rgba_line[0].data;
+			src += src_rgba_line[0].data;
+			dst += src_rgba_line[0].data;
+			src_mv += src_rgba_line[0].data;
+			const int width_diff = si->sprite_width - bp->width;
+			effective_width = bp->width - (int) src_rgba_line[0].data;
+			const int delta_diff = (int) src_rgba_line[1].data - width_diff;
+			const int new_width = effective_width - delta_diff;
+			effective_width = delta_diff > 0 ? new_width : effective_width;
+		}
+
+		switch (mode) {
+			default:
+			case BlitterMode::ColourRemap:
+			case BlitterMode::Transparent:
+				for (int x = effective_width; x > 0; x -= AVX2_PIXELS) {
+					const int count = std::min(x, AVX2_PIXELS);
+					const __m256i mask = GetPixelMaskAVX2(count);
+					const __m256i srcABCD = LoadPixelsAVX2(src, count, mask);
+
+					/* Fully transparent blocks leave the destination untouched. */
+					if (!_mm256_testz_si256(srcABCD, _mm256_set1_epi32(static_cast<int>(0xFF000000)))) {
+						const __m256i dstABCD = LoadPixelsAVX2(dst, count, mask);
+						switch (mode) {
+							default: {
+								__m128i mvs = _mm_setzero_si128();
+								__m256i colours = srcABCD;
+								if (animated) {
+									mvs = LoadMapValuesAVX2(src_mv, count);
+									colours = AnimatePixelsAVX2(this, colours, mvs);
+								}
+								StorePixelsAVX2(dst, translucent ? ComposeEightPixelsAVX2(colours, dstABCD) : SelectEightPixelsAVX2(colours, dstABCD), count, mask);
+								UpdateAnimBufferAVX2(anim, srcABCD, mvs, count);
+								break;
+							}
+
+							case BlitterMode::ColourRemap: {
+								const __m128i mvs = LoadMapValuesAVX2(src_mv, count);
+								const __m256i colours = RemapPixelsAVX2(this->palette.palette, srcABCD, mvs, remap);
+								StorePixelsAVX2(dst, ComposeEightPixelsAVX2(colours, dstABCD), count, mask);
+								UpdateAnimBufferAVX2(anim, srcABCD, animated ? GetRemappedAnimValuesAVX2(mvs, remap) : _mm_setzero_si128(), count);
+								break;
+							}
+
+							case BlitterMode::Transparent:
+								/* Make the current colour a bit more black, so it looks like this image is transparent. */
+								StorePixelsAVX2(dst, DarkenEightPixelsAVX2(srcABCD, dstABCD), count, mask);
+								UpdateAnimBufferAVX2(anim, srcABCD, _mm_setzero_si128(), count);
+								break;
+						}
+					}
+
+					src_mv += AVX2_PIXELS;
+					src += AVX2_PIXELS;
+					dst += AVX2_PIXELS;
+					anim += AVX2_PIXELS;
+				}
+				break;
+		}
+
+		src_mv_line += si->sprite_width;
+		src_rgba_line = (const Colour*) ((const uint8_t*) src_rgba_line + si->sprite_line_size);
+		dst_line += bp->pitch;
+		anim_line += this->anim_buf_pitch;
+	}
+}
+
+/**
+ * Draws a sprite to a (screen) buffer. Calls adequate templated function.
+ *
+ * @param bp further blitting parameters
+ * @param mode blitter mode
+ * @param zoom zoom level at which we are drawing
+ */
+void Blitter_32bppAVX2_Anim::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom)
+{
+	if (_screen_disable_anim) {
+		/* This means our output is not to the screen, so we can't be doing any animation stuff, so use our parent Draw() */
+		Blitter_32bppSSE4_Anim::Draw(bp, mode, zoom);
+		return;
+	}
+
+	const Blitter_32bppSSE_Base::SpriteFlags sprite_flags = ((const Blitter_32bppSSE_Base::SpriteData *) bp->sprite)->flags;
+	const bool margin = bp->skip_left == 0 && bp->width > (mode == BlitterMode::ColourRemap ? MARGIN_REMAP_THRESHOLD : MARGIN_NORMAL_THRESHOLD);
+	switch (mode) {
+		default:
+bm_normal:
+			if (margin) {
+				if (sprite_flags & SF_TRANSLUCENT) {
+					if (sprite_flags & SF_NO_ANIM) Draw<BlitterMode::Normal, RM_WITH_MARGIN, true, false>(bp, zoom);
+					else                           Draw<BlitterMode::Normal, RM_WITH_MARGIN, true, true>(bp, zoom);
+				} else {
+					if (sprite_flags & SF_NO_ANIM) Draw<BlitterMode::Normal, RM_WITH_MARGIN, false, false>(bp, zoom);
+					else                           Draw<BlitterMode::Normal, RM_WITH_MARGIN, false, true>(bp, zoom);
+				}
+			} else {
+				if (sprite_flags & SF_TRANSLUCENT) {
+					if (sprite_flags & SF_NO_ANIM) Draw<BlitterMode::Normal, RM_WITH_SKIP, true, false>(bp, zoom);
+					else                           Draw<BlitterMode::Normal, RM_WITH_SKIP, true, true>(bp, zoom);
+				} else {
+					if (sprite_flags & SF_NO_ANIM) Draw<BlitterMode::Normal, RM_WITH_SKIP, false, false>(bp, zoom);
+					else                           Draw<BlitterMode::Normal, RM_WITH_SKIP, false, true>(bp, zoom);
+				}
+			}
+			break;
+
+		case BlitterMode::ColourRemap:
+			if (sprite_flags & SF_NO_REMAP) goto bm_normal;
+			if (margin) {
+				if (sprite_flags & SF_NO_ANIM) Draw<BlitterMode::ColourRemap, RM_WITH_MARGIN, true, false>(bp, zoom);
+				else                           Draw<BlitterMode::ColourRemap, RM_WITH_MARGIN, true, true>(bp, zoom);
+			} else {
+				if (sprite_flags & SF_NO_ANIM) Draw<BlitterMode::ColourRemap, RM_WITH_SKIP, true, false>(bp, zoom);
+				else                           Draw<BlitterMode::ColourRemap, RM_WITH_SKIP, true, true>(bp, zoom);
+			}
+			break;
+
+		case BlitterMode::Transparent: Draw<BlitterMode::Transparent, RM_NONE, true, true>(bp, zoom); return;
+
+		/* The remaining modes are rare; leave them to the SSE4 blitter. */
+		case BlitterMode::TransparentRemap:
+		case BlitterMode::CrashRemap:
+		case BlitterMode::BlackRemap:
+			Blitter_32bppSSE4_Anim::Draw(bp, mode, zoom);
+			return;
+	}
+}
+
+#endif /* WITH_SSE */
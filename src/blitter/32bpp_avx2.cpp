@@ -0,0 +1,170 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file 32bpp_avx2.cpp Implementation of the AVX2 32 bpp blitter. */
+
+#ifdef WITH_SSE
+
+#include "../stdafx.h"
+#include "../zoom_func.h"
+#include "../palette_func.h"
+#include "32bpp_avx2.hpp"
+#include "32bpp_avx2_func.hpp"
+
+#include "../safeguards.h"
+
+/** Instantiation of the AVX2 32bpp blitter factory. */
+static FBlitter_32bppAVX2 iFBlitter_32bppAVX2;
+
+/**
+ * Draws a block of at most AVX2_PIXELS pixels.
+ *
+ * @tparam mode blitter mode
+ * @tparam translucent whether the sprite has pixels that are neither fully opaque nor fully transparent
+ * @param src the source pixels
+ * @param dst the destination pixels
+ * @param src_mv the map values of the source pixels
+ * @param count the number of pixels in the block
+ * @param remap the colour remap
+ */
+template <BlitterMode mode, bool translucent>
+GNU_TARGET("avx2")
+static inline void DrawPixelsAVX2(const Colour *src, Colour *dst, const Blitter_32bppSSE_Base::MapValue *src_mv, int count, const uint8_t *remap)
+{
+	const __m256i mask = GetPixelMaskAVX2(count);
+	const __m256i srcABCD = LoadPixelsAVX2(src, count, mask);
+
+	switch (mode) {
+		default:
+			/* Fully transparent blocks leave the destination untouched. */
+			if (!_mm256_testz_si256(srcABCD, _mm256_set1_epi32(static_cast<int>(0xFF000000)))) {
+				const __m256i dstABCD = LoadPixelsAVX2(dst, count, mask);
+				StorePixelsAVX2(dst, translucent ? ComposeEightPixelsAVX2(srcABCD, dstABCD) : SelectEightPixelsAVX2(srcABCD, dstABCD), count, mask);
+			}
+			break;
+
+		case BlitterMode::ColourRemap:
+			if (!_mm256_testz_si256(srcABCD, _mm256_set1_epi32(static_cast<int>(0xFF000000)))) {
+				const __m256i dstABCD = LoadPixelsAVX2(dst, count, mask);
+				const __m256i colours = RemapPixelsAVX2(_cur_palette.palette, srcABCD, LoadMapValuesAVX2(src_mv, count), remap);
+				StorePixelsAVX2(dst, ComposeEightPixelsAVX2(colours, dstABCD), count, mask);
+			}
+			break;
+
+		case BlitterMode::Transparent: {
+			/* Make the current colour a bit more black, so it looks like this image is transparent. */
+			const __m256i dstABCD = LoadPixelsAVX2(dst, count, mask);
+			StorePixelsAVX2(dst, DarkenEightPixelsAVX2(srcABCD, dstABCD), count, mask);
+			break;
+		}
+	}
+}
+
+/**
+ * Draws a sprite to a (screen) buffer. It is templated to allow faster operation.
+ *
+ * @tparam mode blitter mode
+ * @tparam read_mode whether to use the margins of the sprite lines
+ * @tparam translucent whether the sprite has pixels that are neither fully opaque nor fully transparent
+ * @param bp further blitting parameters
+ * @param zoom zoom level at which we are drawing
+ */
+template <BlitterMode mode, Blitter_32bppSSE_Base::ReadMode read_mode, bool translucent>
+GNU_TARGET("avx2")
+inline void Blitter_32bppAVX2::Draw(const Blitter::BlitterParams *bp, ZoomLevel zoom)
+{
+	const uint8_t * const remap = bp->remap;
+	Colour *dst_line = (Colour *) bp->dst + bp->top * bp->pitch + bp->left;
+	int effective_width = bp->width;
+
+	/* Find where to start reading in the source sprite. */
+	const SpriteData * const sd = (const SpriteData *) bp->sprite;
+	const SpriteInfo * const si = &sd->infos[zoom];
+	const MapValue *src_mv_line = (const MapValue *) &sd->data[si->mv_offset] + bp->skip_top * si->sprite_width;
+	const Colour *src_rgba_line = (const Colour *) ((const uint8_t *) &sd->data[si->sprite_offset] + bp->skip_top * si->sprite_line_size);
+
+	if (read_mode != RM_WITH_MARGIN) {
+		src_rgba_line += bp->skip_left;
+		src_mv_line += bp->skip_left;
+	}
+
+	for (int y = bp->height; y != 0; y--) {
+		Colour *dst = dst_line;
+		const Colour *src = src_rgba_line + META_LENGTH;
+		const MapValue *src_mv = src_mv_line;
+
+		if (read_mode == RM_WITH_MARGIN) {
+			src += src_rgba_line[0].data;
+			dst += src_rgba_line[0].data;
+			src_mv += src_rgba_line[0].data;
+			const int width_diff = si->sprite_width - bp->width;
+			effective_width = bp->width - (int) src_rgba_line[0].data;
+			const int delta_diff = (int) src_rgba_line[1].data - width_diff;
+			const int new_width = effective_width - delta_diff;
+			effective_width = delta_diff > 0 ? new_width : effective_width;
+		}
+
+		int x = effective_width;
+		for (; x >= AVX2_PIXELS; x -= AVX2_PIXELS) {
+			DrawPixelsAVX2<mode, translucent>(src, dst, src_mv, AVX2_PIXELS, remap);
+			src += AVX2_PIXELS;
+			dst += AVX2_PIXELS;
+			src_mv += AVX2_PIXELS;
+		}
+		if (x > 0) DrawPixelsAVX2<mode, translucent>(src, dst, src_mv, x, remap);
+
+		src_mv_line += si->sprite_width;
+		src_rgba_line = (const Colour*) ((const uint8_t*) src_rgba_line + si->sprite_line_size);
+		dst_line += bp->pitch;
+	}
+}
+
+/**
+ * Draws a sprite to a (screen) buffer. Calls adequate templated function.
+ * The modes that are not vectorised are drawn by the SSE4 blitter, which uses the same sprite format.
+ *
+ * @param bp further blitting parameters
+ * @param mode blitter mode
+ * @param zoom zoom level at which we are drawing
+ */
+void Blitter_32bppAVX2::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom)
+{
+	const Blitter_32bppSSE_Base::SpriteFlags sprite_flags = ((const Blitter_32bppSSE_Base::SpriteData *) bp->sprite)->flags;
+	switch (mode) {
+		case BlitterMode::Normal:
+bm_normal:
+			if (bp->skip_left != 0 || bp->width <= MARGIN_NORMAL_THRESHOLD) {
+				if (sprite_flags & SF_TRANSLUCENT) {
+					Draw<BlitterMode::Normal, RM_WITH_SKIP, true>(bp, zoom);
+				} else {
+					Draw<BlitterMode::Normal, RM_WITH_SKIP, false>(bp, zoom);
+				}
+			} else {
+				if (sprite_flags & SF_TRANSLUCENT) {
+					Draw<BlitterMode::Normal, RM_WITH_MARGIN, true>(bp, zoom);
+				} else {
+					Draw<BlitterMode::Normal, RM_WITH_MARGIN, false>(bp, zoom);
+				}
+			}
+			return;
+
+		case BlitterMode::ColourRemap:
+			if (sprite_flags & SF_NO_REMAP) goto bm_normal;
+			if (bp->skip_left != 0 || bp->width <= MARGIN_REMAP_THRESHOLD) {
+				Draw<BlitterMode::ColourRemap, RM_WITH_SKIP, true>(bp, zoom);
+			} else {
+				Draw<BlitterMode::ColourRemap, RM_WITH_MARGIN, true>(bp, zoom);
+			}
+			return;
+
+		case BlitterMode::Transparent: Draw<BlitterMode::Transparent, RM_NONE, true>(bp, zoom); return;
+
+		default: Blitter_32bppSSE4::Draw(bp, mode, zoom); return;
+	}
+}
+
+#endif /* WITH_SSE */
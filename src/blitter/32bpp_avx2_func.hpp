@@ -0,0 +1,288 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file 32bpp_avx2_func.hpp Functions related to the AVX2 32 bpp blitters. */
+
+#ifndef BLITTER_32BPP_AVX2_FUNC_HPP
+#define BLITTER_32BPP_AVX2_FUNC_HPP
+
+#ifdef WITH_SSE
+
+#include <immintrin.h>
+
+/* These functions are compiled for AVX2 while the rest of the game is not.
+ * Only ever call them from code that is itself compiled for AVX2 and
+ * only after HasAVX2Support() returned true.
+ */
+
+/** Number of pixels processed per iteration of the AVX2 loops. */
+static constexpr int AVX2_PIXELS = 8;
+
+/** Copies the brightness of a map value to the colour bytes of a pixel. */
+#define AVX2_BRIGHTNESS_CONTROL_MASK _mm256_setr_epi8(1, 1, 1, -1, 5, 5, 5, -1, 9, 9, 9, -1, 13, 13, 13, -1, 1, 1, 1, -1, 5, 5, 5, -1, 9, 9, 9, -1, 13, 13, 13, -1)
+/** Per 128 bit lane the same control mask as ALPHA_CONTROL_MASK, which copies the alpha word of a pixel to its colour words. */
+#define AVX2_ALPHA_CONTROL_MASK     _mm256_setr_epi8(6, 7, 6, 7, 6, 7, -1, -1, 14, 15, 14, 15, 14, 15, -1, -1, 6, 7, 6, 7, 6, 7, -1, -1, 14, 15, 14, 15, 14, 15, -1, -1)
+#define AVX2_ALPHA_AND_MASK         _mm256_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1)
+#define AVX2_CLEAR_HIGH_BYTE_MASK   _mm256_set1_epi16(0x00FF)
+#define AVX2_TRANSPARENT_NOM_BASE   _mm256_set1_epi16(256)
+#define AVX2_BRIGHTNESS_DIV_CLEANER _mm256_setr_epi16(0x1FF, 0x1FF, 0x1FF, 0xFF, 0x1FF, 0x1FF, 0x1FF, 0xFF, 0x1FF, 0x1FF, 0x1FF, 0xFF, 0x1FF, 0x1FF, 0x1FF, 0xFF)
+#define AVX2_OVERBRIGHT_VALUE_MASK  _mm256_setr_epi16(0xFF, 0xFF, 0xFF, 0, 0xFF, 0xFF, 0xFF, 0, 0xFF, 0xFF, 0xFF, 0, 0xFF, 0xFF, 0xFF, 0)
+/** Per 128 bit lane the same control mask as OVERBRIGHT_CONTROL_MASK, which copies the overbright sum of a pixel to its colour words. */
+#define AVX2_OVERBRIGHT_CONTROL_MASK _mm256_setr_epi8(0, 1, 0, 1, 0, 1, 7, 7, 2, 3, 2, 3, 2, 3, 7, 7, 0, 1, 0, 1, 0, 1, 7, 7, 2, 3, 2, 3, 2, 3, 7, 7)
+
+/**
+ * Get the mask to load or store the first \a count pixels of a block.
+ * @param count The number of pixels, at most AVX2_PIXELS.
+ * @return All bits set for the pixels that are part of the block.
+ */
+GNU_TARGET("avx2")
+static inline __m256i GetPixelMaskAVX2(int count)
+{
+	return _mm256_cmpgt_epi32(_mm256_set1_epi32(count), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+/**
+ * Load a block of at most AVX2_PIXELS pixels.
+ * @param from The first pixel.
+ * @param count The number of pixels to load.
+ * @param mask The result of GetPixelMaskAVX2 for \a count.
+ * @return The pixels; pixels past \a count are zero.
+ */
+GNU_TARGET("avx2")
+static inline __m256i LoadPixelsAVX2(const Colour *from, int count, const __m256i &mask)
+{
+	if (count == AVX2_PIXELS) return _mm256_loadu_si256((const __m256i *)from);
+	return _mm256_maskload_epi32((const int *)from, mask);
+}
+
+/**
+ * Store a block of at most AVX2_PIXELS pixels.
+ * @param to The first pixel.
+ * @param pixels The pixels to store.
+ * @param count The number of pixels to store.
+ * @param mask The result of GetPixelMaskAVX2 for \a count.
+ */
+GNU_TARGET("avx2")
+static inline void StorePixelsAVX2(Colour *to, __m256i pixels, int count, const __m256i &mask)
+{
+	if (count == AVX2_PIXELS) {
+		_mm256_storeu_si256((__m256i *)to, pixels);
+	} else {
+		_mm256_maskstore_epi32((int *)to, mask, pixels);
+	}
+}
+
+/**
+ * Alpha blend four pixels that are expanded to 16 bits per channel; same as AlphaBlendTwoPixels but for two pixels per lane.
+ * @param src The source pixels.
+ * @param dst The destination pixels.
+ * @return The blended pixels, 16 bits per channel.
+ */
+GNU_TARGET("avx2")
+static inline __m256i AlphaBlendFourPixelsAVX2(__m256i src, __m256i dst)
+{
+	__m256i alpha_mask = _mm256_cmpgt_epi16(src, _mm256_setzero_si256()); // (alpha > 0) ? 0xFFFF : 0
+	__m256i alpha = _mm256_sub_epi16(src, alpha_mask);                     // if (alpha > 0) a++;
+	alpha = _mm256_shuffle_epi8(alpha, AVX2_ALPHA_CONTROL_MASK);
+
+	src = _mm256_sub_epi16(src, dst);       //   (r - Cr)
+	src = _mm256_mullo_epi16(src, alpha);   // a*(r - Cr)
+	src = _mm256_srli_epi16(src, 8);        // a*(r - Cr)/256
+	src = _mm256_add_epi16(src, dst);       // a*(r - Cr)/256 + Cr
+
+	alpha_mask = _mm256_and_si256(alpha_mask, AVX2_ALPHA_AND_MASK); // set non alpha fields to 0
+	return _mm256_or_si256(src, alpha_mask);                        // set alpha fields to 0xFFFF if src alpha was > 0
+}
+
+/**
+ * Alpha blend eight pixels; gives the same result as AlphaBlendTwoPixels on each pair.
+ * @param src The source pixels.
+ * @param dst The destination pixels.
+ * @return The blended pixels.
+ */
+GNU_TARGET("avx2")
+static inline __m256i AlphaBlendEightPixelsAVX2(__m256i src, __m256i dst)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i clear_hi = AVX2_CLEAR_HIGH_BYTE_MASK;
+
+	/* Unpacking and packing both work per lane, so the pixel order is preserved. */
+	__m256i lo = AlphaBlendFourPixelsAVX2(_mm256_unpacklo_epi8(src, zero), _mm256_unpacklo_epi8(dst, zero));
+	__m256i hi = AlphaBlendFourPixelsAVX2(_mm256_unpackhi_epi8(src, zero), _mm256_unpackhi_epi8(dst, zero));
+
+	/* Keep the low bytes, without saturation. */
+	return _mm256_packus_epi16(_mm256_and_si256(lo, clear_hi), _mm256_and_si256(hi, clear_hi));
+}
+
+/**
+ * Draw eight pixels onto the destination, skipping the blend for fully transparent or fully opaque blocks.
+ * @param src The source pixels.
+ * @param dst The destination pixels.
+ * @return The resulting pixels.
+ */
+GNU_TARGET("avx2")
+static inline __m256i ComposeEightPixelsAVX2(__m256i src, __m256i dst)
+{
+	const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+	const __m256i src_alpha = _mm256_and_si256(src, alpha);
+	if (_mm256_testz_si256(src_alpha, src_alpha)) return dst;
+	if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(src_alpha, alpha)) == -1) return src;
+	return AlphaBlendEightPixelsAVX2(src, dst);
+}
+
+/**
+ * Draw eight pixels whose alpha is either 0 or 255 onto the destination.
+ * @param src The source pixels.
+ * @param dst The destination pixels.
+ * @return The resulting pixels.
+ */
+GNU_TARGET("avx2")
+static inline __m256i SelectEightPixelsAVX2(__m256i src, __m256i dst)
+{
+	/* The sign bit of each pixel is the top bit of its alpha. */
+	return _mm256_blendv_epi8(dst, src, _mm256_srai_epi32(src, 31));
+}
+
+/**
+ * Darken eight pixels; gives the same result as DarkenTwoPixels on each pair.
+ * rgb = rgb * ((256/4) * 4 - (alpha/4)) / ((256/4) * 4)
+ * @param src The source pixels, only their alpha is used.
+ * @param dst The destination pixels.
+ * @return The darkened destination pixels.
+ */
+GNU_TARGET("avx2")
+static inline __m256i DarkenEightPixelsAVX2(__m256i src, __m256i dst)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i a_cm = AVX2_ALPHA_CONTROL_MASK;
+	const __m256i tr_nom_base = AVX2_TRANSPARENT_NOM_BASE;
+
+	__m256i alpha_lo = _mm256_srli_epi16(_mm256_shuffle_epi8(_mm256_unpacklo_epi8(src, zero), a_cm), 2);
+	__m256i alpha_hi = _mm256_srli_epi16(_mm256_shuffle_epi8(_mm256_unpackhi_epi8(src, zero), a_cm), 2);
+	__m256i dst_lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(dst, zero), _mm256_sub_epi16(tr_nom_base, alpha_lo));
+	__m256i dst_hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(dst, zero), _mm256_sub_epi16(tr_nom_base, alpha_hi));
+	return _mm256_packus_epi16(_mm256_srli_epi16(dst_lo, 8), _mm256_srli_epi16(dst_hi, 8));
+}
+
+/**
+ * Adjust the brightness of four pixels that are expanded to 16 bits per channel; same as AdjustBrightnessOfTwoPixels but for two pixels per lane.
+ * @param colour The pixels.
+ * @param brightness The brightness of each pixel in its colour words and DEFAULT_BRIGHTNESS in its alpha word.
+ * @return The adjusted pixels, 16 bits per channel.
+ */
+GNU_TARGET("avx2")
+static inline __m256i AdjustBrightnessOfFourPixelsAVX2(__m256i colour, __m256i brightness)
+{
+	const __m256i white = AVX2_OVERBRIGHT_VALUE_MASK;
+
+	colour = _mm256_mullo_epi16(colour, brightness);
+	__m256i overbright = _mm256_srli_epi16(colour, 8 + 7);
+	colour = _mm256_and_si256(_mm256_srli_epi16(colour, 7), AVX2_BRIGHTNESS_DIV_CLEANER);
+
+	/* Sum overbright.
+	 * Maximum for each rgb is 508 => 9 bits. The highest bit tells if there is overbright.
+	 * -255 is changed in -256 so we just have to take the 8 lower bits into account.
+	 */
+	overbright = _mm256_and_si256(_mm256_mullo_epi16(overbright, white), colour);
+	overbright = _mm256_hadd_epi16(_mm256_hadd_epi16(overbright, _mm256_setzero_si256()), _mm256_setzero_si256());
+	overbright = _mm256_srli_epi16(overbright, 1); // Reduce overbright strength.
+	overbright = _mm256_shuffle_epi8(overbright, AVX2_OVERBRIGHT_CONTROL_MASK);
+
+	__m256i ret = _mm256_subs_epu16(white, colour); //    (255 - rgb)
+	ret = _mm256_mullo_epi16(ret, overbright);      // ob*(255 - rgb)
+	ret = _mm256_srli_epi16(ret, 8);                // ob*(255 - rgb)/256
+	return _mm256_add_epi16(ret, colour);           // ob*(255 - rgb)/256 + rgb
+}
+
+/**
+ * Adjust the brightness of eight pixels; gives the same result as AdjustBrightnessOfTwoPixels on each pair.
+ * @param from The pixels.
+ * @param mvs The map values of the pixels, as returned by LoadMapValuesAVX2.
+ * @return The adjusted pixels.
+ */
+GNU_TARGET("avx2")
+static inline __m256i AdjustBrightnessOfEightPixelsAVX2(__m256i from, __m128i mvs)
+{
+	const __m256i zero = _mm256_setzero_si256();
+
+	/* Lay out the brightness like a pixel, so it can be expanded the same way. */
+	__m256i brightness = _mm256_shuffle_epi8(_mm256_cvtepu16_epi32(mvs), AVX2_BRIGHTNESS_CONTROL_MASK);
+	brightness = _mm256_or_si256(brightness, _mm256_set1_epi32(DEFAULT_BRIGHTNESS << 24));
+
+	__m256i lo = AdjustBrightnessOfFourPixelsAVX2(_mm256_unpacklo_epi8(from, zero), _mm256_unpacklo_epi8(brightness, zero));
+	__m256i hi = AdjustBrightnessOfFourPixelsAVX2(_mm256_unpackhi_epi8(from, zero), _mm256_unpackhi_epi8(brightness, zero));
+	return _mm256_packus_epi16(lo, hi);
+}
+
+/**
+ * Get the alpha of eight pixels as 16 bit values, in pixel order.
+ * @param src The pixels.
+ * @return The alpha of each pixel.
+ */
+GNU_TARGET("avx2")
+static inline __m128i GetAlphaOfEightPixelsAVX2(__m256i src)
+{
+	__m256i alpha = _mm256_srli_epi32(src, 24);
+	alpha = _mm256_packus_epi32(alpha, alpha); // a0-a3 twice in lane 0, a4-a7 twice in lane 1
+	return _mm256_castsi256_si128(_mm256_permute4x64_epi64(alpha, 0x08)); // a0-a7
+}
+
+/**
+ * Load the map values of a block of at most AVX2_PIXELS pixels.
+ * @param src_mv The first map value.
+ * @param count The number of pixels in the block.
+ * @return The map values, one per 16 bits; map values past \a count are zero.
+ */
+GNU_TARGET("avx2")
+static inline __m128i LoadMapValuesAVX2(const Blitter_32bppSSE_Base::MapValue *src_mv, int count)
+{
+	if (count == AVX2_PIXELS) return _mm_loadu_si128((const __m128i *)src_mv);
+
+	alignas(16) Blitter_32bppSSE_Base::MapValue mvs[AVX2_PIXELS] = {};
+	std::copy_n(src_mv, count, mvs);
+	return _mm_load_si128((const __m128i *)mvs);
+}
+
+/**
+ * Apply the colour remap to a block of AVX2_PIXELS pixels.
+ * Pixels without a remappable colour are kept, pixels that remap to colour 0 become fully transparent.
+ * @param palette The palette to get the remapped colours from.
+ * @param src The source pixels.
+ * @param mvs The map values of the source pixels, as returned by LoadMapValuesAVX2.
+ * @param remap The colour remap.
+ * @return The remapped source pixels.
+ */
+GNU_TARGET("avx2")
+static inline __m256i RemapPixelsAVX2(const Colour *palette, __m256i src, __m128i mvs, const uint8_t *remap)
+{
+	const __m128i m = _mm_and_si128(mvs, _mm_set1_epi16(0x00FF));
+
+	/* Most blocks have no remappable pixels at all. */
+	if (_mm_testz_si128(m, m)) return src;
+
+	/* Storing once and reading back single values avoids inserting the map values one by one. */
+	alignas(16) Blitter_32bppSSE_Base::MapValue map_values[AVX2_PIXELS];
+	_mm_store_si128((__m128i *)map_values, mvs);
+	const __m256i remapped = _mm256_setr_epi32(
+			remap[map_values[0].m], remap[map_values[1].m], remap[map_values[2].m], remap[map_values[3].m],
+			remap[map_values[4].m], remap[map_values[5].m], remap[map_values[6].m], remap[map_values[7].m]);
+
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+	__m256i colour = _mm256_i32gather_epi32((const int *)palette, remapped, sizeof(Colour));
+	colour = _mm256_blendv_epi8(colour, src, alpha); // Keep the alpha of the source.
+	colour = _mm256_andnot_si256(_mm256_cmpeq_epi32(remapped, zero), colour);
+	colour = _mm256_blendv_epi8(colour, src, _mm256_cmpeq_epi32(_mm256_cvtepu16_epi32(m), zero));
+
+	/* Only adjust the brightness when a remapped pixel does not have the default brightness; it does not change the other pixels. */
+	const __m128i default_brightness = _mm_or_si128(_mm_cmpeq_epi16(_mm_srli_epi16(mvs, 8), _mm_set1_epi16(DEFAULT_BRIGHTNESS)), _mm_cmpeq_epi16(m, _mm_setzero_si128()));
+	if (_mm_movemask_epi8(default_brightness) == 0xFFFF) return colour;
+	return AdjustBrightnessOfEightPixelsAVX2(colour, mvs);
+}
+
+#endif /* WITH_SSE */
+#endif /* BLITTER_32BPP_AVX2_FUNC_HPP */
@@ -16,6 +16,7 @@
 #include "roadveh.h"
 #include "ship.h"
 #include "station_base.h"
+#include "station_func.h"
 #include "station_map.h"
 #include "subsidy_func.h"
 #include "town.h"
@@ -198,6 +199,21 @@ void CheckCaches()
 		}
 	}
 
+	/* Check the running acceptance sums against a full recompute */
+	for (Station *st : Station::Iterate()) {
+		if (!st->acceptance_cache.valid) continue;
+
+		StationAcceptanceCache old_cache = std::move(st->acceptance_cache);
+		RebuildStationAcceptanceCache(st);
+		if (st->acceptance_cache != old_cache) {
+			Debug(desync, 2, "warning: station acceptance mismatch: station {}", st->index);
+		}
+	}
+
+	CheckHouseTileStations();
+	CheckCatchmentIndex();
+	CheckOrderDestinationIndex();
+
 	Station::RecomputeCatchmentForAll();
 
 	/* Check industries_near */
@@ -36,6 +36,9 @@
 #include "ai/ai_config.hpp"
 #include "newgrf.h"
 #include "newgrf_profiling.h"
+#include "framerate_type.h"
+#include "tick_profiling.h"
+#include "desync_replay.h"
 #include "console_func.h"
 #include "engine_base.h"
 #include "road.h"
@@ -1216,7 +1219,6 @@ DEF_CONSOLE_CMD(ConReturn)
 extern bool CloseConsoleLogIfActive();
 extern const std::vector<GRFFile *> &GetAllGRFFiles();
 extern void ConPrintFramerate(); // framerate_gui.cpp
-extern void ShowFramerateWindow();
 
 DEF_CONSOLE_CMD(ConScript)
 {
@@ -2547,6 +2549,96 @@ DEF_CONSOLE_CMD(ConNewGRFProfile)
 	return false;
 }
 
+DEF_CONSOLE_CMD(ConTickProfile)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Collect timings of the parts of each game tick, and write the slowest ticks as folded stacks for flame graph tools. Sub-commands can be abbreviated.");
+		IConsolePrint(CC_HELP, "Usage: 'tick_profile start [<num-ticks> [<num-slowest>]]':");
+		IConsolePrint(CC_HELP, "  Begin profiling. If a number of ticks is provided, profiling stops after that many game ticks. There are 74 ticks in a calendar day.");
+		IConsolePrint(CC_HELP, "  The given number of slowest ticks is written; the default is {}.", TickProfiler::DEFAULT_KEEP_TICKS);
+		IConsolePrint(CC_HELP, "Usage: 'tick_profile stop':");
+		IConsolePrint(CC_HELP, "  End profiling and write the slowest ticks to a file.");
+		IConsolePrint(CC_HELP, "Usage: 'tick_profile abort':");
+		IConsolePrint(CC_HELP, "  End profiling and discard all collected data.");
+		return true;
+	}
+
+	if (argc < 2) return false;
+
+	/* "start" sub-command */
+	if (StrStartsWithIgnoreCase(argv[1], "sta")) {
+		if (TickProfiler::IsEnabled()) {
+			IConsolePrint(CC_ERROR, "Tick profiling is already active.");
+			return true;
+		}
+
+		uint64_t ticks = argc >= 3 ? std::max(atoi(argv[2]), 1) : 0;
+		size_t keep = argc >= 4 ? std::max(atoi(argv[3]), 1) : TickProfiler::DEFAULT_KEEP_TICKS;
+		TickProfiler::Start(keep, ticks);
+		IConsolePrint(CC_DEBUG, "Started tick profiling, keeping the {} slowest ticks.", keep);
+		if (ticks > 0) IConsolePrint(CC_DEBUG, "Profiling will automatically stop after {} ticks.", ticks);
+		return true;
+	}
+
+	/* "stop" sub-command */
+	if (StrStartsWithIgnoreCase(argv[1], "sto")) {
+		if (!TickProfiler::IsEnabled()) {
+			IConsolePrint(CC_ERROR, "Tick profiling is not active.");
+			return true;
+		}
+		TickProfiler::Stop();
+		return true;
+	}
+
+	/* "abort" sub-command */
+	if (StrStartsWithIgnoreCase(argv[1], "abo")) {
+		TickProfiler::Abort();
+		return true;
+	}
+
+	return false;
+}
+
+DEF_CONSOLE_CMD(ConDesyncReplay)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Replay a command log, as written with '-d desync=1', on the current game without running scripts, and write hashes of the game state.");
+		IConsolePrint(CC_HELP, "Usage: 'desync_replay <command-log> <hash-log> [<num-ticks> [<interval>]]'.");
+		IConsolePrint(CC_HELP, "  Use '-' as command log to run the game without commands. Without a number of ticks the replay runs until the last entry of the log.");
+		IConsolePrint(CC_HELP, "  The game state is hashed every interval ticks; the default is every tick. Compare two hash logs with 'desync_compare'.");
+		return true;
+	}
+
+	if (argc < 3 || argc > 5) return false;
+
+	if (_game_mode != GM_NORMAL) {
+		IConsolePrint(CC_ERROR, "This command is only available in-game.");
+		return true;
+	}
+
+	uint32_t ticks = 0;
+	uint32_t interval = 1;
+	if (argc >= 4 && !GetArgumentInteger(&ticks, argv[3])) return false;
+	if (argc >= 5 && !GetArgumentInteger(&interval, argv[4])) return false;
+
+	RunDesyncReplay(strcmp(argv[1], "-") == 0 ? std::string{} : argv[1], argv[2], ticks, interval);
+	return true;
+}
+
+DEF_CONSOLE_CMD(ConDesyncCompare)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Find the first tick where two hash logs written by 'desync_replay' diverge, and which parts of the game state differ.");
+		IConsolePrint(CC_HELP, "Usage: 'desync_compare <hash-log> <hash-log>'.");
+		return true;
+	}
+
+	if (argc != 3) return false;
+
+	CompareDesyncReplays(argv[1], argv[2]);
+	return true;
+}
+
 #ifdef _DEBUG
 /******************
  *  debug commands
@@ -2905,6 +2997,9 @@ void IConsoleStdLibRegister()
 #endif
 	IConsole::CmdRegister("fps",                     ConFramerate);
 	IConsole::CmdRegister("fps_wnd",                 ConFramerateWindow);
+	IConsole::CmdRegister("tick_profile",            ConTickProfile);
+	IConsole::CmdRegister("desync_replay",           ConDesyncReplay,     ConHookNoNetwork);
+	IConsole::CmdRegister("desync_compare",          ConDesyncCompare);
 
 	/* NewGRF development stuff */
 	IConsole::CmdRegister("reload_newgrfs",          ConNewGRFReload,     ConHookNewGRFDeveloperTool);
@@ -42,6 +42,56 @@ struct Randomizer {
 extern Randomizer _random; ///< Random used in the game state calculations
 extern Randomizer _interactive_random; ///< Random used everywhere else, where it does not (directly) influence the game state
 
+/**
+ * Counter-based pseudo random number generator for a single entity at a single moment.
+ * Unlike #Randomizer, the numbers only depend on the seed, the stream, the entity and the tick,
+ * and not on how many numbers have been drawn before elsewhere. So entities that use their own
+ * stream can be processed in any order, or in parallel, and still get the same numbers.
+ */
+struct StreamRandomizer {
+	/**
+	 * Create the generator for an entity at a moment.
+	 * @param seed Seed of the game.
+	 * @param stream Kind of entity, or kind of action, that draws the numbers.
+	 * @param entity Index of the entity.
+	 * @param tick Moment the numbers are drawn at.
+	 */
+	constexpr StreamRandomizer(uint32_t seed, uint32_t stream, uint32_t entity, uint64_t tick) :
+		key(Mix(Mix(Mix(seed) ^ (static_cast<uint64_t>(stream) << 32 | entity)) ^ tick)) {}
+
+	/**
+	 * Generate the next pseudo random number of the stream.
+	 * @return The random number.
+	 */
+	constexpr uint32_t Next()
+	{
+		return static_cast<uint32_t>(Mix(this->key + ++this->counter * 0x9E3779B97F4A7C15ULL) >> 32);
+	}
+
+	/**
+	 * Generate the next pseudo random number scaled to \a limit, excluding \a limit itself.
+	 * @param limit Limit of the range to be generated from.
+	 * @return Random number in [0,\a limit)
+	 */
+	constexpr uint32_t Next(uint32_t limit) { return ScaleToLimit(this->Next(), limit); }
+
+private:
+	uint64_t key; ///< Identification of the stream of the entity at the moment.
+	uint64_t counter = 0; ///< Number of numbers drawn so far.
+
+	/**
+	 * Scramble the bits of a value (the finaliser of splitmix64).
+	 * @param x The value.
+	 * @return The scrambled value.
+	 */
+	static constexpr uint64_t Mix(uint64_t x)
+	{
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+		return x ^ (x >> 31);
+	}
+};
+
 /** Stores the state of all random number generators */
 struct SavedRandomSeeds {
 	Randomizer random;
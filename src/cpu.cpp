@@ -26,7 +26,7 @@
 #if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
 void ottd_cpuid(int info[4], int type)
 {
-	__cpuid(info, type);
+	__cpuidex(info, type, 0);
 }
 #elif defined(__x86_64__) || defined(__i386)
 void ottd_cpuid(int info[4], int type)
@@ -46,13 +46,13 @@ void ottd_cpuid(int info[4], int type)
 			/* It is safe to write "=r" for (info[1]) as in case that PIC is enabled for i386,
 			 * the compiler will not choose EBX as target register (but something else).
 			 */
-			: "a" (type)
+			: "a" (type), "c" (0)
 	);
 #else
 	__asm__ __volatile__ (
 			"cpuid           \n\t"
 			: "=a" (info[0]), "=b" (info[1]), "=c" (info[2]), "=d" (info[3])
-			: "a" (type)
+			: "a" (type), "c" (0)
 	);
 #endif /* i386 PIC */
 }
@@ -91,3 +91,29 @@ bool HasCPUIDFlag(uint type, uint index, uint bit)
 	ottd_cpuid(cpu_info, type);
 	return HasBit(cpu_info[index], bit);
 }
+
+/**
+ * Read the extended control register telling which register states the OS saves on a context switch.
+ * @return The lower 32 bits of XCR0, or 0 when it cannot be read.
+ */
+static uint32_t GetEnabledXSaveFeatures()
+{
+	/* OSXSAVE; without it XGETBV is not available. */
+	if (!HasCPUIDFlag(1, 2, 27)) return 0;
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	return static_cast<uint32_t>(_xgetbv(0));
+#elif defined(__x86_64__) || defined(__i386)
+	uint32_t eax, edx;
+	__asm__ __volatile__ ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+	return eax;
+#else
+	return 0;
+#endif
+}
+
+bool HasAVX2Support()
+{
+	/* The CPU must support AVX and AVX2, and the OS must save the SSE and AVX (YMM) registers. */
+	if (!HasCPUIDFlag(1, 2, 28) || !HasCPUIDFlag(7, 1, 5)) return false;
+	return (GetEnabledXSaveFeatures() & 0x6) == 0x6;
+}
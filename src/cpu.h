@@ -13,7 +13,7 @@
 /**
  * Get the CPUID information from the CPU.
  * @param info The retrieved info. All zeros on architectures without CPUID.
- * @param type The information this instruction should retrieve.
+ * @param type The information this instruction should retrieve. For types with sub-leaves the first sub-leaf is retrieved.
  */
 void ottd_cpuid(int info[4], int type);
 
@@ -26,4 +26,10 @@ void ottd_cpuid(int info[4], int type);
  */
 bool HasCPUIDFlag(uint type, uint index, uint bit);
 
+/**
+ * Check whether AVX2 instructions can be used, i.e. the CPU supports them and the OS preserves the YMM registers.
+ * @return True when AVX2 is usable.
+ */
+bool HasAVX2Support();
+
 #endif /* CPU_H */
@@ -9,6 +9,7 @@
 
 #include "stdafx.h"
 #include "depot_base.h"
+#include "depot_kdtree.h"
 #include "order_backup.h"
 #include "order_func.h"
 #include "window_func.h"
@@ -22,6 +23,96 @@
 DepotPool _depot_pool("Depot");
 INSTANTIATE_POOL_METHODS(Depot)
 
+ReferenceThroughBaseContainer<std::array<std::array<DepotKdtree, VEH_AIRCRAFT>, MAX_COMPANIES>> _depot_kdtrees;
+ReferenceThroughBaseContainer<std::array<HangarKdtree, MAX_COMPANIES>> _hangar_kdtrees;
+
+/**
+ * Get the k-d tree a depot belongs in.
+ * @param depot The depot.
+ * @return The tree, or nullptr when the depot is not owned by a company.
+ */
+static DepotKdtree *GetDepotKdtree(const Depot *depot)
+{
+	Owner owner = GetTileOwner(depot->xy);
+	if (owner >= MAX_COMPANIES) return nullptr;
+	return &_depot_kdtrees[owner][GetDepotVehicleType(depot->xy)];
+}
+
+/**
+ * Get the k-d tree the hangars of a station belong in.
+ * @param st The station.
+ * @return The tree, or nullptr when the station has no hangars or is not owned by a company.
+ */
+static HangarKdtree *GetHangarKdtree(const Station *st)
+{
+	if (!st->facilities.Test(StationFacility::Airport) || !st->airport.HasHangar() || st->owner >= MAX_COMPANIES) return nullptr;
+	return &_hangar_kdtrees[st->owner];
+}
+
+/** Rebuild the k-d trees of the depots and hangars of all companies, e.g. after their owners have changed. */
+void RebuildDepotKdtrees()
+{
+	ReferenceThroughBaseContainer<std::array<std::array<std::vector<DepotID>, VEH_AIRCRAFT>, MAX_COMPANIES>> depots;
+	for (const Depot *depot : Depot::Iterate()) {
+		if (!IsDepotTile(depot->xy) || GetDepotIndex(depot->xy) != depot->index) continue;
+
+		Owner owner = GetTileOwner(depot->xy);
+		if (owner < MAX_COMPANIES) depots[owner][GetDepotVehicleType(depot->xy)].push_back(depot->index);
+	}
+
+	ReferenceThroughBaseContainer<std::array<std::vector<StationID>, MAX_COMPANIES>> hangars;
+	for (const Station *st : Station::Iterate()) {
+		if (GetHangarKdtree(st) != nullptr) hangars[st->owner].push_back(st->index);
+	}
+
+	for (CompanyID c = CompanyID::Begin(); c < MAX_COMPANIES; ++c) {
+		for (VehicleType type = VEH_TRAIN; type < VEH_AIRCRAFT; type++) {
+			_depot_kdtrees[c][type].Build(depots[c][type].begin(), depots[c][type].end());
+		}
+		_hangar_kdtrees[c].Build(hangars[c].begin(), hangars[c].end());
+	}
+}
+
+/**
+ * Add a depot to the k-d tree of its owner, after its tiles have been built.
+ * @param depot The depot.
+ */
+void AddDepotToKdtree(const Depot *depot)
+{
+	DepotKdtree *tree = GetDepotKdtree(depot);
+	if (tree != nullptr) tree->Insert(depot->index);
+}
+
+/**
+ * Remove a depot from the k-d tree of its owner, before its tiles are removed.
+ * @param depot The depot.
+ */
+void RemoveDepotFromKdtree(const Depot *depot)
+{
+	DepotKdtree *tree = GetDepotKdtree(depot);
+	if (tree != nullptr) tree->Remove(depot->index);
+}
+
+/**
+ * Add the hangars of an airport to the k-d tree of its owner, after the airport has been built.
+ * @param st The station with the airport.
+ */
+void AddHangarsToKdtree(const Station *st)
+{
+	HangarKdtree *tree = GetHangarKdtree(st);
+	if (tree != nullptr) tree->Insert(st->index);
+}
+
+/**
+ * Remove the hangars of an airport from the k-d tree of its owner, before the airport is removed.
+ * @param st The station with the airport.
+ */
+void RemoveHangarsFromKdtree(const Station *st)
+{
+	HangarKdtree *tree = GetHangarKdtree(st);
+	if (tree != nullptr) tree->Remove(st->index);
+}
+
 /**
  * Clean up a depot
  */
@@ -34,6 +125,8 @@ Depot::~Depot()
 		return;
 	}
 
+	RemoveDepotFromKdtree(this);
+
 	/* Clear the order backup. */
 	OrderBackup::Reset(this->xy, false);
 
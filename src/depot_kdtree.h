@@ -0,0 +1,96 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file depot_kdtree.h Declarations for accessing the k-d trees of depots and hangars of each company. */
+
+#ifndef DEPOT_KDTREE_H
+#define DEPOT_KDTREE_H
+
+#include "core/kdtree.hpp"
+#include "depot_base.h"
+#include "station_base.h"
+#include "company_type.h"
+#include "vehicle_type.h"
+#include "map_func.h"
+
+struct Kdtree_DepotXYFunc {
+	inline uint16_t operator()(DepotID did, int dim)
+	{
+		return (dim == 0) ? TileX(Depot::Get(did)->xy) : TileY(Depot::Get(did)->xy);
+	}
+};
+
+struct Kdtree_HangarXYFunc {
+	inline uint16_t operator()(StationID stid, int dim)
+	{
+		return (dim == 0) ? TileX(Station::Get(stid)->airport.tile) : TileY(Station::Get(stid)->airport.tile);
+	}
+};
+
+using DepotKdtree = Kdtree<DepotID, Kdtree_DepotXYFunc, uint16_t, int>;
+using HangarKdtree = Kdtree<StationID, Kdtree_HangarXYFunc, uint16_t, int>;
+
+/** Depots of each company, by the type of vehicle they are for. Hangars are in #_hangar_kdtrees instead. */
+extern ReferenceThroughBaseContainer<std::array<std::array<DepotKdtree, VEH_AIRCRAFT>, MAX_COMPANIES>> _depot_kdtrees;
+/** Airports with hangars of each company. */
+extern ReferenceThroughBaseContainer<std::array<HangarKdtree, MAX_COMPANIES>> _hangar_kdtrees;
+
+void RebuildDepotKdtrees();
+void AddDepotToKdtree(const Depot *depot);
+void RemoveDepotFromKdtree(const Depot *depot);
+void AddHangarsToKdtree(const Station *st);
+void RemoveHangarsFromKdtree(const Station *st);
+
+/**
+ * Find the element of a k-d tree nearest to a tile, by Euclidean distance, that passes a filter.
+ * The tree is searched in growing squares around the tile, so far away elements are only
+ * visited when there is no suitable element nearby. Of elements at the same distance
+ * the one with the lowest index is returned, so the result does not depend on the shape of the tree.
+ * @param tree The tree to search.
+ * @param tile The tile to search around.
+ * @param max_distance Maximum distance of the element to the tile.
+ * @param filter The filter, must take a single parameter which is the element and return whether it is suitable.
+ * @return The nearest suitable element, or an invalid index if there is none.
+ */
+template <typename T, typename TxyFunc, typename Tfilter>
+T FindNearestInKdtree(const Kdtree<T, TxyFunc, uint16_t, int> &tree, TileIndex tile, uint max_distance, Tfilter filter)
+{
+	const int x = TileX(tile);
+	const int y = TileY(tile);
+	const uint64_t max_distance_sq = static_cast<uint64_t>(max_distance) * max_distance;
+	const uint map_radius = std::max(Map::SizeX(), Map::SizeY());
+
+	for (uint radius = 16;; radius *= 4) {
+		radius = std::min({radius, max_distance, map_radius});
+
+		const int r = static_cast<int>(radius);
+		uint16_t x1 = static_cast<uint16_t>(std::max<int>(0, x - r));
+		uint16_t x2 = static_cast<uint16_t>(std::min<int>(x + r + 1, Map::SizeX()));
+		uint16_t y1 = static_cast<uint16_t>(std::max<int>(0, y - r));
+		uint16_t y2 = static_cast<uint16_t>(std::min<int>(y + r + 1, Map::SizeY()));
+
+		T best = T::Invalid();
+		uint64_t best_distance_sq = UINT64_MAX;
+		tree.FindContained(x1, y1, x2, y2, [&](T element) {
+			int dx = TxyFunc()(element, 0) - x;
+			int dy = TxyFunc()(element, 1) - y;
+			uint64_t distance_sq = static_cast<uint64_t>(dx * dx + dy * dy);
+			if (distance_sq > max_distance_sq) return;
+			if (distance_sq > best_distance_sq || (distance_sq == best_distance_sq && best < element)) return;
+			if (!filter(element)) return;
+
+			best = element;
+			best_distance_sq = distance_sq;
+		});
+
+		/* Everything outside the searched square is further away than the radius. */
+		if (best != T::Invalid() && best_distance_sq <= static_cast<uint64_t>(radius) * radius) return best;
+		if (radius == max_distance || radius == map_radius) return best;
+	}
+}
+
+#endif /* DEPOT_KDTREE_H */
@@ -0,0 +1,330 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file desync_replay.cpp Replaying of command logs, and comparing the resulting game states. */
+
+#include "stdafx.h"
+#include "desync_replay.h"
+#include "state_hash.h"
+#include "fileio_func.h"
+#include "console_func.h"
+#include "company_func.h"
+#include "openttd.h"
+#include "gfx_func.h"
+#include "core/random_func.hpp"
+#include "network/network_internal.h"
+#include "timer/timer_game_economy.h"
+
+#include <charconv>
+
+#include "safeguards.h"
+
+bool _desync_replay_running = false; ///< Whether a command log is being replayed; scripts do not run during a replay.
+
+/** An entry of a command log that is used for replaying it. */
+struct ReplayEntry {
+	TimerGameEconomy::Date date{}; ///< Date at which the entry was logged.
+	TimerGameEconomy::DateFract date_fract = 0; ///< Fraction of the date at which the entry was logged.
+	std::optional<CommandPacket> command{}; ///< Command to execute, or std::nullopt for a check of the random state.
+	std::array<uint32_t, 2> random_state{}; ///< State of the random generator to check against.
+};
+
+/** The game state hash of a tick, as read back from a hash log. */
+struct ReplayHashRecord {
+	uint64_t tick; ///< Number of ticks since the start of the replay.
+	uint32_t date; ///< Economy date at the tick.
+	uint32_t date_fract; ///< Fraction of the economy date at the tick.
+	GameStateHash hash; ///< The game state hash.
+};
+
+/**
+ * Read a hexadecimal field from a log line, and skip the separator after it.
+ * @param[in,out] line The remainder of the line.
+ * @param[out] value The value of the field.
+ * @param base The base the field is written in.
+ * @return True iff a value could be read.
+ */
+template <typename T>
+static bool ReadLogField(std::string_view &line, T &value, int base = 16)
+{
+	while (!line.empty() && line.front() == ' ') line.remove_prefix(1);
+
+	auto [end, ec] = std::from_chars(line.data(), line.data() + line.size(), value, base);
+	if (ec != std::errc{}) return false;
+
+	line.remove_prefix(end - line.data());
+	if (!line.empty() && line.front() == ';') line.remove_prefix(1);
+	return true;
+}
+
+/**
+ * Parse a line of a command log as written with '-d desync=1'.
+ * Only executed commands and random state checks are used, all other lines are ignored.
+ * @param line The line.
+ * @return The entry, or std::nullopt when the line is not used for replaying.
+ */
+static std::optional<ReplayEntry> ParseReplayLine(std::string_view line)
+{
+	/* Skip the "[date time] " prefix. */
+	if (line.starts_with('[')) {
+		size_t end = line.find("] ");
+		if (end == std::string_view::npos) return std::nullopt;
+		line.remove_prefix(end + 2);
+	}
+
+	ReplayEntry entry;
+	uint32_t date;
+
+	if (line.starts_with("cmd: ")) {
+		line.remove_prefix(5);
+
+		CommandPacket cp;
+		uint32_t company;
+		uint32_t cmd;
+		if (!ReadLogField(line, date) || !ReadLogField(line, entry.date_fract) || !ReadLogField(line, company) || !ReadLogField(line, cmd) || !ReadLogField(line, cp.err_msg)) return std::nullopt;
+		if (cmd >= CMD_END) return std::nullopt;
+		cp.company = static_cast<CompanyID>(company);
+		cp.cmd = static_cast<Commands>(cmd);
+
+		/* The command data is written as hexadecimal bytes, followed by the name of the command. */
+		while (!line.empty() && line.front() == ' ') line.remove_prefix(1);
+		std::string_view data = line.substr(0, line.find(' '));
+		if (data.starts_with('(')) data = {};
+		for (size_t i = 0; i + 1 < data.size(); i += 2) {
+			uint8_t byte = 0;
+			std::from_chars(data.data() + i, data.data() + i + 2, byte, 16);
+			cp.data.push_back(byte);
+		}
+
+		entry.command = std::move(cp);
+	} else if (line.starts_with("sync: ")) {
+		line.remove_prefix(6);
+		if (!ReadLogField(line, date) || !ReadLogField(line, entry.date_fract) || !ReadLogField(line, entry.random_state[0]) || !ReadLogField(line, entry.random_state[1])) return std::nullopt;
+	} else {
+		return std::nullopt;
+	}
+
+	entry.date = TimerGameEconomy::Date(static_cast<int32_t>(date));
+	return entry;
+}
+
+/**
+ * Load the entries of a command log.
+ * @param filename The command log.
+ * @param[out] entries The entries that are used for replaying.
+ * @return True iff the log could be read.
+ */
+static bool LoadReplayLog(const std::string &filename, std::vector<ReplayEntry> &entries)
+{
+	auto f = FioFOpenFile(filename, "rb", NO_DIRECTORY);
+	if (!f.has_value()) {
+		IConsolePrint(CC_ERROR, "Cannot open command log '{}'.", filename);
+		return false;
+	}
+
+	char buff[8192];
+	while (fgets(buff, lengthof(buff), *f) != nullptr) {
+		std::string_view line = buff;
+		while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) line.remove_suffix(1);
+
+		std::optional<ReplayEntry> entry = ParseReplayLine(line);
+		if (entry.has_value()) entries.push_back(std::move(*entry));
+	}
+	return true;
+}
+
+/**
+ * Compare the moment an entry was logged with the current moment of the game.
+ * @param entry The entry.
+ * @return Negative when the entry lies in the past, zero when it is for now, positive when it lies in the future.
+ */
+static int CompareToCurrentDate(const ReplayEntry &entry)
+{
+	if (entry.date != TimerGameEconomy::date) return entry.date < TimerGameEconomy::date ? -1 : 1;
+	if (entry.date_fract != TimerGameEconomy::date_fract) return entry.date_fract < TimerGameEconomy::date_fract ? -1 : 1;
+	return 0;
+}
+
+/**
+ * Write the hash of the current game state to a hash log.
+ * @param f The hash log.
+ * @param tick Number of ticks since the start of the replay.
+ */
+static void WriteReplayHash(FileHandle &f, uint64_t tick)
+{
+	GameStateHash hash = ComputeGameStateHash();
+	fmt::print(f, "{}; {:08x}; {:02x}; {:016x}", tick, static_cast<uint32_t>(TimerGameEconomy::date.base()), TimerGameEconomy::date_fract, hash.GetCombined());
+	for (uint64_t part : hash.parts) fmt::print(f, "; {:016x}", part);
+	fmt::print(f, "\n");
+}
+
+/**
+ * Replay a command log on the current game, and write the hash of the game state after every \a interval ticks.
+ * The game is run as fast as possible, without handling any input or network traffic.
+ * @param log_file The command log, as written with '-d desync=1', or an empty string to not replay any commands.
+ * @param hash_file The file to write the hashes to.
+ * @param ticks Number of ticks to run, or 0 to run until all entries of the log have been replayed.
+ * @param interval Number of ticks between hashes.
+ * @return True iff the replay ran without mismatches of the random state.
+ */
+bool RunDesyncReplay(const std::string &log_file, const std::string &hash_file, uint64_t ticks, uint interval)
+{
+	std::vector<ReplayEntry> entries;
+	if (!log_file.empty() && !LoadReplayLog(log_file, entries)) return false;
+	if (entries.empty() && ticks == 0) {
+		IConsolePrint(CC_ERROR, "Nothing to replay; give a number of ticks to run when the log has no commands.");
+		return false;
+	}
+
+	auto f = FioFOpenFile(hash_file, "wt", NO_DIRECTORY);
+	if (!f.has_value()) {
+		IConsolePrint(CC_ERROR, "Cannot open '{}' for writing.", hash_file);
+		return false;
+	}
+
+	fmt::print(*f, "# tick; date; date_fract; combined");
+	for (uint8_t part = 0; part < GSHP_END; part++) fmt::print(*f, "; {}", GetGameStateHashPartName(static_cast<GameStateHashPart>(part)));
+	fmt::print(*f, "\n");
+
+	interval = std::max(interval, 1U);
+	size_t commands = 0;
+	size_t checks = 0;
+	size_t mismatches = 0;
+	size_t skipped = 0;
+	uint64_t tick = 0;
+	auto entry = entries.begin();
+
+	_desync_replay_running = true;
+	WriteReplayHash(*f, tick);
+
+	while (ticks != 0 ? tick < ticks : entry != entries.end()) {
+		/* Handle everything that was logged right before this tick was run. */
+		for (; entry != entries.end(); ++entry) {
+			int cmp = CompareToCurrentDate(*entry);
+			if (cmp > 0) break;
+			if (cmp < 0) {
+				skipped++;
+				continue;
+			}
+
+			if (entry->command.has_value()) {
+				NetworkExecuteCommandPacket(*entry->command);
+				_current_company = _local_company;
+				commands++;
+			} else {
+				checks++;
+				if (entry->random_state[0] != _random.state[0] || entry->random_state[1] != _random.state[1]) {
+					mismatches++;
+					IConsolePrint(CC_WARNING, "Random state mismatch at tick {} ({:08x}; {:02x}): expected {{{:08x}, {:08x}}}, got {{{:08x}, {:08x}}}.",
+							tick, TimerGameEconomy::date.base(), TimerGameEconomy::date_fract, entry->random_state[0], entry->random_state[1], _random.state[0], _random.state[1]);
+				}
+			}
+		}
+
+		if (ticks == 0 && _pause_mode.Any() && (entry == entries.end() || CompareToCurrentDate(*entry) != 0)) {
+			IConsolePrint(CC_ERROR, "The game is paused at tick {} and the log does not unpause it; stopping.", tick);
+			break;
+		}
+
+		StateGameLoop();
+		tick++;
+		if (tick % interval == 0) WriteReplayHash(*f, tick);
+	}
+
+	_desync_replay_running = false;
+	MarkWholeScreenDirty();
+
+	IConsolePrint(CC_INFO, "Replayed {} ticks with {} commands; {} of {} random state checks mismatched.", tick, commands, mismatches, checks);
+	if (skipped > 0) IConsolePrint(CC_WARNING, "Skipped {} log entries from before the start of the game.", skipped);
+	IConsolePrint(CC_INFO, "Game state hashes written to '{}'.", hash_file);
+	return mismatches == 0;
+}
+
+/**
+ * Load a hash log written by #RunDesyncReplay.
+ * @param filename The hash log.
+ * @param[out] records The hashes in the log.
+ * @return True iff the log could be read.
+ */
+static bool LoadReplayHashLog(const std::string &filename, std::vector<ReplayHashRecord> &records)
+{
+	auto f = FioFOpenFile(filename, "rb", NO_DIRECTORY);
+	if (!f.has_value()) {
+		IConsolePrint(CC_ERROR, "Cannot open hash log '{}'.", filename);
+		return false;
+	}
+
+	char buff[1024];
+	while (fgets(buff, lengthof(buff), *f) != nullptr) {
+		std::string_view line = buff;
+		if (line.starts_with('#')) continue;
+
+		ReplayHashRecord record;
+		uint64_t combined;
+		bool valid = ReadLogField(line, record.tick, 10) && ReadLogField(line, record.date) && ReadLogField(line, record.date_fract) && ReadLogField(line, combined);
+		for (uint64_t &part : record.hash.parts) valid = valid && ReadLogField(line, part);
+		if (!valid) {
+			IConsolePrint(CC_ERROR, "Cannot parse line {} of hash log '{}'.", records.size() + 1, filename);
+			return false;
+		}
+		records.push_back(record);
+	}
+	return true;
+}
+
+/**
+ * Compare two hash logs, and find the first tick where the game states diverge.
+ * Once game states diverge they stay diverged, so this is a binary search.
+ * @param hash_file_a The first hash log.
+ * @param hash_file_b The second hash log.
+ * @return True iff the game states match for all ticks in both logs.
+ */
+bool CompareDesyncReplays(const std::string &hash_file_a, const std::string &hash_file_b)
+{
+	std::vector<ReplayHashRecord> a;
+	std::vector<ReplayHashRecord> b;
+	if (!LoadReplayHashLog(hash_file_a, a) || !LoadReplayHashLog(hash_file_b, b)) return false;
+
+	size_t count = std::min(a.size(), b.size());
+	for (size_t i = 0; i < count; i++) {
+		if (a[i].tick != b[i].tick) {
+			IConsolePrint(CC_ERROR, "The hash logs were not written at the same ticks; replay both with the same interval.");
+			return false;
+		}
+	}
+
+	size_t first = 0;
+	size_t last = count;
+	while (first < last) {
+		size_t middle = first + (last - first) / 2;
+		if (a[middle].hash == b[middle].hash) {
+			first = middle + 1;
+		} else {
+			last = middle;
+		}
+	}
+
+	if (first == count) {
+		IConsolePrint(CC_INFO, "The game states match for all {} hashed ticks.", count);
+		if (a.size() != b.size()) IConsolePrint(CC_WARNING, "One of the hash logs is longer than the other; only the common ticks were compared.");
+		return true;
+	}
+
+	const ReplayHashRecord &ra = a[first];
+	const ReplayHashRecord &rb = b[first];
+	IConsolePrint(CC_WARNING, "The game states diverge at tick {} ({:08x}; {:02x}).", ra.tick, ra.date, ra.date_fract);
+	if (first > 0 && a[first - 1].tick + 1 != ra.tick) {
+		IConsolePrint(CC_WARNING, "The last matching hash is at tick {}; replay with a smaller interval to narrow it down.", a[first - 1].tick);
+	}
+	if (ra.date != rb.date || ra.date_fract != rb.date_fract) {
+		IConsolePrint(CC_WARNING, "The dates differ: {:08x}; {:02x} versus {:08x}; {:02x}.", ra.date, ra.date_fract, rb.date, rb.date_fract);
+	}
+	for (uint8_t part = 0; part < GSHP_END; part++) {
+		if (ra.hash.parts[part] != rb.hash.parts[part]) IConsolePrint(CC_WARNING, "  Diverging: {}", GetGameStateHashPartName(static_cast<GameStateHashPart>(part)));
+	}
+	return false;
+}
@@ -0,0 +1,18 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file desync_replay.h Replaying of command logs, and comparing the resulting game states. */
+
+#ifndef DESYNC_REPLAY_H
+#define DESYNC_REPLAY_H
+
+extern bool _desync_replay_running;
+
+bool RunDesyncReplay(const std::string &log_file, const std::string &hash_file, uint64_t ticks, uint interval);
+bool CompareDesyncReplays(const std::string &hash_file_a, const std::string &hash_file_b);
+
+#endif /* DESYNC_REPLAY_H */
@@ -31,6 +31,7 @@
 #include "object.h"
 #include "strings_func.h"
 #include "vehicle_func.h"
+#include "signal_func.h"
 #include "sound_func.h"
 #include "autoreplace_func.h"
 #include "company_gui.h"
@@ -38,6 +39,7 @@
 #include "subsidy_base.h"
 #include "subsidy_func.h"
 #include "station_base.h"
+#include "depot_kdtree.h"
 #include "waypoint_base.h"
 #include "economy_base.h"
 #include "core/pool_func.hpp"
@@ -480,6 +482,7 @@ void ChangeOwnershipOfCompanyItems(Owner old_owner, Owner new_owner)
 		for (const auto tile : Map::Iterate()) {
 			ChangeTileOwner(tile, old_owner, new_owner);
 		}
+		InvalidateSignalBlocks();
 
 		if (new_owner != INVALID_OWNER) {
 			/* Update all signals because there can be new segment that was owned by two companies
@@ -526,6 +529,9 @@ void ChangeOwnershipOfCompanyItems(Owner old_owner, Owner new_owner)
 		if (si->owner == old_owner) si->owner = new_owner == INVALID_OWNER ? OWNER_NONE : new_owner;
 	}
 
+	/* The depots and airports of the old company have been given to the new one. */
+	RebuildDepotKdtrees();
+
 	/* Remove Game Script created Goals, CargoMonitors and Story pages. */
 	for (Goal *g : Goal::Iterate()) {
 		if (g->company == old_owner) delete g;
@@ -699,6 +705,24 @@ static void CompaniesGenStatistics()
 	SetWindowDirty(WC_COMPANY_LEAGUE, 0);
 }
 
+/**
+ * Get which part of the industries and towns gets its monthly update today.
+ * When the monthly updates are spread, an industry or town gets its update on day
+ * 2 + (index % #ECONOMY_MONTH_SLICES) of each month. The first day is skipped, as
+ * that is when all other monthly work happens, and the days after the last slice are
+ * skipped so each of them is updated exactly once every month, even in February.
+ * Whether they are spread is decided at the start of the month, see #_economy_companies_monthly.
+ * @return The slice to update today, or \c std::nullopt when nothing is updated today.
+ */
+std::optional<uint> GetEconomyMonthSlice()
+{
+	if (!_economy.spread_monthly_loop) return std::nullopt;
+
+	uint day = TimerGameEconomy::ConvertDateToYMD(TimerGameEconomy::date).day;
+	if (day < 2 || day >= 2 + ECONOMY_MONTH_SLICES) return std::nullopt;
+	return day - 2;
+}
+
 /**
  * Add monthly inflation
  * @param check_year Shall the inflation get stopped after 170 years?
@@ -937,6 +961,7 @@ void StartupEconomy()
 void InitializeEconomy()
 {
 	_economy.inflation_prices = _economy.inflation_payment = 1 << 16;
+	_economy.spread_monthly_loop = false;
 	ClearCargoPickupMonitoring();
 	ClearCargoDeliveryMonitoring();
 }
@@ -1984,6 +2009,10 @@ static IntervalTimer<TimerGameCalendar> _calendar_inflation_monthly({TimerGameCa
  */
 static IntervalTimer<TimerGameEconomy> _economy_companies_monthly({ TimerGameEconomy::MONTH, TimerGameEconomy::Priority::COMPANY }, [](auto)
 {
+	/* Changing the setting in the middle of a month would update some industries and towns twice, or not at all.
+	 * So only take it over now, before the monthly loops of the industries and towns, which have a later priority. */
+	_economy.spread_monthly_loop = _settings_game.economy.spread_monthly_loop;
+
 	CompaniesGenStatistics();
 	CompaniesPayInterest();
 	HandleEconomyFluctuations();
@@ -52,6 +52,11 @@ inline bool EconomyIsInRecession()
 	return _economy.fluct <= 0;
 }
 
+/** Number of days of the month over which the monthly updates of industries and towns are spread, when enabled. Day 2 up to day 28 exist in every month. */
+static const uint ECONOMY_MONTH_SLICES = 27;
+
+std::optional<uint> GetEconomyMonthSlice();
+
 /**
  * Scale a number by the inverse of the cargo scale setting, e.g. a scale of 25% multiplies the number by 4.
  * @param num The number to scale.
@@ -51,6 +51,7 @@ struct Economy {
 	uint32_t industry_daily_increment;      ///< The value which will increment industry_daily_change_counter. Computed value. NOSAVE
 	uint64_t inflation_prices;              ///< Cumulated inflation of prices since game start; 16 bit fractional part
 	uint64_t inflation_payment;             ///< Cumulated inflation of cargo payment since game start; 16 bit fractional part
+	bool spread_monthly_loop;               ///< Whether the monthly updates of industries and towns are spread over the current month; the setting as it was at the start of the month
 
 	/* Old stuff for savegame conversion only */
 	Money old_max_loan_unround;           ///< Old: Unrounded max loan
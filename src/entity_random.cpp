@@ -0,0 +1,31 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file entity_random.cpp Random numbers for the game state that do not depend on the order entities are processed in. */
+
+#include "stdafx.h"
+#include "entity_random.h"
+#include "settings_type.h"
+#include "timer/timer_game_tick.h"
+
+#include "safeguards.h"
+
+/**
+ * Get the random numbers an entity draws in the current tick.
+ * The numbers are derived from the seed of the game, which is saved and the same on all clients,
+ * and the tick counter. So they are the same on all clients, independent of the order in which
+ * entities are processed and of other random numbers being drawn. Drawing from the same stream
+ * for the same entity twice in a tick gives the same numbers, so an entity must keep using the
+ * same randomizer within a tick.
+ * @param stream What the numbers are for.
+ * @param entity Index of the entity.
+ * @return The randomizer.
+ */
+StreamRandomizer GetEntityRandomizer(RandomStream stream, uint32_t entity)
+{
+	return StreamRandomizer(_settings_game.game_creation.generation_seed, to_underlying(stream), entity, TimerGameTick::counter);
+}
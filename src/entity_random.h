@@ -0,0 +1,25 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file entity_random.h Random numbers for the game state that do not depend on the order entities are processed in. */
+
+#ifndef ENTITY_RANDOM_H
+#define ENTITY_RANDOM_H
+
+#include "core/random_func.hpp"
+
+/**
+ * Streams of random numbers that are independent from each other and from #_random.
+ * Never reorder or remove values, as that changes the numbers in running games.
+ */
+enum class RandomStream : uint8_t {
+	IndustryProduction, ///< Periodic production callback of an industry.
+};
+
+StreamRandomizer GetEntityRandomizer(RandomStream stream, uint32_t entity);
+
+#endif /* ENTITY_RANDOM_H */
@@ -202,6 +202,7 @@ namespace {
 		PerformanceData(1),                     // PFE_ACC_DRAWWORLD
 		PerformanceData(60.0),                  // PFE_VIDEO
 		PerformanceData(1000.0 * 8192 / 44100), // PFE_SOUND
+		PerformanceData(1),                     // PFE_NETWORK_POLL
 		PerformanceData(1),                     // PFE_ALLSCRIPTS
 		PerformanceData(1),                     // PFE_GAMESCRIPT
 		PerformanceData(1),                     // PFE_AI0 ...
@@ -364,6 +365,7 @@ static const PerformanceElement DISPLAY_ORDER_PFE[PFE_MAX] = {
 	PFE_DRAWWORLD,
 	PFE_VIDEO,
 	PFE_SOUND,
+	PFE_NETWORK_POLL,
 };
 
 static const char * GetAIName(int ai_index)
@@ -1013,6 +1015,7 @@ void ConPrintFramerate()
 		"  Viewport drawing",
 		"Video output",
 		"Sound mixing",
+		"Network socket polling",
 		"AI/GS scripts total",
 		"Game script",
 	};
@@ -58,6 +58,7 @@ enum PerformanceElement : uint8_t {
 	PFE_DRAWWORLD,     ///< Time spent drawing world viewports in GUI
 	PFE_VIDEO,         ///< Speed of painting drawn video buffer.
 	PFE_SOUND,         ///< Speed of mixing audio samples
+	PFE_NETWORK_POLL,  ///< Time spent asking the OS which network sockets are ready
 	PFE_ALLSCRIPTS,    ///< Sum of all GS/AI scripts
 	PFE_GAMESCRIPT,    ///< Game script execution
 	PFE_AI0,           ///< AI execution for player slot 1
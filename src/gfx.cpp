@@ -1368,13 +1368,14 @@ void DrawMouseCursor()
  * Repaints a specific rectangle of the screen.
  *
  * @param left,top,right,bottom The area of the screen that needs repainting
+ * @param only_changed Only repaint the part of the windows whose content changed.
  * @pre The rectangle should have been previously marked dirty with \c AddDirtyBlock.
  * @see AddDirtyBlock
  * @see DrawDirtyBlocks
  * @ingroup dirty
  *
  */
-void RedrawScreenRect(int left, int top, int right, int bottom)
+void RedrawScreenRect(int left, int top, int right, int bottom, bool only_changed)
 {
 	assert(right <= _screen.width && bottom <= _screen.height);
 	if (_cursor.visible) {
@@ -1388,7 +1389,7 @@ void RedrawScreenRect(int left, int top, int right, int bottom)
 
 	if (_networking) NetworkUndrawChatMessage();
 
-	DrawOverlappedWindowForAll(left, top, right, bottom);
+	DrawOverlappedWindowForAll(left, top, right, bottom, only_changed);
 
 	VideoDriver::GetInstance()->MakeDirty(left, top, right - left, bottom - top);
 }
@@ -1396,12 +1397,28 @@ void RedrawScreenRect(int left, int top, int right, int bottom)
 /**
  * Repaints the rectangle blocks which are marked as 'dirty'.
  *
+ * Adjacent dirty blocks are coalesced into rectangles, and rectangles that
+ * almost fill their combined bounding box are merged, as every rectangle
+ * repaints all windows within it. Windows are only repainted where their
+ * content changed, for the rest of the rectangle the screen still shows them.
+ *
  * @see AddDirtyBlock
  *
  * @ingroup dirty
  */
 void DrawDirtyBlocks()
 {
+	/** Rectangle of dirty blocks, in blocks, with exclusive right and bottom. */
+	struct DirtyRect {
+		size_t left, top, right, bottom;
+		size_t dirty; ///< Number of dirty blocks within the rectangle.
+
+		size_t Area() const { return (this->right - this->left) * (this->bottom - this->top); }
+		bool Intersects(const DirtyRect &r) const { return this->left < r.right && r.left < this->right && this->top < r.bottom && r.top < this->bottom; }
+	};
+	static std::vector<DirtyRect> rects;
+	rects.clear();
+
 	auto is_dirty = [](auto block) -> bool { return block != 0; };
 	auto block = _dirty_blocks.begin();
 
@@ -1429,22 +1446,68 @@ void DrawDirtyBlocks()
 				std::fill_n(block_right, height, 0);
 			}
 
-			int left = static_cast<int>(x * DIRTY_BLOCK_WIDTH);
-			int top = static_cast<int>(y * DIRTY_BLOCK_HEIGHT);
-			int right = left + static_cast<int>(width * DIRTY_BLOCK_WIDTH);
-			int bottom = top + static_cast<int>(height * DIRTY_BLOCK_HEIGHT);
-
-			left = std::max(_invalid_rect.left, left);
-			top = std::max(_invalid_rect.top, top);
-			right = std::min(_invalid_rect.right, right);
-			bottom = std::min(_invalid_rect.bottom, bottom);
+			rects.push_back({x, y, x + width, y + height, width * height});
+		}
+	}
 
-			if (left < right && top < bottom) {
-				RedrawScreenRect(left, top, right, bottom);
+	/* Merge rectangles when at most a quarter of their bounding box is not dirty. Rectangles that
+	 * overlap the merged rectangle are absorbed too, so no area is painted twice. Skip this when
+	 * there are very many rectangles, as then it takes more time than it saves. */
+	static constexpr size_t MAX_RECTS_TO_MERGE = 256;
+	if (rects.size() <= MAX_RECTS_TO_MERGE) {
+		auto absorb = [](DirtyRect &into, DirtyRect &from) {
+			into.left = std::min(into.left, from.left);
+			into.top = std::min(into.top, from.top);
+			into.right = std::max(into.right, from.right);
+			into.bottom = std::max(into.bottom, from.bottom);
+			into.dirty += from.dirty;
+			from = {};
+		};
+
+		for (DirtyRect &r : rects) {
+			if (r.dirty == 0) continue;
+			for (bool merged = true; merged;) {
+				merged = false;
+				for (DirtyRect &other : rects) {
+					if (&other == &r || other.dirty == 0) continue;
+
+					DirtyRect bounds = r;
+					bounds.left = std::min(bounds.left, other.left);
+					bounds.top = std::min(bounds.top, other.top);
+					bounds.right = std::max(bounds.right, other.right);
+					bounds.bottom = std::max(bounds.bottom, other.bottom);
+					if (bounds.Area() * 3 > (r.dirty + other.dirty) * 4) continue;
+
+					absorb(r, other);
+					merged = true;
+				}
+				for (DirtyRect &other : rects) {
+					if (&other != &r && other.dirty != 0 && r.Intersects(other)) {
+						absorb(r, other);
+						merged = true;
+					}
+				}
 			}
 		}
 	}
 
+	/* Only the changes up to now are drawn; windows that change while drawing are drawn the next time. */
+	for (const Window *w : Window::Iterate()) {
+		w->redraw_area = w->dirty_area;
+		w->dirty_area = Window::NO_DIRTY_AREA;
+	}
+
+	for (const DirtyRect &r : rects) {
+		int left = std::max(_invalid_rect.left, static_cast<int>(r.left * DIRTY_BLOCK_WIDTH));
+		int top = std::max(_invalid_rect.top, static_cast<int>(r.top * DIRTY_BLOCK_HEIGHT));
+		int right = std::min(_invalid_rect.right, static_cast<int>(r.right * DIRTY_BLOCK_WIDTH));
+		int bottom = std::min(_invalid_rect.bottom, static_cast<int>(r.bottom * DIRTY_BLOCK_HEIGHT));
+
+		if (r.dirty != 0 && left < right && top < bottom) {
+			RedrawScreenRect(left, top, right, bottom, true);
+		}
+	}
+
 	++_dirty_block_colour;
 	_invalid_rect.left = _screen.width;
 	_invalid_rect.top = _screen.height;
@@ -1453,25 +1516,19 @@ void DrawDirtyBlocks()
 }
 
 /**
- * Extend the internal _invalid_rect rectangle to contain the rectangle
- * defined by the given parameters. Note the point (0,0) is top left.
- *
- * @param left The left edge of the rectangle
- * @param top The top edge of the rectangle
- * @param right The right edge of the rectangle
- * @param bottom The bottom edge of the rectangle
- * @see DrawDirtyBlocks
- * @ingroup dirty
- *
+ * Mark the blocks that cover a rectangle dirty, and extend the
+ * internal _invalid_rect rectangle to contain the rectangle.
+ * @param[in,out] left,top,right,bottom The rectangle; on return it is clipped to the screen and extended to the edges of the dirty blocks.
+ * @return Whether any part of the rectangle is on the screen.
  */
-void AddDirtyBlock(int left, int top, int right, int bottom)
+static bool MarkDirtyBlocks(int &left, int &top, int &right, int &bottom)
 {
 	if (left < 0) left = 0;
 	if (top < 0) top = 0;
 	if (right > _screen.width) right = _screen.width;
 	if (bottom > _screen.height) bottom = _screen.height;
 
-	if (left >= right || top >= bottom) return;
+	if (left >= right || top >= bottom) return false;
 
 	_invalid_rect.left = std::min(_invalid_rect.left, left);
 	_invalid_rect.top = std::min(_invalid_rect.top, top);
@@ -1481,16 +1538,87 @@ void AddDirtyBlock(int left, int top, int right, int bottom)
 	left /= DIRTY_BLOCK_WIDTH;
 	top  /= DIRTY_BLOCK_HEIGHT;
 	right = CeilDiv(right, DIRTY_BLOCK_WIDTH);
-	int height = CeilDiv(bottom, DIRTY_BLOCK_HEIGHT) - top;
+	bottom = CeilDiv(bottom, DIRTY_BLOCK_HEIGHT);
+
+	assert(left < right && top < bottom);
 
-	assert(left < right && height > 0);
+	for (int x = left; x < right; ++x) {
+		size_t offset = _dirty_blocks_per_column * x + top;
+		std::fill_n(_dirty_blocks.begin() + offset, bottom - top, 0xFF);
+	}
+
+	left *= DIRTY_BLOCK_WIDTH;
+	top *= DIRTY_BLOCK_HEIGHT;
+	right = std::min<int>(right * DIRTY_BLOCK_WIDTH, _screen.width);
+	bottom = std::min<int>(bottom * DIRTY_BLOCK_HEIGHT, _screen.height);
+	return true;
+}
+
+/**
+ * Remember that the content of a window within a rectangle changed.
+ * @param w The window.
+ * @param left,top,right,bottom The rectangle, in screen coordinates.
+ */
+static void AddWindowDirtyArea(const Window *w, int left, int top, int right, int bottom)
+{
+	left = std::max(left, w->left) - w->left;
+	top = std::max(top, w->top) - w->top;
+	right = std::min(right, w->left + w->width) - w->left - 1;
+	bottom = std::min(bottom, w->top + w->height) - w->top - 1;
+	if (left > right || top > bottom) return;
 
-	for (; left < right; ++left) {
-		size_t offset = _dirty_blocks_per_column * left + top;
-		std::fill_n(_dirty_blocks.begin() + offset, height, 0xFF);
+	Rect &area = w->dirty_area;
+	if (area.left > area.right) {
+		area = {left, top, right, bottom};
+	} else {
+		area.left = std::min(area.left, left);
+		area.top = std::min(area.top, top);
+		area.right = std::max(area.right, right);
+		area.bottom = std::max(area.bottom, bottom);
 	}
 }
 
+/**
+ * Extend the internal _invalid_rect rectangle to contain the rectangle
+ * defined by the given parameters. Note the point (0,0) is top left.
+ * All windows within the rectangle are repainted.
+ *
+ * @param left The left edge of the rectangle
+ * @param top The top edge of the rectangle
+ * @param right The right edge of the rectangle
+ * @param bottom The bottom edge of the rectangle
+ * @see DrawDirtyBlocks
+ * @ingroup dirty
+ *
+ */
+void AddDirtyBlock(int left, int top, int right, int bottom)
+{
+	if (!MarkDirtyBlocks(left, top, right, bottom)) return;
+
+	for (const Window *w : Window::Iterate()) AddWindowDirtyArea(w, left, top, right, bottom);
+}
+
+/**
+ * Extend the internal _invalid_rect rectangle to contain the rectangle
+ * defined by the given parameters, for a change that only affects the
+ * content of the given window, e.g. its viewport. Other windows within
+ * the rectangle are not repainted, unless they changed too.
+ *
+ * @param w The window that changed.
+ * @param left The left edge of the rectangle
+ * @param top The top edge of the rectangle
+ * @param right The right edge of the rectangle
+ * @param bottom The bottom edge of the rectangle
+ * @see DrawDirtyBlocks
+ * @ingroup dirty
+ */
+void AddDirtyBlock(const Window *w, int left, int top, int right, int bottom)
+{
+	if (!MarkDirtyBlocks(left, top, right, bottom)) return;
+
+	AddWindowDirtyArea(w, left, top, right, bottom);
+}
+
 /**
  * This function mark the whole screen as dirty. This results in repainting
  * the whole screen. Use this with care as this function will break the
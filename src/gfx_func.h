@@ -83,7 +83,7 @@ void UpdateGUIZoom();
 bool AdjustGUIZoom(bool automatic);
 void UndrawMouseCursor();
 
-void RedrawScreenRect(int left, int top, int right, int bottom);
+void RedrawScreenRect(int left, int top, int right, int bottom, bool only_changed = false);
 void GfxScroll(int left, int top, int width, int height, int xo, int yo);
 
 Dimension GetSpriteSize(SpriteID sprid, Point *offset = nullptr, ZoomLevel zoom = ZOOM_LVL_GUI);
@@ -145,6 +145,7 @@ void LoadStringWidthTable(bool monospace = false);
 
 void DrawDirtyBlocks();
 void AddDirtyBlock(int left, int top, int right, int bottom);
+void AddDirtyBlock(const struct Window *w, int left, int top, int right, int bottom);
 void MarkWholeScreenDirty();
 
 void CheckBlitter();
@@ -169,7 +170,7 @@ inline int CenterBounds(int min, int max, int size)
 }
 
 /* window.cpp */
-void DrawOverlappedWindowForAll(int left, int top, int right, int bottom);
+void DrawOverlappedWindowForAll(int left, int top, int right, int bottom, bool only_changed = false);
 
 void SetMouseCursorBusy(bool busy);
 void SetMouseCursor(CursorID cursor, PaletteID pal);
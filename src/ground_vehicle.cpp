@@ -80,14 +80,19 @@ void GroundVehicle<T, Type>::CargoChanged()
 {
 	assert(this->First() == this);
 	uint32_t weight = 0;
+	int64_t slope_force = 0;
 
 	for (T *u = T::From(this); u != nullptr; u = u->Next()) {
 		uint32_t current_weight = u->GetWeight();
 		weight += current_weight;
 		/* Slope steepness is in percent, result in N. */
 		u->gcache.cached_slope_resistance = current_weight * u->GetSlopeSteepness() * 100;
+		slope_force += u->GetPartSlopeResistance();
 	}
 
+	/* Store the slope resistance of the parts that are on a slope; it is kept up to date when they move onto or off a slope. */
+	this->gcache.cached_slope_force = slope_force;
+
 	/* Store consist weight in cache. */
 	this->gcache.cached_weight = std::max(1u, weight);
 	/* Friction in bearings and other mechanical parts is 0.1% of the weight (result in N). */
@@ -26,6 +26,7 @@ enum AccelStatus : uint8_t {
 /**
  * Cached, frequently calculated values.
  * All of these values except cached_slope_resistance are set only for the first part of a vehicle.
+ * cached_slope_force is also kept up to date whenever a part goes onto or off a slope.
  */
 struct GroundVehicleCache {
 	/* Cached acceleration values, recalculated when the cargo on a vehicle changes (in addition to the conditions below) */
@@ -33,6 +34,7 @@ struct GroundVehicleCache {
 	uint32_t cached_slope_resistance = 0; ///< Resistance caused by weight when this vehicle part is at a slope.
 	uint32_t cached_max_te = 0; ///< Maximum tractive effort of consist (valid only for the first engine).
 	uint16_t cached_axle_resistance = 0; ///< Resistance caused by the axles of the vehicle (valid only for the first engine).
+	int64_t cached_slope_force = 0; ///< Total slope resistance of the parts currently on a slope, negative for parts going downhill (valid only for the first engine).
 
 	/* Cached acceleration values, recalculated on load and each time a vehicle is added to/removed from the consist. */
 	uint16_t cached_max_track_speed = 0; ///< Maximum consist speed (in internal units) limited by track type (valid only for the first engine).
@@ -104,29 +106,42 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 	{
 		/* Crashed vehicles aren't going up or down */
 		for (T *v = T::From(this); v != nullptr; v = v->Next()) {
-			ClrBit(v->gv_flags, GVF_GOINGUP_BIT);
-			ClrBit(v->gv_flags, GVF_GOINGDOWN_BIT);
+			v->SetInclination(0);
 		}
 		return this->Vehicle::Crash(flooded);
 	}
 
 	/**
-	 * Calculates the total slope resistance for this vehicle.
+	 * Calculates the slope resistance of this vehicle part at its current position.
+	 * @return Slope resistance, negative when going downhill.
+	 */
+	inline int64_t GetPartSlopeResistance() const
+	{
+		if (HasBit(this->gv_flags, GVF_GOINGUP_BIT)) return this->gcache.cached_slope_resistance;
+		if (HasBit(this->gv_flags, GVF_GOINGDOWN_BIT)) return -static_cast<int64_t>(this->gcache.cached_slope_resistance);
+		return 0;
+	}
+
+	/**
+	 * Gets the total slope resistance for this vehicle.
 	 * @return Slope resistance.
 	 */
 	inline int64_t GetSlopeResistance() const
 	{
-		int64_t incl = 0;
-
-		for (const T *u = T::From(this); u != nullptr; u = u->Next()) {
-			if (HasBit(u->gv_flags, GVF_GOINGUP_BIT)) {
-				incl += u->gcache.cached_slope_resistance;
-			} else if (HasBit(u->gv_flags, GVF_GOINGDOWN_BIT)) {
-				incl -= u->gcache.cached_slope_resistance;
-			}
-		}
+		assert(this->First() == this);
+		return this->gcache.cached_slope_force;
+	}
 
-		return incl;
+	/**
+	 * Sets whether this vehicle part is going uphill or downhill,
+	 * and updates the total slope resistance of its consist accordingly.
+	 * @param flags Either nothing, or the bit of #GVF_GOINGUP_BIT or #GVF_GOINGDOWN_BIT.
+	 */
+	inline void SetInclination(uint16_t flags)
+	{
+		int64_t old_resistance = this->GetPartSlopeResistance();
+		this->gv_flags = (this->gv_flags & ~((1U << GVF_GOINGUP_BIT) | (1U << GVF_GOINGDOWN_BIT))) | flags;
+		this->First()->gcache.cached_slope_force += this->GetPartSlopeResistance() - old_resistance;
 	}
 
 	/**
@@ -138,8 +153,7 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 	inline void UpdateZPositionAndInclination()
 	{
 		this->z_pos = GetSlopePixelZ(this->x_pos, this->y_pos, true);
-		ClrBit(this->gv_flags, GVF_GOINGUP_BIT);
-		ClrBit(this->gv_flags, GVF_GOINGDOWN_BIT);
+		uint16_t inclination = 0;
 
 		if (T::From(this)->TileMayHaveSlopedTrack()) {
 			/* To check whether the current tile is sloped, and in which
@@ -149,9 +163,11 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 			int middle_z = GetSlopePixelZ((this->x_pos & ~TILE_UNIT_MASK) | (TILE_SIZE / 2), (this->y_pos & ~TILE_UNIT_MASK) | (TILE_SIZE / 2), true);
 
 			if (middle_z != this->z_pos) {
-				SetBit(this->gv_flags, (middle_z > this->z_pos) ? GVF_GOINGUP_BIT : GVF_GOINGDOWN_BIT);
+				SetBit(inclination, (middle_z > this->z_pos) ? GVF_GOINGUP_BIT : GVF_GOINGDOWN_BIT);
 			}
 		}
+
+		this->SetInclination(inclination);
 	}
 
 	/**
@@ -11,6 +11,7 @@
 #include "clear_map.h"
 #include "industry.h"
 #include "station_base.h"
+#include "station_func.h"
 #include "landscape.h"
 #include "viewport_func.h"
 #include "command_func.h"
@@ -47,6 +48,9 @@
 #include "timer/timer_game_calendar.h"
 #include "timer/timer_game_economy.h"
 #include "timer/timer_game_tick.h"
+#include "newgrf_profiling.h"
+#include "worker_pool.h"
+#include "entity_random.h"
 
 #include "table/strings.h"
 #include "table/industry_land.h"
@@ -155,6 +159,7 @@ Industry::~Industry()
 		if (IsTileType(tile_cur, MP_INDUSTRY)) {
 			if (GetIndustryIndex(tile_cur) == this->index) {
 				DeleteNewGRFInspectWindow(GSF_INDUSTRYTILES, tile_cur.base());
+				RemoveTileAcceptanceFromStations(tile_cur);
 
 				/* MakeWaterKeepingClass() can also handle 'land' */
 				MakeWaterKeepingClass(tile_cur, OWNER_NONE);
@@ -551,6 +556,31 @@ static bool TransportIndustryGoods(TileIndex tile)
 	return moved_cargo;
 }
 
+/**
+ * Change the graphics of an industry tile, and the acceptance of nearby stations when the new graphics accept something else.
+ * @param tile The industry tile.
+ * @param gfx The new graphics.
+ */
+static void ChangeIndustryTileGfx(TileIndex tile, IndustryGfx gfx)
+{
+	const IndustryTileSpec *old_spec = GetIndustryTileSpec(GetIndustryGfx(tile));
+	const IndustryTileSpec *new_spec = GetIndustryTileSpec(gfx);
+
+	static constexpr IndustryTileCallbackMasks acceptance_callbacks{IndustryTileCallbackMask::AcceptCargo, IndustryTileCallbackMask::CargoAcceptance};
+	bool same_acceptance = old_spec->accepts_cargo == new_spec->accepts_cargo && old_spec->acceptance == new_spec->acceptance &&
+			old_spec->special_flags.Test(IndustryTileSpecialFlag::AcceptsAllCargo) == new_spec->special_flags.Test(IndustryTileSpecialFlag::AcceptsAllCargo) &&
+			!old_spec->callback_mask.Any(acceptance_callbacks) && !new_spec->callback_mask.Any(acceptance_callbacks);
+
+	if (same_acceptance) {
+		SetIndustryGfx(tile, gfx);
+		return;
+	}
+
+	RemoveTileAcceptanceFromStations(tile);
+	SetIndustryGfx(tile, gfx);
+	AddTileAcceptanceToStations(tile);
+}
+
 static void AnimateSugarSieve(TileIndex tile)
 {
 	uint8_t m = GetAnimationFrame(tile) + 1;
@@ -640,7 +670,7 @@ static void AnimateToyFactory(TileIndex tile)
 static void AnimatePlasticFountain(TileIndex tile, IndustryGfx gfx)
 {
 	gfx = (gfx < GFX_PLASTIC_FOUNTAIN_ANIMATED_8) ? gfx + 1 : GFX_PLASTIC_FOUNTAIN_ANIMATED_1;
-	SetIndustryGfx(tile, gfx);
+	ChangeIndustryTileGfx(tile, gfx);
 	MarkTileDirtyByTile(tile);
 }
 
@@ -649,12 +679,12 @@ static void AnimateOilWell(TileIndex tile, IndustryGfx gfx)
 	bool b = Chance16(1, 7);
 	uint8_t m = GetAnimationFrame(tile) + 1;
 	if (m == 4 && (m = 0, ++gfx) == GFX_OILWELL_ANIMATED_3 + 1 && (gfx = GFX_OILWELL_ANIMATED_1, b)) {
-		SetIndustryGfx(tile, GFX_OILWELL_NOT_ANIMATED);
+		ChangeIndustryTileGfx(tile, GFX_OILWELL_NOT_ANIMATED);
 		SetIndustryConstructionStage(tile, 3);
 		DeleteAnimatedTile(tile);
 	} else {
 		SetAnimationFrame(tile, m);
-		SetIndustryGfx(tile, gfx);
+		ChangeIndustryTileGfx(tile, gfx);
 	}
 	MarkTileDirtyByTile(tile);
 }
@@ -858,7 +888,7 @@ static void TileLoop_Industry(TileIndex tile)
 		if (newgfx != INDUSTRYTILE_NOANIM) {
 			ResetIndustryConstructionStage(tile);
 			SetIndustryCompleted(tile);
-			SetIndustryGfx(tile, newgfx);
+			ChangeIndustryTileGfx(tile, newgfx);
 			MarkTileDirtyByTile(tile);
 			return;
 		}
@@ -869,7 +899,7 @@ static void TileLoop_Industry(TileIndex tile)
 	IndustryGfx newgfx = GetIndustryTileSpec(GetIndustryGfx(tile))->anim_next;
 	if (newgfx != INDUSTRYTILE_NOANIM) {
 		ResetIndustryConstructionStage(tile);
-		SetIndustryGfx(tile, newgfx);
+		ChangeIndustryTileGfx(tile, newgfx);
 		MarkTileDirtyByTile(tile);
 		return;
 	}
@@ -885,7 +915,7 @@ static void TileLoop_Industry(TileIndex tile)
 				case GFX_COPPER_MINE_TOWER_NOT_ANIMATED: gfx = GFX_COPPER_MINE_TOWER_ANIMATED; break;
 				case GFX_GOLD_MINE_TOWER_NOT_ANIMATED:   gfx = GFX_GOLD_MINE_TOWER_ANIMATED;   break;
 			}
-			SetIndustryGfx(tile, gfx);
+			ChangeIndustryTileGfx(tile, gfx);
 			SetAnimationFrame(tile, 0x80);
 			AddAnimatedTile(tile);
 		}
@@ -893,7 +923,7 @@ static void TileLoop_Industry(TileIndex tile)
 
 	case GFX_OILWELL_NOT_ANIMATED:
 		if (Chance16(1, 6)) {
-			SetIndustryGfx(tile, GFX_OILWELL_ANIMATED_1);
+			ChangeIndustryTileGfx(tile, GFX_OILWELL_ANIMATED_1);
 			SetAnimationFrame(tile, 0);
 			AddAnimatedTile(tile);
 		}
@@ -908,7 +938,7 @@ static void TileLoop_Industry(TileIndex tile)
 				case GFX_COPPER_MINE_TOWER_ANIMATED: gfx = GFX_COPPER_MINE_TOWER_NOT_ANIMATED; break;
 				case GFX_GOLD_MINE_TOWER_ANIMATED:   gfx = GFX_GOLD_MINE_TOWER_NOT_ANIMATED;   break;
 			}
-			SetIndustryGfx(tile, gfx);
+			ChangeIndustryTileGfx(tile, gfx);
 			SetIndustryCompleted(tile);
 			SetIndustryConstructionStage(tile, 3);
 			DeleteAnimatedTile(tile);
@@ -1166,7 +1196,55 @@ static void ProduceIndustryGoodsHelper(Industry *i, bool scale)
 	}
 }
 
-static void ProduceIndustryGoods(Industry *i)
+/** Periodic production callback of an industry that is run before the industries are processed one by one. */
+struct PreparedProductionCallback {
+	Industry *industry; ///< The industry.
+	uint32_t random_bits; ///< Random bits for the callback, from the stream of the industry.
+	bool done; ///< Whether the callback has been applied already, as it had no side effects.
+};
+
+static std::vector<PreparedProductionCallback> _prepared_production_callbacks; ///< Production callbacks of the current tick, in the order of the industries.
+
+/**
+ * Run the production callbacks that are due this tick, in parallel, before the industries are processed one by one.
+ * All callbacks see the game state from before any industry is processed. Callbacks that want to change more than
+ * the waiting cargo of their own industry are not applied, and run again when their industry is processed.
+ * None of this depends on the number of threads, so all clients get the same result.
+ */
+static void PrepareProductionCallbacks()
+{
+	_prepared_production_callbacks.clear();
+	for (Industry *i : Industry::Iterate()) {
+		const IndustrySpec *indsp = GetIndustrySpec(i->type);
+		if (!indsp->callback_mask.Test(IndustryCallbackMask::Production256Ticks)) continue;
+
+		/* ProduceIndustryGoods decreases the counter before checking whether the callback is due. */
+		uint16_t counter = i->counter - 1;
+		if (counter % ScaleByInverseCargoScale(Ticks::INDUSTRY_PRODUCE_TICKS, false) != 0) continue;
+
+		uint32_t random_bits = indsp->behaviour.Test(IndustryBehaviour::ProdCallbackRandom) ? GetEntityRandomizer(RandomStream::IndustryProduction, i->index.base()).Next() : 0;
+		_prepared_production_callbacks.push_back({i, random_bits, false});
+	}
+
+	WorkerJob job = [](size_t index) {
+		PreparedProductionCallback &callback = _prepared_production_callbacks[index];
+		callback.done = SpeculativeIndustryProductionCallback(callback.industry, callback.random_bits);
+	};
+
+	/* The NewGRF profiler records the callbacks as they are resolved, which only works on a single thread. */
+	if (_newgrf_profilers.empty()) {
+		RunWorkerJobs(_prepared_production_callbacks.size(), job);
+	} else {
+		for (size_t index = 0; index < _prepared_production_callbacks.size(); index++) job(index);
+	}
+}
+
+/**
+ * Produce the goods of an industry, and do its other periodic actions.
+ * @param i The industry.
+ * @param prepared The production callback of this tick that has already been run, if any.
+ */
+static void ProduceIndustryGoods(Industry *i, const PreparedProductionCallback *prepared)
 {
 	const IndustrySpec *indsp = GetIndustrySpec(i->type);
 
@@ -1188,7 +1266,13 @@ static void ProduceIndustryGoods(Industry *i)
 	/* If using an industry callback, scale the callback interval by cargo scale percentage. */
 	if (indsp->callback_mask.Test(IndustryCallbackMask::Production256Ticks)) {
 		if (i->counter % ScaleByInverseCargoScale(Ticks::INDUSTRY_PRODUCE_TICKS, false) == 0) {
-			IndustryProductionCallback(i, 1);
+			if (prepared == nullptr) {
+				IndustryProductionCallback(i, 1);
+			} else if (prepared->done) {
+				SetWindowDirty(WC_INDUSTRY_VIEW, i->index);
+			} else {
+				IndustryProductionCallback(i, 1, prepared->random_bits);
+			}
 			ProduceIndustryGoodsHelper(i, false);
 		}
 	}
@@ -1254,9 +1338,22 @@ void OnTick_Industry()
 
 	if (_game_mode == GM_EDITOR) return;
 
+	if (!_settings_game.economy.parallel_industry_production) {
+		for (Industry *i : Industry::Iterate()) {
+			ProduceIndustryGoods(i, nullptr);
+		}
+		return;
+	}
+
+	PrepareProductionCallbacks();
+
+	auto prepared = _prepared_production_callbacks.begin();
 	for (Industry *i : Industry::Iterate()) {
-		ProduceIndustryGoods(i);
+		const PreparedProductionCallback *callback = nullptr;
+		if (prepared != _prepared_production_callbacks.end() && prepared->industry == i) callback = &*prepared++;
+		ProduceIndustryGoods(i, callback);
 	}
+	assert(prepared == _prepared_production_callbacks.end());
 }
 
 /**
@@ -1945,6 +2042,7 @@ static void DoCreateNewIndustry(Industry *i, TileIndex tile, IndustryType type,
 			Command<CMD_LANDSCAPE_CLEAR>::Do({DoCommandFlag::Execute, DoCommandFlag::NoTestTownRating, DoCommandFlag::NoModifyTownRating}, cur_tile);
 
 			MakeIndustry(cur_tile, i->index, it.gfx, Random(), wc);
+			AddTileAcceptanceToStations(cur_tile);
 
 			if (_generating_world) {
 				SetIndustryConstructionCounter(cur_tile, 3);
@@ -2998,6 +3096,39 @@ static void ChangeIndustryProduction(Industry *i, bool monthly)
 	}
 }
 
+/**
+ * Monthly production change of an industry, or its closure when that was announced.
+ * @param i The industry.
+ */
+static void IndustryMonthlyProductionChange(Industry *i)
+{
+	if (i->prod_level == PRODLEVEL_CLOSURE) {
+		delete i;
+	} else {
+		ChangeIndustryProduction(i, true);
+		SetWindowDirty(WC_INDUSTRY_VIEW, i->index);
+	}
+}
+
+/** Monthly production changes of today's part of the industries, when they are spread over the month. */
+static void IndustriesMonthSlice()
+{
+	std::optional<uint> slice = GetEconomyMonthSlice();
+	if (!slice.has_value()) return;
+
+	Backup<CompanyID> cur_company(_current_company, OWNER_NONE);
+
+	for (size_t index = *slice; index < Industry::GetPoolSize(); index += ECONOMY_MONTH_SLICES) {
+		Industry *i = Industry::GetIfValid(index);
+		if (i != nullptr) IndustryMonthlyProductionChange(i);
+	}
+
+	cur_company.Restore();
+
+	/* production-change */
+	InvalidateWindowData(WC_INDUSTRY_DIRECTORY, 0, IDIWD_PRODUCTION_CHANGE);
+}
+
 /**
  * Every economy day handler for the industry changes
  * Taking the original map size of 256*256, the number of random changes was always of just one unit.
@@ -3007,6 +3138,8 @@ static void ChangeIndustryProduction(Industry *i, bool monthly)
  */
 static IntervalTimer<TimerGameEconomy> _economy_industries_daily({TimerGameEconomy::DAY, TimerGameEconomy::Priority::INDUSTRY}, [](auto)
 {
+	IndustriesMonthSlice();
+
 	_economy.industry_daily_change_counter += _economy.industry_daily_increment;
 
 	/* Bits 16-31 of industry_construction_counter contain the number of industries to change/create today,
@@ -3053,14 +3186,11 @@ static IntervalTimer<TimerGameEconomy> _economy_industries_monthly({TimerGameEco
 
 	_industry_builder.EconomyMonthlyLoop();
 
+	bool spread = _economy.spread_monthly_loop;
 	for (Industry *i : Industry::Iterate()) {
 		UpdateIndustryStatistics(i);
-		if (i->prod_level == PRODLEVEL_CLOSURE) {
-			delete i;
-		} else {
-			ChangeIndustryProduction(i, true);
-			SetWindowDirty(WC_INDUSTRY_VIEW, i->index);
-		}
+		/* When spread, the production changes happen during the month, based on the statistics of the month that just ended. */
+		if (!spread) IndustryMonthlyProductionChange(i);
 	}
 
 	cur_company.Restore();
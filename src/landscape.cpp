@@ -34,6 +34,7 @@
 #include "pathfinder/aystar.h"
 #include "saveload/saveload.h"
 #include "framerate_type.h"
+#include "tick_profiling.h"
 #include "landscape_cmd.h"
 #include "terraform_cmd.h"
 #include "station_func.h"
@@ -76,6 +77,22 @@ const TileTypeProcs * const _tile_type_procs[16] = {
 	&_tile_type_object_procs,       ///< Callback functions for MP_OBJECT tiles
 };
 
+/** Names of the tile loop of each type of tile for the tick profiler. */
+static const char * const _tile_loop_zone_names[] = {
+	"TileLoop_Clear",
+	"TileLoop_Railway",
+	"TileLoop_Road",
+	"TileLoop_House",
+	"TileLoop_Trees",
+	"TileLoop_Station",
+	"TileLoop_Water",
+	"TileLoop_Void",
+	"TileLoop_Industry",
+	"TileLoop_TunnelBridge",
+	"TileLoop_Object",
+};
+static_assert(lengthof(_tile_loop_zone_names) == MP_OBJECT + 1);
+
 /** landscape slope => sprite */
 extern const uint8_t _slope_to_sprite_offset[32] = {
 	0, 1, 2, 3, 4, 5, 6,  7, 8, 9, 10, 11, 12, 13, 14, 0,
@@ -759,6 +776,7 @@ TileIndex _cur_tileloop_tile;
 void RunTileLoop()
 {
 	PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
+	TickProfilerZone zone("RunTileLoop");
 
 	/* The pseudorandom sequence of tiles is generated using a Galois linear feedback
 	 * shift register (LFSR). This allows a deterministic pseudorandom ordering, but
@@ -782,12 +800,18 @@ void RunTileLoop()
 
 	/* Manually update tile 0 every TILE_UPDATE_FREQUENCY ticks - the LFSR never iterates over it itself.  */
 	if (TimerGameTick::counter % TILE_UPDATE_FREQUENCY == 0) {
-		_tile_type_procs[GetTileType(0)]->tile_loop_proc(TileIndex{});
+		TileType type = GetTileType(0);
+		TickProfilerZone tile_zone(_tile_loop_zone_names[type]);
+		_tile_type_procs[type]->tile_loop_proc(TileIndex{});
 		count--;
 	}
 
 	while (count--) {
-		_tile_type_procs[GetTileType(tile)]->tile_loop_proc(tile);
+		TileType type = GetTileType(tile);
+		{
+			TickProfilerZone tile_zone(_tile_loop_zone_names[type]);
+			_tile_type_procs[type]->tile_loop_proc(tile);
+		}
 
 		/* Get the next tile in sequence using a Galois LFSR. */
 		tile = TileIndex{(tile.base() >> 1) ^ (-(int32_t)(tile.base() & 1) & feedback)};
@@ -1647,12 +1671,12 @@ void CallLandscapeTick()
 	{
 		PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
 
-		OnTick_Town();
-		OnTick_Trees();
-		OnTick_Station();
-		OnTick_Industry();
+		{ TickProfilerZone zone("OnTick_Town"); OnTick_Town(); }
+		{ TickProfilerZone zone("OnTick_Trees"); OnTick_Trees(); }
+		{ TickProfilerZone zone("OnTick_Station"); OnTick_Station(); }
+		{ TickProfilerZone zone("OnTick_Industry"); OnTick_Industry(); }
 	}
 
-	OnTick_Companies();
-	OnTick_LinkGraph();
+	{ TickProfilerZone zone("OnTick_Companies"); OnTick_Companies(); }
+	{ TickProfilerZone zone("OnTick_LinkGraph"); OnTick_LinkGraph(); }
 }
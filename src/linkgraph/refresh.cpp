@@ -291,7 +291,7 @@ void LinkRefresher::RefreshLinks(const Order *cur, const Order *next, uint8_t fl
 
 		next = this->PredictNextOrder(cur, next, flags, num_hops);
 		if (next == nullptr) break;
-		Hop hop(cur->index, next->index, this->cargo);
+		Hop hop(this->vehicle->orders->GetIndexOfOrder(cur), this->vehicle->orders->GetIndexOfOrder(next), this->cargo);
 		if (this->seen_hops->find(hop) != this->seen_hops->end()) {
 			break;
 		} else {
@@ -28,10 +28,12 @@
 #include "core/pool_type.hpp"
 #include "game/game.hpp"
 #include "linkgraph/linkgraphschedule.h"
+#include "depot_kdtree.h"
 #include "station_kdtree.h"
 #include "town_kdtree.h"
 #include "viewport_kdtree.h"
 #include "newgrf_profiling.h"
+#include "pathfinder/yapf/yapf_cache.h"
 #include "3rdparty/monocypher/monocypher.h"
 
 #include "safeguards.h"
@@ -126,6 +128,8 @@ void InitializeGame(uint size_x, uint size_y, bool reset_date, bool reset_settin
 	RebuildStationKdtree();
 	RebuildTownKdtree();
 	RebuildViewportKdtree();
+	RebuildDepotKdtrees();
+	YapfNotifyRoadLayoutChange(INVALID_TILE);
 
 	ResetPersistentNewGRFData();
 
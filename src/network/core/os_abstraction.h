@@ -91,6 +91,12 @@ typedef unsigned long in_addr_t;
 #	include <sys/time.h>
 #	include <netdb.h>
 
+/* Linux can tell us which sockets became ready, instead of us asking about every socket each frame. */
+#	if defined(__linux__) && !defined(__EMSCRIPTEN__)
+#		define HAVE_EPOLL
+#		include <sys/epoll.h>
+#	endif
+
 #   if defined(__EMSCRIPTEN__)
 /* Emscripten doesn't support AI_ADDRCONFIG and errors out on it. */
 #		undef AI_ADDRCONFIG
@@ -42,6 +42,7 @@ NetworkRecvStatus NetworkTCPSocketHandler::CloseConnection([[maybe_unused]] bool
 {
 	this->MarkClosed();
 	this->writable = false;
+	this->readable = false;
 
 	this->packet_queue.clear();
 	this->packet_recv = nullptr;
@@ -92,6 +93,8 @@ SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 				}
 				return SPS_CLOSED;
 			}
+			/* The send buffer is full; wait until we are told it drained. */
+			this->writable = false;
 			return SPS_PARTLY_SENT;
 		}
 		if (res == 0) {
@@ -141,6 +144,7 @@ std::unique_ptr<Packet> NetworkTCPSocketHandler::ReceivePacket()
 					return nullptr;
 				}
 				/* Connection would block, so stop for now */
+				this->readable = false;
 				return nullptr;
 			}
 			if (res == 0) {
@@ -169,6 +173,7 @@ std::unique_ptr<Packet> NetworkTCPSocketHandler::ReceivePacket()
 				return nullptr;
 			}
 			/* Connection would block */
+			this->readable = false;
 			return nullptr;
 		}
 		if (res == 0) {
@@ -189,7 +194,7 @@ std::unique_ptr<Packet> NetworkTCPSocketHandler::ReceivePacket()
 /**
  * Check whether this socket can send or receive something.
  * @return \c true when there is something to receive.
- * @note Sets #writable if more data can be sent.
+ * @note Sets #writable if more data can be sent, and #readable if there is something to receive.
  */
 bool NetworkTCPSocketHandler::CanSendReceive()
 {
@@ -208,5 +213,6 @@ bool NetworkTCPSocketHandler::CanSendReceive()
 	if (select(FD_SETSIZE, &read_fd, &write_fd, nullptr, &tv) < 0) return false;
 
 	this->writable = !!FD_ISSET(this->sock, &write_fd);
-	return FD_ISSET(this->sock, &read_fd) != 0;
+	this->readable = !!FD_ISSET(this->sock, &read_fd);
+	return this->readable;
 }
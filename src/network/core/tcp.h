@@ -37,6 +37,8 @@ private:
 public:
 	SOCKET sock = INVALID_SOCKET; ///< The socket currently connected to
 	bool writable = false; ///< Can we write to this socket?
+	bool readable = false; ///< Can we read from this socket?
+	bool polled = false;   ///< Is this socket registered with the event poller of its listener?
 
 	/**
 	 * Whether this socket is currently bound to a socket.
@@ -16,6 +16,7 @@
 #include "../network.h"
 #include "../../core/pool_type.hpp"
 #include "../../debug.h"
+#include "../../framerate_type.h"
 #include "table/strings.h"
 
 /**
@@ -29,6 +30,93 @@ class TCPListenHandler {
 	/** List of sockets we listen on. */
 	static SocketList sockets;
 
+#ifdef HAVE_EPOLL
+	/** Event poller for the listeners and all accepted clients, or -1 when select has to be used. */
+	static int poll_fd;
+
+	/** Maximum number of events to fetch from the event poller in one go. */
+	static constexpr int MAX_POLL_EVENTS = 256;
+
+	/**
+	 * Register a socket with the event poller.
+	 * Events are edge triggered, so a socket is only reported again after it has been
+	 * read from (or written to) until it would block.
+	 * @param s The socket to register.
+	 * @param cs The client for the socket, or \c nullptr for the listeners.
+	 * @return Whether registering succeeded.
+	 */
+	static bool RegisterPoll(SOCKET s, Tsocket *cs)
+	{
+		struct epoll_event ev{};
+		ev.events = (cs == nullptr) ? EPOLLIN : (EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET);
+		ev.data.ptr = cs;
+		if (epoll_ctl(poll_fd, EPOLL_CTL_ADD, s, &ev) == 0) return true;
+
+		Debug(net, 0, "[{}] epoll_ctl failed: {}", Tsocket::GetName(), NetworkError::GetLast().AsString());
+		return false;
+	}
+
+	/** Stop using the event poller; from now on select is used. */
+	static void ClosePoll()
+	{
+		if (poll_fd == -1) return;
+
+		close(poll_fd);
+		poll_fd = -1;
+	}
+
+	/**
+	 * Find out which sockets became ready since the last call, without blocking.
+	 * Only the clients that are reported are marked #readable or #writable; the others keep
+	 * their state, as that is only reset once a socket operation would block.
+	 * @return false when the event poller failed.
+	 */
+	static bool Poll()
+	{
+		for (Tsocket *cs : Tsocket::Iterate()) {
+			if (cs->polled || !cs->IsConnected()) continue;
+
+			/* A freshly accepted client might already have data waiting, which would not trigger an edge anymore. */
+			if (!RegisterPoll(cs->sock, cs)) return false;
+			cs->polled = true;
+			cs->readable = true;
+			cs->writable = true;
+		}
+
+		struct epoll_event events[MAX_POLL_EVENTS];
+		bool accept = false;
+		int n;
+		do {
+			{
+				PerformanceAccumulator framerate(PFE_NETWORK_POLL);
+				n = epoll_wait(poll_fd, events, MAX_POLL_EVENTS, 0);
+			}
+			if (n < 0) {
+				if (errno == EINTR) break;
+				Debug(net, 0, "[{}] epoll_wait failed: {}", Tsocket::GetName(), NetworkError::GetLast().AsString());
+				return false;
+			}
+
+			for (int i = 0; i < n; i++) {
+				Tsocket *cs = static_cast<Tsocket *>(events[i].data.ptr);
+				if (cs == nullptr) {
+					accept = true;
+					continue;
+				}
+				/* Errors and hang ups are found out by reading. */
+				if ((events[i].events & ~EPOLLOUT) != 0) cs->readable = true;
+				if ((events[i].events & EPOLLOUT) != 0) cs->writable = true;
+			}
+		} while (n == MAX_POLL_EVENTS);
+
+		/* The listeners are level triggered and each accept until nothing is pending. */
+		if (accept) {
+			for (auto &s : sockets) AcceptClient(s.first);
+		}
+		return true;
+	}
+#endif /* HAVE_EPOLL */
+
 public:
 	static bool ValidateClient(SOCKET s, NetworkAddress &address)
 	{
@@ -100,6 +188,20 @@ public:
 	 */
 	static bool Receive()
 	{
+#ifdef HAVE_EPOLL
+		if (poll_fd != -1) {
+			if (Poll()) {
+				for (Tsocket *cs : Tsocket::Iterate()) {
+					if (cs->readable) cs->ReceivePackets();
+				}
+				return _networking;
+			}
+
+			/* Do not leave the clients half registered; select takes over from here. */
+			ClosePoll();
+		}
+#endif /* HAVE_EPOLL */
+
 		fd_set read_fd, write_fd;
 		struct timeval tv;
 
@@ -118,7 +220,10 @@ public:
 		}
 
 		tv.tv_sec = tv.tv_usec = 0; // don't block at all.
-		if (select(FD_SETSIZE, &read_fd, &write_fd, nullptr, &tv) < 0) return false;
+		{
+			PerformanceAccumulator framerate(PFE_NETWORK_POLL);
+			if (select(FD_SETSIZE, &read_fd, &write_fd, nullptr, &tv) < 0) return false;
+		}
 
 		/* accept clients.. */
 		for (auto &s : sockets) {
@@ -128,7 +233,8 @@ public:
 		/* read stuff from clients */
 		for (Tsocket *cs : Tsocket::Iterate()) {
 			cs->writable = !!FD_ISSET(cs->sock, &write_fd);
-			if (FD_ISSET(cs->sock, &read_fd)) {
+			cs->readable = !!FD_ISSET(cs->sock, &read_fd);
+			if (cs->readable) {
 				cs->ReceivePackets();
 			}
 		}
@@ -157,12 +263,29 @@ public:
 			return false;
 		}
 
+#ifdef HAVE_EPOLL
+		poll_fd = epoll_create1(EPOLL_CLOEXEC);
+		if (poll_fd == -1) {
+			Debug(net, 1, "[{}] epoll_create1 failed, falling back to select: {}", Tsocket::GetName(), NetworkError::GetLast().AsString());
+		} else {
+			for (auto &s : sockets) {
+				if (!RegisterPoll(s.first, nullptr)) {
+					ClosePoll();
+					break;
+				}
+			}
+		}
+#endif /* HAVE_EPOLL */
+
 		return true;
 	}
 
 	/** Close the sockets we're listening on. */
 	static void CloseListeners()
 	{
+#ifdef HAVE_EPOLL
+		ClosePoll();
+#endif /* HAVE_EPOLL */
 		for (auto &s : sockets) {
 			closesocket(s.first);
 		}
@@ -172,5 +295,8 @@ public:
 };
 
 template <class Tsocket, PacketType Tfull_packet, PacketType Tban_packet> SocketList TCPListenHandler<Tsocket, Tfull_packet, Tban_packet>::sockets;
+#ifdef HAVE_EPOLL
+template <class Tsocket, PacketType Tfull_packet, PacketType Tban_packet> int TCPListenHandler<Tsocket, Tfull_packet, Tban_packet>::poll_fd = -1;
+#endif /* HAVE_EPOLL */
 
 #endif /* NETWORK_CORE_TCP_LISTEN_H */
@@ -37,6 +37,7 @@
 #include "../gfx_func.h"
 #include "../error.h"
 #include "../misc_cmd.h"
+#include "../framerate_type.h"
 #ifdef DEBUG_DUMP_COMMANDS
 #	include "../fileio_func.h"
 #endif
@@ -83,6 +84,7 @@ uint32_t _sync_seed_1;                  ///< Seed to compare during sync checks.
 uint32_t _sync_seed_2;                  ///< Second part of the seed.
 #endif
 uint32_t _sync_frame;                   ///< The frame to perform the sync check.
+std::optional<CompletedGameStateHash> _sync_state_hash; ///< Game state hash to compare during sync checks, if the server sent one.
 bool _network_first_time;             ///< Whether we have finished joining or not.
 
 /** The amount of clients connected */
@@ -631,6 +633,8 @@ static void NetworkInitialize(bool close_admins = true)
 	InitializeNetworkPools(close_admins);
 
 	_sync_frame = 0;
+	_sync_state_hash.reset();
+	SetGameStateHashing(false);
 	_network_first_time = true;
 
 	_network_reconnect = 0;
@@ -1051,6 +1055,7 @@ static bool NetworkReceive()
 {
 	bool result;
 	if (_network_server) {
+		PerformanceAccumulator::Reset(PFE_NETWORK_POLL);
 		ServerNetworkAdminSocketHandler::Receive();
 		result = ServerNetworkGameSocketHandler::Receive();
 	} else {
@@ -1257,6 +1262,9 @@ void NetworkGameLoop()
 		_sync_seed_2 = _random.state[1];
 #endif
 
+		SetGameStateHashing(_settings_client.network.sync_state_hash);
+		UpdateGameStateHash(_frame_counter);
+
 		NetworkServer_Tick(send_frame);
 	} else {
 		/* Client */
@@ -227,6 +227,26 @@ void ClientNetworkGameSocketHandler::ClientError(NetworkRecvStatus res)
 	if (my_client != nullptr) my_client->CheckConnection();
 }
 
+/**
+ * Compare the game state hash the server sent with our own, when both were completed at the same frame.
+ * @return False iff the hashes differ.
+ */
+static bool CheckGameStateHash()
+{
+	if (!_sync_state_hash.has_value()) return true;
+
+	const std::optional<CompletedGameStateHash> &own = GetLastGameStateHash();
+	if (!own.has_value() || own->frame != _sync_state_hash->frame) return true;
+	if (own->hash == _sync_state_hash->hash) return true;
+
+	for (uint8_t part = 0; part < GSHP_END; part++) {
+		if (own->hash.parts[part] != _sync_state_hash->hash.parts[part]) {
+			Debug(desync, 0, "Game state hash of {} differs at frame {}", GetGameStateHashPartName(static_cast<GameStateHashPart>(part)), own->frame);
+		}
+	}
+	return false;
+}
+
 /**
  * Actual game loop for the client.
  * @return Whether everything went okay, or not.
@@ -238,6 +258,7 @@ void ClientNetworkGameSocketHandler::ClientError(NetworkRecvStatus res)
 	NetworkExecuteLocalCommandQueue();
 
 	StateGameLoop();
+	UpdateGameStateHash(_frame_counter);
 
 	/* Check if we are in sync! */
 	if (_sync_frame != 0) {
@@ -254,6 +275,14 @@ void ClientNetworkGameSocketHandler::ClientError(NetworkRecvStatus res)
 				return false;
 			}
 
+			if (!CheckGameStateHash()) {
+				ShowNetworkError(STR_NETWORK_ERROR_DESYNC);
+				Debug(desync, 1, "sync_err: {:08x}; {:02x}", TimerGameEconomy::date, TimerGameEconomy::date_fract);
+				Debug(net, 0, "Sync error detected in the game state hash");
+				my_client->ClientError(NETWORK_RECV_STATUS_DESYNC);
+				return false;
+			}
+
 			/* If this is the first time we have a sync-frame, we
 			 *   need to let the server know that we are ready and at the same
 			 *   frame as it is.. so we can start playing! */
@@ -915,6 +944,17 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_SYNC(Packet &p)
 	_sync_seed_2 = p.Recv_uint32();
 #endif
 
+	/* The server hashes the game state; start doing the same, so there is something to compare with. */
+	_sync_state_hash.reset();
+	if (p.CanReadFromPacket(sizeof(uint32_t) + sizeof(uint8_t))) {
+		CompletedGameStateHash state_hash;
+		state_hash.frame = p.Recv_uint32();
+		if (p.Recv_uint8() != GSHP_END) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
+		for (uint64_t &part : state_hash.hash.parts) part = p.Recv_uint64();
+		_sync_state_hash = state_hash;
+		SetGameStateHashing(true);
+	}
+
 	Debug(net, 9, "Client::Receive_SERVER_SYNC(): sync_frame={}, sync_seed_1={}", _sync_frame, _sync_seed_1);
 
 	return NETWORK_RECV_STATUS_OKAY;
@@ -261,11 +261,7 @@ void NetworkExecuteLocalCommandQueue()
 		}
 
 		/* We can execute this command */
-		_current_company = cp->company;
-		size_t cb_index = FindCallbackIndex(cp->callback);
-		assert(cb_index < _callback_tuple_size);
-		assert(_cmd_dispatch[cp->cmd].Unpack[cb_index] != nullptr);
-		_cmd_dispatch[cp->cmd].Unpack[cb_index](*cp);
+		NetworkExecuteCommandPacket(*cp);
 	}
 	queue.erase(queue.begin(), cp);
 
@@ -273,6 +269,20 @@ void NetworkExecuteLocalCommandQueue()
 	_current_company = _local_company;
 }
 
+/**
+ * Execute a command packet right away, as if it arrived from the network.
+ * This changes the current company to the company of the command.
+ * @param cp The command packet to execute.
+ */
+void NetworkExecuteCommandPacket(const CommandPacket &cp)
+{
+	_current_company = cp.company;
+	size_t cb_index = FindCallbackIndex(cp.callback);
+	assert(cb_index < _callback_tuple_size);
+	assert(_cmd_dispatch[cp.cmd].Unpack[cb_index] != nullptr);
+	_cmd_dispatch[cp.cmd].Unpack[cb_index](cp);
+}
+
 /**
  * Free the local command queues.
  */
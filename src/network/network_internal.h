@@ -18,6 +18,7 @@
 #include "../command_func.h"
 #include "../misc/endian_buffer.hpp"
 #include "../strings_type.h"
+#include "../state_hash.h"
 
 #ifdef RANDOM_DEBUG
 /**
@@ -67,6 +68,7 @@ extern uint32_t _sync_seed_1;
 extern uint32_t _sync_seed_2;
 #endif
 extern uint32_t _sync_frame;
+extern std::optional<CompletedGameStateHash> _sync_state_hash;
 extern bool _network_first_time;
 /* Vars needed for the join-GUI */
 extern NetworkJoinStatus _network_join_status;
@@ -105,6 +107,7 @@ struct CommandPacket {
 
 void NetworkDistributeCommands();
 void NetworkExecuteLocalCommandQueue();
+void NetworkExecuteCommandPacket(const CommandPacket &cp);
 void NetworkFreeLocalCommandQueue();
 void NetworkSyncCommandQueue(NetworkClientSocket *cs);
 void NetworkReplaceCommandClientId(CommandPacket &cp, ClientID client_id);
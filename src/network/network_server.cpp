@@ -645,6 +645,14 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendSync()
 #ifdef NETWORK_SEND_DOUBLE_SEED
 	p->Send_uint32(_sync_seed_2);
 #endif
+
+	/* Optionally, the hash of the game state of the last complete hashing cycle. */
+	const std::optional<CompletedGameStateHash> &state_hash = GetLastGameStateHash();
+	if (state_hash.has_value()) {
+		p->Send_uint32(state_hash->frame);
+		p->Send_uint8(GSHP_END);
+		for (uint64_t part : state_hash->hash.parts) p->Send_uint64(part);
+	}
 	this->SendPacket(std::move(p));
 	return NETWORK_RECV_STATUS_OKAY;
 }
@@ -5431,6 +5431,97 @@ static const SpriteGroup *CreateGroupFromGroupID(uint8_t feature, uint8_t setid,
 	return new ResultSpriteGroup(spriteset_start, num_sprites);
 }
 
+/**
+ * Get how long the value of a variable read by a deterministic sprite group stays the same.
+ * @param feature GrfSpecFeature of the sprite group.
+ * @param scope Scope the variable is read from.
+ * @param variable The variable.
+ * @return Stability of the variable's value.
+ */
+static VarStability GetVariableStability(GrfSpecFeature feature, VarSpriteGroupScope scope, uint8_t variable)
+{
+	switch (variable) {
+		/* Callback information, GRF parameters and constants. */
+		case 0x03: case 0x0B: case 0x0C: case 0x10: case 0x11: case 0x18: case 0x1A:
+		case 0x1B: case 0x1C: case 0x1D: case 0x21: case 0x22: case 0x7F:
+			return VarStability::Consist;
+
+		/* Calendar date. */
+		case 0x00: case 0x01: case 0x02: case 0x09: case 0x23: case 0x24:
+			return VarStability::Tick;
+
+		/* Random bits, registers and other global variables. */
+		case 0x5F: case 0x7B: case 0x7D:
+			return VarStability::Volatile;
+
+		default:
+			if (variable < 0x40 && variable != 0x25) return VarStability::Volatile;
+			break;
+	}
+
+	/* The parent's NewGRF cache may be invalidated independently of the resolved vehicle's one. */
+	if (feature <= GSF_AIRCRAFT && scope == VSG_SCOPE_SELF) return GetVehicleVariableStability(variable);
+
+	return VarStability::Volatile;
+}
+
+/**
+ * Get how long the callback result of a sprite group stays the same, treating missing groups as failing callbacks.
+ * @param group The sprite group, may be \c nullptr.
+ * @return Stability of the callback result.
+ */
+static VarStability GetGroupStability(const SpriteGroup *group)
+{
+	return group == nullptr ? VarStability::Consist : group->stability;
+}
+
+/**
+ * Determine how long the callback result of a deterministic sprite group stays the same.
+ * @param feature GrfSpecFeature of the sprite group.
+ * @param group The completely loaded sprite group.
+ * @return Stability of the callback result.
+ */
+static VarStability GetDeterministicSpriteGroupStability(GrfSpecFeature feature, const DeterministicSpriteGroup *group)
+{
+	VarStability stability = std::max(GetGroupStability(group->default_group), GetGroupStability(group->error_group));
+	for (const auto &range : group->ranges) {
+		stability = std::max(stability, GetGroupStability(range.group));
+	}
+
+	for (const auto &adjust : group->adjusts) {
+		/* Writing to storage is a side effect that must not be skipped. */
+		if (adjust.operation == DSGA_OP_STO || adjust.operation == DSGA_OP_STOP) return VarStability::Volatile;
+
+		if (adjust.variable == 0x7E) {
+			stability = std::max(stability, GetGroupStability(adjust.subroutine));
+		} else {
+			stability = std::max(stability, GetVariableStability(feature, group->var_scope, adjust.variable));
+		}
+	}
+
+	return stability;
+}
+
+/**
+ * Check whether resolving a sprite group can never yield a callback result, no matter the state of the resolved object.
+ * @param group The sprite group, may be \c nullptr.
+ * @return True iff callbacks always fail for this group.
+ */
+static bool AlwaysFailsCallback(const SpriteGroup *group)
+{
+	if (group == nullptr) return true;
+
+	switch (group->type) {
+		case SGT_REAL:
+		case SGT_RANDOMIZED:
+		case SGT_RESULT:
+			return group->stability == VarStability::Consist;
+
+		default:
+			return false;
+	}
+}
+
 /* Action 0x02 */
 static void NewSpriteGroup(ByteReader &buf)
 {
@@ -5567,6 +5658,8 @@ static void NewSpriteGroup(ByteReader &buf)
 				}
 			}
 
+			group->Optimise();
+			group->stability = GetDeterministicSpriteGroupStability(static_cast<GrfSpecFeature>(feature), group);
 			break;
 		}
 
@@ -5601,6 +5694,8 @@ static void NewSpriteGroup(ByteReader &buf)
 				group->groups.push_back(GetGroupFromGroupID(setid, type, buf.ReadWord()));
 			}
 
+			/* The random bits only matter for callbacks when one of the choices can yield a callback result. */
+			if (std::ranges::all_of(group->groups, AlwaysFailsCallback)) group->stability = VarStability::Consist;
 			break;
 		}
 
@@ -5688,6 +5783,10 @@ static void NewSpriteGroup(ByteReader &buf)
 						group->loading.push_back(t);
 					}
 
+					/* The loading state only matters for callbacks when one of the sets is a callback result. */
+					if (std::ranges::all_of(group->loaded, AlwaysFailsCallback) && std::ranges::all_of(group->loading, AlwaysFailsCallback)) {
+						group->stability = VarStability::Consist;
+					}
 					break;
 				}
 
@@ -1159,6 +1159,99 @@ bool UsesWagonOverride(const Vehicle *v)
 	return Train::From(v)->tcache.cached_override != nullptr;
 }
 
+/**
+ * Get how long the value of a vehicle variable of the self scope stays the same.
+ * Values that are cached in #NewGRFCache are invalidated together with the callback cache, and thus consist stable.
+ * @param variable The variable to check.
+ * @return Stability of the variable's value.
+ */
+VarStability GetVehicleVariableStability(uint8_t variable)
+{
+	switch (variable) {
+		case 0x25: // Engine GRF ID
+		case 0x40: // Length of consist
+		case 0x41: // Length of same consecutive wagons
+		case 0x42: // Consist cargo information
+		case 0x43: // Company information
+		case 0x47: // Vehicle cargo info
+		case 0x49: // 'Long' format build year
+		case 0x4D: // Position within articulated vehicle
+		case 0x7A: // Badges of the engine
+		case 0xB9: // Cargo type
+		case 0xC6: // Engine local ID
+		case 0xC7: // Engine local ID, high byte
+		case 0xF2: // Cargo subtype
+			return VarStability::Consist;
+
+		default:
+			return VarStability::Volatile;
+	}
+}
+
+static uint _unstable_vehicle_callbacks = 0; ///< Number of vehicle callbacks resolved so far whose result can change while the consist stays the same.
+
+/**
+ * Get the number of vehicle callbacks resolved so far whose result can change while the consist stays the same.
+ * When the number did not change while computing something, the result only depends on the consist.
+ * @return The number of callbacks.
+ */
+uint GetUnstableVehicleCallbackCount()
+{
+	return _unstable_vehicle_callbacks;
+}
+
+/**
+ * Evaluate a newgrf callback for vehicles, using the callback cache of the vehicle when the result only depends on stable variables.
+ * @param object Resolver object for the callback.
+ * @param v The vehicle the callback is resolved for.
+ * @return The value the callback returned, or CALLBACK_FAILED if it failed.
+ */
+static uint16_t ResolveCachedVehicleCallback(VehicleResolverObject &object, const Vehicle *v)
+{
+	VarStability stability = object.root_spritegroup->stability;
+	if (stability != VarStability::Consist) _unstable_vehicle_callbacks++;
+	if (stability == VarStability::Volatile) return object.ResolveCallback();
+
+	NewGRFCallbackCache &cache = v->grf_callback_cache;
+	NewGRFCallbackCache::Entry key;
+	key.callback = object.callback;
+	key.engine = object.self_scope.self_type;
+	key.param1 = object.callback_param1;
+	key.param2 = object.callback_param2;
+	key.cargo_type = v->cargo_type;
+	key.cargo_subtype = v->cargo_subtype;
+	key.date_dependent = stability == VarStability::Tick;
+	if (key.date_dependent) {
+		key.date = TimerGameCalendar::date;
+		key.date_fract = TimerGameCalendar::date_fract;
+	}
+
+	for (const NewGRFCallbackCache::Entry &entry : cache.entries) {
+		if (entry.callback != key.callback || entry.engine != key.engine || entry.param1 != key.param1 || entry.param2 != key.param2) continue;
+		if (entry.cargo_type != key.cargo_type || entry.cargo_subtype != key.cargo_subtype || entry.date_dependent != key.date_dependent) continue;
+		if (entry.date_dependent && (entry.date != key.date || entry.date_fract != key.date_fract)) continue;
+
+		if (_debug_desync_level >= 2) {
+			uint16_t result = object.ResolveCallback();
+			if (result != entry.result || HasChangedRegisters()) {
+				Debug(desync, 2, "warning: newgrf callback cache mismatch: vehicle {}, engine {}, callback 0x{:X}, cached {}, resolved {}",
+						v->index, key.engine, key.callback, entry.result, result);
+			}
+		}
+		/* Only results that did not write registers are cached, so leave the registers as that resolve would have. */
+		ClearRegisters();
+		return entry.result;
+	}
+
+	key.result = object.ResolveCallback();
+	/* Callers can read registers after the callback, e.g. for spawning visual effects or for text parameters. These are not cached. */
+	if (HasChangedRegisters()) return key.result;
+
+	cache.entries[cache.next_entry] = key;
+	cache.next_entry = (cache.next_entry + 1) % NewGRFCallbackCache::NUM_ENTRIES;
+	return key.result;
+}
+
 /**
  * Evaluate a newgrf callback for vehicles
  * @param callback The callback to evaluate
@@ -1171,7 +1264,12 @@ bool UsesWagonOverride(const Vehicle *v)
 uint16_t GetVehicleCallback(CallbackID callback, uint32_t param1, uint32_t param2, EngineID engine, const Vehicle *v)
 {
 	VehicleResolverObject object(engine, v, VehicleResolverObject::WO_UNCACHED, false, callback, param1, param2);
-	return object.ResolveCallback();
+	if (object.root_spritegroup == nullptr) return object.ResolveCallback();
+	if (v == nullptr) {
+		_unstable_vehicle_callbacks++;
+		return object.ResolveCallback();
+	}
+	return ResolveCachedVehicleCallback(object, v);
 }
 
 /**
@@ -1188,6 +1286,7 @@ uint16_t GetVehicleCallbackParent(CallbackID callback, uint32_t param1, uint32_t
 {
 	VehicleResolverObject object(engine, v, VehicleResolverObject::WO_NONE, false, callback, param1, param2);
 	object.parent_scope.SetVehicle(parent);
+	_unstable_vehicle_callbacks++;
 	return object.ResolveCallback();
 }
 
@@ -96,7 +96,9 @@ void SetEngineGRF(EngineID engine, const struct GRFFile *file);
 
 uint16_t GetVehicleCallback(CallbackID callback, uint32_t param1, uint32_t param2, EngineID engine, const Vehicle *v);
 uint16_t GetVehicleCallbackParent(CallbackID callback, uint32_t param1, uint32_t param2, EngineID engine, const Vehicle *v, const Vehicle *parent);
+uint GetUnstableVehicleCallbackCount();
 bool UsesWagonOverride(const Vehicle *v);
+VarStability GetVehicleVariableStability(uint8_t variable);
 
 /* Handler to Evaluate callback 36. If the callback fails (i.e. most of the
  * time) orig_value is returned */
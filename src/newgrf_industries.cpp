@@ -601,24 +601,63 @@ static int32_t DerefIndProd(int field, bool use_register)
 	return use_register ? (int32_t)GetRegister(field) : field;
 }
 
+/** Cargo waiting at an industry, to undo a speculative production callback. */
+struct IndustryWaitingCargo {
+	std::array<uint16_t, INDUSTRY_NUM_INPUTS> accepted{}; ///< Waiting cargo of each accepted cargo slot.
+	std::array<uint16_t, INDUSTRY_NUM_OUTPUTS> produced{}; ///< Waiting cargo of each produced cargo slot.
+
+	/**
+	 * Remember the waiting cargo of an industry.
+	 * @param ind The industry.
+	 */
+	explicit IndustryWaitingCargo(const Industry *ind)
+	{
+		for (size_t i = 0; i < ind->accepted.size(); i++) this->accepted[i] = ind->accepted[i].waiting;
+		for (size_t i = 0; i < ind->produced.size(); i++) this->produced[i] = ind->produced[i].waiting;
+	}
+
+	/**
+	 * Put back the remembered waiting cargo of an industry.
+	 * @param ind The industry.
+	 */
+	void Restore(Industry *ind) const
+	{
+		for (size_t i = 0; i < ind->accepted.size(); i++) ind->accepted[i].waiting = this->accepted[i];
+		for (size_t i = 0; i < ind->produced.size(); i++) ind->produced[i].waiting = this->produced[i];
+	}
+};
+
 /**
  * Get the industry production callback and apply it to the industry.
- * @param ind    the industry this callback has to be called for
+ * @param ind the industry this callback has to be called for
  * @param reason the reason it is called (0 = incoming cargo, 1 = periodic tick callback)
+ * @param random_bits the random bits (var 10) for industries that want them
+ * @param speculative whether the callback may only change the waiting cargo of the industry
+ * @return false if \a speculative and the callback wanted to do more, in which case the waiting cargo is left unchanged
  */
-void IndustryProductionCallback(Industry *ind, int reason)
+static bool RunIndustryProductionCallback(Industry *ind, int reason, uint32_t random_bits, bool speculative)
 {
 	const IndustrySpec *spec = GetIndustrySpec(ind->type);
 	IndustriesResolverObject object(ind->location.tile, ind, ind->type);
-	if (spec->behaviour.Test(IndustryBehaviour::ProdCallbackRandom)) object.callback_param1 = Random();
+	if (spec->behaviour.Test(IndustryBehaviour::ProdCallbackRandom)) object.callback_param1 = random_bits;
 	int multiplier = 1;
 	if (spec->behaviour.Test(IndustryBehaviour::ProdMultiHandling)) multiplier = ind->prod_level;
 	object.callback_param2 = reason;
+	object.speculative = speculative;
+
+	std::optional<IndustryWaitingCargo> undo;
+	if (speculative) undo.emplace(ind);
 
 	for (uint loop = 0;; loop++) {
 		/* limit the number of calls to break infinite loops.
 		 * 'loop' is provided as 16 bits to the newgrf, so abort when those are exceeded. */
 		if (loop >= 0x10000) {
+			/* Error messages can only be shown from the game loop itself. */
+			if (speculative) {
+				undo->Restore(ind);
+				return false;
+			}
+
 			/* display error message */
 			ShowErrorMessage(GetEncodedString(STR_NEWGRF_BUGGY, spec->grf_prop.grffile->filename),
 				GetEncodedString(STR_NEWGRF_BUGGY_ENDLESS_PRODUCTION_CALLBACK, std::monostate{}, spec->name),
@@ -630,10 +669,22 @@ void IndustryProductionCallback(Industry *ind, int reason)
 
 		SB(object.callback_param2, 8, 16, loop);
 		const SpriteGroup *tgroup = object.Resolve();
+
+		/* Changes to persistent storage can affect other industries, so they have to be made in order. */
+		if (object.blocked_store) {
+			undo->Restore(ind);
+			return false;
+		}
+
 		if (tgroup == nullptr || tgroup->type != SGT_INDUSTRY_PRODUCTION) break;
 		const IndustryProductionSpriteGroup *group = (const IndustryProductionSpriteGroup *)tgroup;
 
 		if (group->version == 0xFF) {
+			if (speculative) {
+				undo->Restore(ind);
+				return false;
+			}
+
 			/* Result was marked invalid on load, display error message */
 			ShowErrorMessage(GetEncodedString(STR_NEWGRF_BUGGY, spec->grf_prop.grffile->filename),
 				GetEncodedString(STR_NEWGRF_BUGGY_INVALID_CARGO_PRODUCTION_CALLBACK, std::monostate{}, spec->name, ind->location.tile),
@@ -675,9 +726,46 @@ void IndustryProductionCallback(Industry *ind, int reason)
 		SB(object.callback_param2, 24, 8, again);
 	}
 
-	SetWindowDirty(WC_INDUSTRY_VIEW, ind->index);
+	if (!speculative) SetWindowDirty(WC_INDUSTRY_VIEW, ind->index);
+	return true;
+}
+
+/**
+ * Get the industry production callback and apply it to the industry.
+ * @param ind    the industry this callback has to be called for
+ * @param reason the reason it is called (0 = incoming cargo, 1 = periodic tick callback)
+ */
+void IndustryProductionCallback(Industry *ind, int reason)
+{
+	uint32_t random_bits = GetIndustrySpec(ind->type)->behaviour.Test(IndustryBehaviour::ProdCallbackRandom) ? Random() : 0;
+	RunIndustryProductionCallback(ind, reason, random_bits, false);
+}
+
+/**
+ * Get the industry production callback and apply it to the industry, with random bits that have been drawn before.
+ * @param ind         the industry this callback has to be called for
+ * @param reason      the reason it is called (0 = incoming cargo, 1 = periodic tick callback)
+ * @param random_bits the random bits (var 10) for industries that want them
+ */
+void IndustryProductionCallback(Industry *ind, int reason, uint32_t random_bits)
+{
+	RunIndustryProductionCallback(ind, reason, random_bits, false);
+}
+
+/**
+ * Try to get the periodic industry production callback and apply it to the industry, without any other side effects.
+ * This only changes the waiting cargo of the industry, and only reads the game state. So it can run for several
+ * industries in parallel, as long as nothing else changes the game state meanwhile.
+ * @param ind the industry this callback has to be called for
+ * @param random_bits the random bits (var 10) for industries that want them
+ * @return false if the callback has to be called with #IndustryProductionCallback instead, as it has side effects
+ */
+bool SpeculativeIndustryProductionCallback(Industry *ind, uint32_t random_bits)
+{
+	return RunIndustryProductionCallback(ind, 1, random_bits, true);
 }
 
+
 /**
  * Check whether an industry temporarily refuses to accept a certain cargo.
  * @param ind The industry to query.
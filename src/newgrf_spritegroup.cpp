@@ -18,7 +18,8 @@
 SpriteGroupPool _spritegroup_pool("SpriteGroup");
 INSTANTIATE_POOL_METHODS(SpriteGroup)
 
-TemporaryStorageArray<int32_t, 0x110> _temp_store;
+/** The registers of the NewGRF, per thread so callbacks can be resolved in parallel. */
+thread_local TemporaryStorageArray<int32_t, 0x110> _temp_store;
 
 
 /**
@@ -168,7 +169,13 @@ static U EvalAdjustT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver
 		case DSGA_OP_XOR:  return last_value ^ value;
 		case DSGA_OP_STO:  _temp_store.StoreValue((U)value, (S)last_value); return last_value;
 		case DSGA_OP_RST:  return value;
-		case DSGA_OP_STOP: scope->StorePSA((U)value, (S)last_value); return last_value;
+		case DSGA_OP_STOP:
+			if (scope->ro.speculative) {
+				scope->ro.blocked_store = true;
+			} else {
+				scope->StorePSA((U)value, (S)last_value);
+			}
+			return last_value;
 		case DSGA_OP_ROR:  return std::rotr<uint32_t>((U)last_value, (U)value & 0x1F); // mask 'value' to 5 bits, which should behave the same on all architectures.
 		case DSGA_OP_SCMP: return ((S)last_value == (S)value) ? 1 : ((S)last_value < (S)value ? 0 : 2);
 		case DSGA_OP_UCMP: return ((U)last_value == (U)value) ? 1 : ((U)last_value < (U)value ? 0 : 2);
@@ -185,14 +192,67 @@ static bool RangeHighComparator(const DeterministicSpriteGroupRange &range, uint
 	return range.high < value;
 }
 
-const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) const
+/** Maximum number of entries in the direct range lookup table of a DeterministicSpriteGroup. */
+static constexpr uint32_t MAX_RANGE_TABLE_SIZE = 256;
+
+/**
+ * Precompute data to speed up resolving this group. Must be called once the adjusts and ranges are final.
+ *
+ * Leading adjusts that only read the constant variable 0x1A and have no side effects are folded into
+ * #initial_value, so they do not need to be evaluated every time the group is resolved.
+ * When the ranges span only a small interval of values, a direct lookup table of the resolved groups is
+ * built, which replaces the linear or binary search over the ranges.
+ */
+void DeterministicSpriteGroup::Optimise()
 {
-	uint32_t last_value = 0;
-	uint32_t value = 0;
+	this->first_adjust = 0;
+	this->initial_value = 0;
+	for (const auto &adjust : this->adjusts) {
+		/* Variable 0x1A is always -1; anything else can change at runtime. */
+		if (adjust.variable != 0x1A) break;
+		if (adjust.operation == DSGA_OP_STO || adjust.operation == DSGA_OP_STOP) break;
 
-	ScopeResolver *scope = object.GetScope(this->var_scope);
+		uint32_t value = UINT32_MAX;
+		switch (this->size) {
+			case DSG_SIZE_BYTE:  value = EvalAdjustT<uint8_t,  int8_t> (adjust, nullptr, this->initial_value, value); break;
+			case DSG_SIZE_WORD:  value = EvalAdjustT<uint16_t, int16_t>(adjust, nullptr, this->initial_value, value); break;
+			case DSG_SIZE_DWORD: value = EvalAdjustT<uint32_t, int32_t>(adjust, nullptr, this->initial_value, value); break;
+			default: NOT_REACHED();
+		}
+		this->initial_value = value;
+		this->first_adjust++;
+	}
+
+	this->range_table.clear();
+	if (this->calculated_result || this->ranges.size() < 2) return;
+
+	uint32_t low = this->ranges.front().low;
+	uint32_t high = this->ranges.back().high;
+	if (high - low >= MAX_RANGE_TABLE_SIZE) return;
+
+	this->range_table_base = low;
+	this->range_table.resize(high - low + 1, this->default_group);
+	for (const auto &range : this->ranges) {
+		std::fill(this->range_table.begin() + (range.low - low), this->range_table.begin() + (range.high - low + 1), range.group);
+	}
+}
+
+/**
+ * Evaluate the runtime part of the adjust chain.
+ * @tparam U Unsigned type of the variable size of this group.
+ * @tparam S Signed type of the variable size of this group.
+ * @param object Resolver object.
+ * @param scope Scope the variables are read from.
+ * @param[in,out] last_value Accumulated value of the chain.
+ * @return false if a variable was not available, and the error group should be used.
+ */
+template <typename U, typename S>
+bool DeterministicSpriteGroup::EvaluateAdjusts(ResolverObject &object, ScopeResolver *scope, uint32_t &last_value) const
+{
+	for (auto it = this->adjusts.begin() + this->first_adjust; it != this->adjusts.end(); ++it) {
+		const DeterministicSpriteGroupAdjust &adjust = *it;
+		uint32_t value;
 
-	for (const auto &adjust : this->adjusts) {
 		/* Try to get the variable. We shall assume it is available, unless told otherwise. */
 		bool available = true;
 		if (adjust.variable == 0x7E) {
@@ -210,22 +270,35 @@ const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) con
 			value = GetVariable(object, scope, adjust.variable, adjust.parameter, available);
 		}
 
-		if (!available) {
-			/* Unsupported variable: skip further processing and return either
-			 * the group from the first range or the default group. */
-			return SpriteGroup::Resolve(this->error_group, object, false);
-		}
+		if (!available) return false;
 
-		switch (this->size) {
-			case DSG_SIZE_BYTE:  value = EvalAdjustT<uint8_t,  int8_t> (adjust, scope, last_value, value); break;
-			case DSG_SIZE_WORD:  value = EvalAdjustT<uint16_t, int16_t>(adjust, scope, last_value, value); break;
-			case DSG_SIZE_DWORD: value = EvalAdjustT<uint32_t, int32_t>(adjust, scope, last_value, value); break;
-			default: NOT_REACHED();
-		}
-		last_value = value;
+		last_value = EvalAdjustT<U, S>(adjust, scope, last_value, value);
+	}
+
+	return true;
+}
+
+const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) const
+{
+	uint32_t value = this->initial_value;
+
+	ScopeResolver *scope = object.GetScope(this->var_scope);
+
+	bool available;
+	switch (this->size) {
+		case DSG_SIZE_BYTE:  available = this->EvaluateAdjusts<uint8_t,  int8_t> (object, scope, value); break;
+		case DSG_SIZE_WORD:  available = this->EvaluateAdjusts<uint16_t, int16_t>(object, scope, value); break;
+		case DSG_SIZE_DWORD: available = this->EvaluateAdjusts<uint32_t, int32_t>(object, scope, value); break;
+		default: NOT_REACHED();
+	}
+
+	if (!available) {
+		/* Unsupported variable: skip further processing and return either
+		 * the group from the first range or the default group. */
+		return SpriteGroup::Resolve(this->error_group, object, false);
 	}
 
-	object.last_value = last_value;
+	object.last_value = value;
 
 	if (this->calculated_result) {
 		/* nvar == 0 is a special case -- we turn our value into a callback result */
@@ -235,7 +308,11 @@ const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) con
 		return &nvarzero;
 	}
 
-	if (this->ranges.size() > 4) {
+	if (!this->range_table.empty()) {
+		/* Values below the base wrap around, and thus fall outside the table as well. */
+		uint32_t index = value - this->range_table_base;
+		if (index < this->range_table.size()) return SpriteGroup::Resolve(this->range_table[index], object, false);
+	} else if (this->ranges.size() > 4) {
 		const auto &lower = std::lower_bound(this->ranges.begin(), this->ranges.end(), value, RangeHighComparator);
 		if (lower != this->ranges.end() && lower->low <= value) {
 			assert(lower->low <= value && value <= lower->high);
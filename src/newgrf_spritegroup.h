@@ -28,10 +28,29 @@
  */
 inline uint32_t GetRegister(uint i)
 {
-	extern TemporaryStorageArray<int32_t, 0x110> _temp_store;
+	extern thread_local TemporaryStorageArray<int32_t, 0x110> _temp_store;
 	return _temp_store.GetValue(i);
 }
 
+/**
+ * Forget the values of all newgrf "registers", as happens at the start of resolving a sprite group.
+ */
+inline void ClearRegisters()
+{
+	extern thread_local TemporaryStorageArray<int32_t, 0x110> _temp_store;
+	_temp_store.ClearChanges();
+}
+
+/**
+ * Check whether any newgrf "register" has been written to since they were last cleared.
+ * @return True iff a register has been written to.
+ */
+inline bool HasChangedRegisters()
+{
+	extern thread_local TemporaryStorageArray<int32_t, 0x110> _temp_store;
+	return _temp_store.HasChanges();
+}
+
 /* List of different sprite group types */
 enum SpriteGroupType : uint8_t {
 	SGT_REAL,
@@ -43,8 +62,19 @@ enum SpriteGroupType : uint8_t {
 	SGT_INDUSTRY_PRODUCTION,
 };
 
+/**
+ * How long the value of a variable, or the result of resolving a sprite group, stays the same.
+ * Ordered from most to least stable, so the stability of a combination is the maximum of its parts.
+ */
+enum class VarStability : uint8_t {
+	Consist,  ///< Only changes when the consist changes or is refitted, i.e. when the NewGRF cache of the object is invalidated.
+	Tick,     ///< Only changes when the calendar date (including its fraction) advances, so at most once per tick.
+	Volatile, ///< May change at any time, or has side effects like writing to storage.
+};
+
 struct SpriteGroup;
 struct ResolverObject;
+struct ScopeResolver;
 
 /* SPRITE_WIDTH is 24. ECS has roughly 30 sprite groups per real sprite.
  * Adding an 'extra' margin would be assuming 64 sprite groups per real
@@ -65,6 +95,7 @@ public:
 
 	uint32_t nfo_line = 0;
 	SpriteGroupType type{};
+	VarStability stability = VarStability::Volatile; ///< How long the result of resolving this group stays the same.
 
 	virtual SpriteID GetResult() const { return 0; }
 	virtual uint8_t GetNumResults() const { return 0; }
@@ -178,8 +209,20 @@ struct DeterministicSpriteGroup : SpriteGroup {
 
 	const SpriteGroup *error_group = nullptr; // was first range, before sorting ranges
 
+	/* Precomputed at load time by Optimise(), to speed up resolving. */
+	uint first_adjust = 0; ///< Index of the first adjust that needs to be evaluated at runtime; the ones before it are constant.
+	uint32_t initial_value = 0; ///< Value of 'last_value' after evaluating the constant adjusts before #first_adjust.
+	uint32_t range_table_base = 0; ///< Value that maps to the first entry of #range_table.
+	std::vector<const SpriteGroup *> range_table{}; ///< Direct lookup of the resolved group for values starting at #range_table_base, if the ranges are dense enough.
+
+	void Optimise();
+
 protected:
 	const SpriteGroup *Resolve(ResolverObject &object) const override;
+
+private:
+	template <typename U, typename S>
+	bool EvaluateAdjusts(ResolverObject &object, ScopeResolver *scope, uint32_t &last_value) const;
 };
 
 enum RandomizedSpriteGroupCompareMode : uint8_t {
@@ -212,7 +255,10 @@ struct CallbackResultSpriteGroup : SpriteGroup {
 	 * Creates a spritegroup representing a callback result
 	 * @param value The value that was used to represent this callback result
 	 */
-	explicit CallbackResultSpriteGroup(uint16_t value) : SpriteGroup(SGT_CALLBACK), result(value) {}
+	explicit CallbackResultSpriteGroup(uint16_t value) : SpriteGroup(SGT_CALLBACK), result(value)
+	{
+		this->stability = VarStability::Consist;
+	}
 
 	uint16_t result = 0;
 	uint16_t GetCallbackResult() const override { return this->result; }
@@ -233,6 +279,7 @@ struct ResultSpriteGroup : SpriteGroup {
 		num_sprites(num_sprites),
 		sprite(sprite)
 	{
+		this->stability = VarStability::Consist;
 	}
 
 	uint8_t num_sprites = 0;
@@ -317,6 +364,9 @@ struct ResolverObject {
 
 	uint32_t last_value = 0; ///< Result of most recent DeterministicSpriteGroup (including procedure calls)
 
+	bool speculative = false; ///< Whether the result may be discarded, so persistent storage must not be changed.
+	bool blocked_store = false; ///< Whether persistent storage would have been changed, if it was not #speculative.
+
 	uint32_t waiting_triggers = 0; ///< Waiting triggers to be used by any rerandomisation. (scope independent)
 	uint32_t used_triggers = 0; ///< Subset of cur_triggers, which actually triggered some rerandomisation. (scope independent)
 	std::array<uint32_t, VSG_END> reseed; ///< Collects bits to rerandomise while triggering triggers.
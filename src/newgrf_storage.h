@@ -136,6 +136,7 @@ struct TemporaryStorageArray {
 	StorageType storage{}; ///< Memory for the storage array
 	StorageInitType init{}; ///< Storage has been assigned, if this equals 'init_key'.
 	uint16_t init_key = 1; ///< Magic key to 'init'.
+	bool changed = false; ///< Whether anything has been stored since the last call to ClearChanges.
 
 	/**
 	 * Stores some value at a given position.
@@ -149,6 +150,7 @@ struct TemporaryStorageArray {
 
 		this->storage[pos] = value;
 		this->init[pos] = this->init_key;
+		this->changed = true;
 	}
 
 	/**
@@ -169,8 +171,18 @@ struct TemporaryStorageArray {
 		return this->storage[pos];
 	}
 
+	/**
+	 * Check whether anything has been stored since the last call to ClearChanges.
+	 * @return True iff a value has been stored.
+	 */
+	bool HasChanges() const
+	{
+		return this->changed;
+	}
+
 	void ClearChanges()
 	{
+		this->changed = false;
 		/* Increment init_key to invalidate all storage */
 		this->init_key++;
 		if (this->init_key == 0) {
@@ -692,7 +692,7 @@ struct TextRefStack {
 
 	TextRefStack(const GRFFile *grffile, uint8_t num_entries) : grffile(grffile)
 	{
-		extern TemporaryStorageArray<int32_t, 0x110> _temp_store;
+		extern thread_local TemporaryStorageArray<int32_t, 0x110> _temp_store;
 
 		assert(num_entries < sizeof(uint32_t) * std::size(stack));
 
@@ -125,6 +125,7 @@ void BuildObject(ObjectType type, TileIndex tile, CompanyID owner, Town *town, u
 		}
 		bool remove = IsDockingTile(t);
 		MakeObject(t, owner, o->index, wc, Random());
+		AddTileAcceptanceToStations(t);
 		if (remove) RemoveDockingTile(t);
 		MarkTileDirtyByTile(t);
 	}
@@ -166,9 +167,17 @@ void UpdateCompanyHQ(TileIndex tile, uint score)
 	if (score >= 520) val++;
 	if (score >= 720) val++;
 
+	if (GetCompanyHQSize(tile) >= val) return;
+
+	/* The acceptance of the HQ grows with its size. */
+	TileArea ta = Object::GetByTile(tile)->location;
+	for (TileIndex t : ta) RemoveTileAcceptanceFromStations(t);
+
 	while (GetCompanyHQSize(tile) < val) {
 		IncreaseCompanyHQSize(tile);
 	}
+
+	for (TileIndex t : ta) AddTileAcceptanceToStations(t);
 }
 
 /**
@@ -510,6 +519,7 @@ static void ReallyClearObjectTile(Object *o)
 	for (TileIndex tile_cur : o->location) {
 		DeleteNewGRFInspectWindow(GSF_OBJECTS, tile_cur.base());
 
+		RemoveTileAcceptanceFromStations(tile_cur);
 		MakeWaterKeepingClass(tile_cur, GetTileOwner(tile_cur));
 	}
 	delete o;
@@ -66,6 +66,8 @@
 #include "viewport_func.h"
 #include "viewport_sprite_sorter.h"
 #include "framerate_type.h"
+#include "tick_profiling.h"
+#include "desync_replay.h"
 #include "industry.h"
 #include "network/network_gui.h"
 #include "network/network_survey.h"
@@ -1221,25 +1223,26 @@ void StateGameLoop()
 
 		if (!HasModalProgress()) UpdateLandscapingLimits();
 #ifndef DEBUG_DUMP_COMMANDS
-		Game::GameLoop();
+		if (!_desync_replay_running) Game::GameLoop();
 #endif
 		return;
 	}
 
 	PerformanceMeasurer framerate(PFE_GAMELOOP);
 	PerformanceAccumulator::Reset(PFE_GL_LANDSCAPE);
+	TickProfiler::BeginTick();
 
 	Layouter::ReduceLineCache();
 
 	if (_game_mode == GM_EDITOR) {
 		BasePersistentStorageArray::SwitchMode(PSM_ENTER_GAMELOOP);
 		RunTileLoop();
-		CallVehicleTicks();
-		CallLandscapeTick();
+		{ TickProfilerZone zone("CallVehicleTicks"); CallVehicleTicks(); }
+		{ TickProfilerZone zone("CallLandscapeTick"); CallLandscapeTick(); }
 		BasePersistentStorageArray::SwitchMode(PSM_LEAVE_GAMELOOP);
 		UpdateLandscapingLimits();
 
-		CallWindowGameTickEvent();
+		{ TickProfilerZone zone("CallWindowGameTickEvent"); CallWindowGameTickEvent(); }
 		NewsLoop();
 	} else {
 		if (_debug_desync_level > 2 && TimerGameEconomy::date_fract == 0 && (TimerGameEconomy::date.base() & 0x1F) == 0) {
@@ -1248,38 +1251,44 @@ void StateGameLoop()
 			SaveOrLoad(name, SLO_SAVE, DFT_GAME_FILE, AUTOSAVE_DIR, false);
 		}
 
-		CheckCaches();
+		{ TickProfilerZone zone("CheckCaches"); CheckCaches(); }
 
 		/* All these actions has to be done from OWNER_NONE
 		 *  for multiplayer compatibility */
 		Backup<CompanyID> cur_company(_current_company, OWNER_NONE);
 
 		BasePersistentStorageArray::SwitchMode(PSM_ENTER_GAMELOOP);
-		AnimateAnimatedTiles();
-		if (TimerManager<TimerGameCalendar>::Elapsed(1)) {
-			RunVehicleCalendarDayProc();
+		{ TickProfilerZone zone("AnimateAnimatedTiles"); AnimateAnimatedTiles(); }
+		{
+			TickProfilerZone zone("TimerGameCalendar");
+			if (TimerManager<TimerGameCalendar>::Elapsed(1)) {
+				RunVehicleCalendarDayProc();
+			}
 		}
-		TimerManager<TimerGameEconomy>::Elapsed(1);
-		TimerManager<TimerGameTick>::Elapsed(1);
+		{ TickProfilerZone zone("TimerGameEconomy"); TimerManager<TimerGameEconomy>::Elapsed(1); }
+		{ TickProfilerZone zone("TimerGameTick"); TimerManager<TimerGameTick>::Elapsed(1); }
 		RunTileLoop();
-		CallVehicleTicks();
-		CallLandscapeTick();
+		{ TickProfilerZone zone("CallVehicleTicks"); CallVehicleTicks(); }
+		{ TickProfilerZone zone("CallLandscapeTick"); CallLandscapeTick(); }
 		BasePersistentStorageArray::SwitchMode(PSM_LEAVE_GAMELOOP);
 
 #ifndef DEBUG_DUMP_COMMANDS
-		{
+		if (!_desync_replay_running) {
 			PerformanceMeasurer script_framerate(PFE_ALLSCRIPTS);
+			TickProfilerZone zone("Scripts");
 			AI::GameLoop();
 			Game::GameLoop();
 		}
 #endif
 		UpdateLandscapingLimits();
 
-		CallWindowGameTickEvent();
+		{ TickProfilerZone zone("CallWindowGameTickEvent"); CallWindowGameTickEvent(); }
 		NewsLoop();
 		cur_company.Restore();
 	}
 
+	TickProfiler::EndTick();
+
 	assert(IsLocalCompany());
 }
 
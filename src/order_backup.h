@@ -15,6 +15,7 @@
 #include "tile_type.h"
 #include "vehicle_type.h"
 #include "base_consist.h"
+#include "order_base.h"
 #include "saveload/saveload.h"
 
 /** Unique identifier for an order backup. */
@@ -34,12 +35,13 @@ struct OrderBackup : OrderBackupPool::PoolItem<&_order_backup_pool>, BaseConsist
 private:
 	friend SaveLoadTable GetOrderBackupDescription(); ///< Saving and loading of order backups.
 	friend struct BKORChunkHandler; ///< Creating empty orders upon savegame loading.
+	friend class SlOrderBackupOrders; ///< Saving and loading of the orders of order backups.
 	uint32_t user = 0; ///< The user that requested the backup.
 	TileIndex tile = INVALID_TILE; ///< Tile of the depot where the order was changed.
 	GroupID group = GroupID::Invalid(); ///< The group the vehicle was part of.
 
 	const Vehicle *clone = nullptr; ///< Vehicle this vehicle was a clone of.
-	Order *orders = nullptr; ///< The actual orders if the vehicle was not a clone.
+	std::vector<Order> orders; ///< The actual orders if the vehicle was not a clone.
 
 	/** Creation for savegame restoration. */
 	OrderBackup() {}
@@ -48,7 +50,11 @@ private:
 	void DoRestore(Vehicle *v);
 
 public:
-	~OrderBackup();
+	/**
+	 * Get the backed up orders, e.g. to convert them when loading an old savegame.
+	 * @return The orders; empty when the vehicle was a clone.
+	 */
+	std::vector<Order> &GetOrders() { return this->orders; }
 
 	static void Backup(const Vehicle *v, uint32_t user);
 	static void Restore(Vehicle *v, uint32_t user);
@@ -20,20 +20,17 @@
 #include "timer/timer_game_tick.h"
 #include "saveload/saveload.h"
 
-using OrderPool = Pool<Order, OrderID, 256>;
 using OrderListPool = Pool<OrderList, OrderListID, 128>;
-extern OrderPool _order_pool;
 extern OrderListPool _orderlist_pool;
 
 template <typename, typename>
 class EndianBufferWriter;
 
-/* If you change this, keep in mind that it is saved on 3 places:
- * - Load_ORDR, all the global orders
+/* If you change this, keep in mind that it is saved on 2 places:
+ * - the orders of OrderList and OrderBackup
  * - Vehicle -> current_order
- * - REF_ORDER (all REFs are currently limited to 16 bits!!)
  */
-struct Order : OrderPool::PoolItem<&_order_pool> {
+struct Order {
 private:
 	friend struct VEHSChunkHandler;                             ///< Loading of ancient vehicles.
 	friend SaveLoadTable GetOrderDescription();                 ///< Saving and loading of orders.
@@ -56,11 +53,8 @@ private:
 	uint16_t max_speed = UINT16_MAX; ///< How fast the vehicle may go on the way to the destination.
 
 public:
-	Order *next = nullptr; ///< Pointer to next order. If nullptr, end of list
-
 	Order() {}
 	Order(uint8_t type, uint8_t flags, DestinationID dest) : type(type), flags(flags), dest(dest) {}
-	~Order();
 
 	/**
 	 * Check whether this order is of the given type.
@@ -248,58 +242,129 @@ public:
 	void ConvertFromOldSavegame();
 };
 
-void InsertOrder(Vehicle *v, Order *new_o, VehicleOrderID sel_ord);
+void InsertOrder(Vehicle *v, Order &&new_o, VehicleOrderID sel_ord);
 void DeleteOrder(Vehicle *v, VehicleOrderID sel_ord);
 
+/** Kinds of destinations of orders, for looking up the order lists with orders to a destination. */
+enum class OrderDestinationKind : uint8_t {
+	Station, ///< Station or waypoint of a go to station, go to waypoint or implicit order.
+	Depot,   ///< Depot, or for aircraft the station with the hangar, of a go to depot order.
+};
+
+/** Order lists with orders to a destination, by index, with the number of those orders in each list. */
+using OrderListsWithDestination = std::map<OrderListID, uint16_t>;
+
+const OrderListsWithDestination &GetOrderListsWithDestination(OrderDestinationKind kind, DestinationID destination);
+void RebuildOrderDestinationIndex();
+void CheckOrderDestinationIndex();
+
 /**
- * Shared order list linking together the linked list of orders and the list
+ * Shared order list linking together the orders and the list
  *  of vehicles sharing this order list.
  */
 struct OrderList : OrderListPool::PoolItem<&_orderlist_pool> {
 private:
 	friend void AfterLoadVehiclesPhase1(bool part_of_load); ///< For instantiating the shared vehicle chain
 	friend SaveLoadTable GetOrderListDescription(); ///< Saving and loading of order lists.
+	friend class SlOrderListOrders; ///< Saving and loading of the orders of order lists.
+	friend struct ORDLChunkHandler; ///< Loading of the orders of order lists from old savegames.
 
-	VehicleOrderID num_orders = INVALID_VEH_ORDER_ID; ///< NOSAVE: How many orders there are in the list.
 	VehicleOrderID num_manual_orders = 0; ///< NOSAVE: How many manually added orders are there in the list.
 	uint num_vehicles = 0; ///< NOSAVE: Number of vehicles that share this order list.
 	Vehicle *first_shared = nullptr; ///< NOSAVE: pointer to the first vehicle in the shared order chain.
-	Order *first = nullptr; ///< First order of the order list.
+	std::vector<Order> orders; ///< Orders of the order list, stored contiguously so they can be accessed by index.
 
 	TimerGameTick::Ticks timetable_duration{}; ///< NOSAVE: Total timetabled duration of the order list.
 	TimerGameTick::Ticks total_duration{}; ///< NOSAVE: Total (timetabled or not) duration of the order list.
 
 public:
-	/** Default constructor producing an invalid order list. */
-	OrderList(VehicleOrderID num_orders = INVALID_VEH_ORDER_ID) : num_orders(num_orders) { }
+	/** Default constructor producing an empty order list, to be initialised later. */
+	OrderList() { }
 
 	/**
-	 * Create an order list with the given order chain for the given vehicle.
-	 *  @param chain pointer to the first order of the order chain
+	 * Create an order list with the given orders for the given vehicle.
+	 *  @param orders the orders of the order list
 	 *  @param v any vehicle using this orderlist
 	 */
-	OrderList(Order *chain, Vehicle *v) { this->Initialize(chain, v); }
+	OrderList(std::vector<Order> &&orders, Vehicle *v) : orders(std::move(orders)) { this->Initialize(v); }
 
 	/** Destructor. Invalidates OrderList for re-usage by the pool. */
-	~OrderList() {}
+	~OrderList();
 
-	void Initialize(Order *chain, Vehicle *v);
+	void Initialize(Vehicle *v);
 
 	void RecalculateTimetableDuration();
 
 	/**
-	 * Get the first order of the order chain.
-	 * @return the first order of the chain.
+	 * Get all orders of the order list.
+	 * The orders are only valid until orders are inserted into or deleted from the list.
+	 * @return the orders.
+	 */
+	inline std::span<Order> GetOrders() { return this->orders; }
+
+	/**
+	 * Get all orders of the order list.
+	 * The orders are only valid until orders are inserted into or deleted from the list.
+	 * @return the orders.
 	 */
-	inline Order *GetFirstOrder() const { return this->first; }
+	inline std::span<const Order> GetOrders() const { return this->orders; }
 
-	Order *GetOrderAt(int index) const;
+	/**
+	 * Get the first order of the order list.
+	 * @return the first order of the list, or nullptr if there are no orders.
+	 */
+	inline Order *GetFirstOrder() { return this->GetOrderAt(0); }
+
+	/**
+	 * Get the first order of the order list.
+	 * @return the first order of the list, or nullptr if there are no orders.
+	 */
+	inline const Order *GetFirstOrder() const { return this->GetOrderAt(0); }
 
 	/**
-	 * Get the last order of the order chain.
-	 * @return the last order of the chain.
+	 * Get a certain order of the order list.
+	 * @param index zero-based index of the order within the list.
+	 * @return the order at position index, or nullptr if there is no such order.
 	 */
-	inline Order *GetLastOrder() const { return this->GetOrderAt(this->num_orders - 1); }
+	inline Order *GetOrderAt(int index)
+	{
+		if (index < 0 || static_cast<size_t>(index) >= this->orders.size()) return nullptr;
+		return &this->orders[index];
+	}
+
+	/**
+	 * Get a certain order of the order list.
+	 * @param index zero-based index of the order within the list.
+	 * @return the order at position index, or nullptr if there is no such order.
+	 */
+	inline const Order *GetOrderAt(int index) const
+	{
+		if (index < 0 || static_cast<size_t>(index) >= this->orders.size()) return nullptr;
+		return &this->orders[index];
+	}
+
+	/**
+	 * Get the last order of the order list.
+	 * @return the last order of the list, or nullptr if there are no orders.
+	 */
+	inline Order *GetLastOrder() { return this->GetOrderAt(this->GetNumOrders() - 1); }
+
+	/**
+	 * Get the last order of the order list.
+	 * @return the last order of the list, or nullptr if there are no orders.
+	 */
+	inline const Order *GetLastOrder() const { return this->GetOrderAt(this->GetNumOrders() - 1); }
+
+	/**
+	 * Get the position of an order in the order list.
+	 * @param order the order, which must be part of this order list.
+	 * @return the zero-based index of the order.
+	 */
+	inline VehicleOrderID GetIndexOfOrder(const Order *order) const
+	{
+		assert(order >= this->orders.data() && order < this->orders.data() + this->orders.size());
+		return static_cast<VehicleOrderID>(order - this->orders.data());
+	}
 
 	/**
 	 * Get the order after the given one or the first one, if the given one is the
@@ -307,13 +372,13 @@ public:
 	 * @param curr Order to find the next one for.
 	 * @return Next order.
 	 */
-	inline const Order *GetNext(const Order *curr) const { return (curr->next == nullptr) ? this->GetFirstOrder() : curr->next; }
+	inline const Order *GetNext(const Order *curr) const { return (curr + 1 == this->orders.data() + this->orders.size()) ? this->GetFirstOrder() : curr + 1; }
 
 	/**
 	 * Get number of orders in the order list.
-	 * @return number of orders in the chain.
+	 * @return number of orders in the list.
 	 */
-	inline VehicleOrderID GetNumOrders() const { return this->num_orders; }
+	inline VehicleOrderID GetNumOrders() const { return static_cast<VehicleOrderID>(this->orders.size()); }
 
 	/**
 	 * Get number of manually added orders in the order list.
@@ -324,7 +389,7 @@ public:
 	StationIDStack GetNextStoppingStation(const Vehicle *v, const Order *first = nullptr, uint hops = 0) const;
 	const Order *GetNextDecisionNode(const Order *next, uint hops) const;
 
-	void InsertOrderAt(Order *new_order, int index);
+	void InsertOrderAt(Order &&new_order, int index);
 	void DeleteOrderAt(int index);
 	void MoveOrder(int from, int to);
 
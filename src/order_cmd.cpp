@@ -38,20 +38,19 @@
 static_assert(sizeof(DestinationID) >= sizeof(DepotID));
 static_assert(sizeof(DestinationID) >= sizeof(StationID));
 
-OrderPool _order_pool("Order");
-INSTANTIATE_POOL_METHODS(Order)
 OrderListPool _orderlist_pool("OrderList");
 INSTANTIATE_POOL_METHODS(OrderList)
 
-/** Clean everything up. */
-Order::~Order()
+/**
+ * Invalidate the station list when an order to a station that is not owned by anyone is added or removed.
+ * We can visit oil rigs and buoys that are not our own. They will be shown in
+ * the list of stations. So, we need to invalidate that window if needed.
+ * @param order The order that is added or removed.
+ */
+static void InvalidateStationListForOrder(const Order &order)
 {
-	if (CleaningPool()) return;
-
-	/* We can visit oil rigs and buoys that are not our own. They will be shown in
-	 * the list of stations. So, we need to invalidate that window if needed. */
-	if (this->IsType(OT_GOTO_STATION) || this->IsType(OT_GOTO_WAYPOINT)) {
-		BaseStation *bs = BaseStation::GetIfValid(this->GetDestination().ToStationID());
+	if (order.IsType(OT_GOTO_STATION) || order.IsType(OT_GOTO_WAYPOINT)) {
+		BaseStation *bs = BaseStation::GetIfValid(order.GetDestination().ToStationID());
 		if (bs != nullptr && bs->owner == OWNER_NONE) InvalidateWindowClassesData(WC_STATION_LIST, 0);
 	}
 }
@@ -65,7 +64,6 @@ void Order::Free()
 	this->type  = OT_NOTHING;
 	this->flags = 0;
 	this->dest  = 0;
-	this->next  = nullptr;
 }
 
 /**
@@ -240,7 +238,7 @@ void InvalidateVehicleOrder(const Vehicle *v, int data)
  *
  * Assign data to an order (from another order)
  *   This function makes sure that the index is maintained correctly
- * @param other the data to copy (except next pointer).
+ * @param other the data to copy.
  *
  */
 void Order::AssignOrder(const Order &other)
@@ -256,25 +254,133 @@ void Order::AssignOrder(const Order &other)
 	this->max_speed   = other.max_speed;
 }
 
+/** NOSAVE: The order lists with orders to each destination. Kept up to date by the changes to order lists. */
+static std::unordered_map<uint32_t, OrderListsWithDestination> _order_destination_index;
+
+/**
+ * Get the key of a destination in the order destination index.
+ * @param kind The kind of destination.
+ * @param destination The destination.
+ * @return The key.
+ */
+static uint32_t GetOrderDestinationKey(OrderDestinationKind kind, DestinationID destination)
+{
+	return to_underlying(kind) << 16 | destination.base();
+}
+
+/**
+ * Get the key of the destination of an order in the order destination index.
+ * @param order The order.
+ * @return The key, or std::nullopt when the order has no destination.
+ */
+static std::optional<uint32_t> GetOrderDestinationKey(const Order *order)
+{
+	switch (order->GetType()) {
+		case OT_GOTO_STATION:
+		case OT_GOTO_WAYPOINT:
+		case OT_IMPLICIT:
+			return GetOrderDestinationKey(OrderDestinationKind::Station, order->GetDestination());
+
+		case OT_GOTO_DEPOT:
+			return GetOrderDestinationKey(OrderDestinationKind::Depot, order->GetDestination());
+
+		default:
+			return std::nullopt;
+	}
+}
+
+/**
+ * Add an order of an order list to the order destination index.
+ * @param list The order list.
+ * @param order The order.
+ */
+static void AddToOrderDestinationIndex(OrderListID list, const Order *order)
+{
+	std::optional<uint32_t> key = GetOrderDestinationKey(order);
+	if (key.has_value()) _order_destination_index[*key][list]++;
+}
+
+/**
+ * Remove an order of an order list from the order destination index.
+ * @param list The order list.
+ * @param order The order.
+ */
+static void RemoveFromOrderDestinationIndex(OrderListID list, const Order *order)
+{
+	std::optional<uint32_t> key = GetOrderDestinationKey(order);
+	if (!key.has_value()) return;
+
+	auto destination = _order_destination_index.find(*key);
+	assert(destination != _order_destination_index.end());
+	auto it = destination->second.find(list);
+	assert(it != destination->second.end());
+	if (--it->second == 0) {
+		destination->second.erase(it);
+		if (destination->second.empty()) _order_destination_index.erase(destination);
+	}
+}
+
+/**
+ * Get the order lists that have orders to a destination.
+ * The result is only valid until orders are changed.
+ * @param kind The kind of destination.
+ * @param destination The destination.
+ * @return The order lists, in the order of their index.
+ */
+const OrderListsWithDestination &GetOrderListsWithDestination(OrderDestinationKind kind, DestinationID destination)
+{
+	static const OrderListsWithDestination empty{};
+
+	auto it = _order_destination_index.find(GetOrderDestinationKey(kind, destination));
+	return it == _order_destination_index.end() ? empty : it->second;
+}
+
+/** Rebuild the order destination index from all order lists, e.g. after orders have been converted while loading a game. */
+void RebuildOrderDestinationIndex()
+{
+	_order_destination_index.clear();
+	for (const OrderList *list : OrderList::Iterate()) {
+		for (const Order &o : list->GetOrders()) AddToOrderDestinationIndex(list->index, &o);
+	}
+}
+
+/** Check whether the order destination index still matches the orders. */
+void CheckOrderDestinationIndex()
+{
+	auto index = std::move(_order_destination_index);
+	RebuildOrderDestinationIndex();
+	if (index != _order_destination_index) Debug(desync, 2, "warning: order destination index mismatch");
+}
+
+OrderList::~OrderList()
+{
+	if (CleaningPool()) {
+		_order_destination_index.clear();
+		return;
+	}
+
+	for (const Order &o : this->orders) {
+		RemoveFromOrderDestinationIndex(this->index, &o);
+		InvalidateStationListForOrder(o);
+	}
+}
+
 /**
  * Recomputes everything.
- * @param chain first order in the chain
  * @param v one of vehicle that is using this orderlist
  */
-void OrderList::Initialize(Order *chain, Vehicle *v)
+void OrderList::Initialize(Vehicle *v)
 {
-	this->first = chain;
 	this->first_shared = v;
 
-	this->num_orders = 0;
 	this->num_manual_orders = 0;
 	this->num_vehicles = 1;
 	this->timetable_duration = 0;
 
-	for (Order *o = this->first; o != nullptr; o = o->next) {
-		++this->num_orders;
-		if (!o->IsType(OT_IMPLICIT)) ++this->num_manual_orders;
-		this->total_duration += o->GetWaitTime() + o->GetTravelTime();
+	for (const Order &o : this->orders) {
+		if (!o.IsType(OT_IMPLICIT)) ++this->num_manual_orders;
+		this->total_duration += o.GetWaitTime() + o.GetTravelTime();
+		AddToOrderDestinationIndex(this->index, &o);
 	}
 
 	this->RecalculateTimetableDuration();
@@ -294,27 +400,24 @@ void OrderList::Initialize(Order *chain, Vehicle *v)
 void OrderList::RecalculateTimetableDuration()
 {
 	this->timetable_duration = 0;
-	for (Order *o = this->first; o != nullptr; o = o->next) {
-		this->timetable_duration += o->GetTimetabledWait() + o->GetTimetabledTravel();
+	for (const Order &o : this->orders) {
+		this->timetable_duration += o.GetTimetabledWait() + o.GetTimetabledTravel();
 	}
 }
 
 /**
- * Free a complete order chain.
+ * Free all orders of the order list.
  * @param keep_orderlist If this is true only delete the orders, otherwise also delete the OrderList.
  * @note do not use on "current_order" vehicle orders!
  */
 void OrderList::FreeChain(bool keep_orderlist)
 {
-	Order *next;
-	for (Order *o = this->first; o != nullptr; o = next) {
-		next = o->next;
-		delete o;
-	}
-
 	if (keep_orderlist) {
-		this->first = nullptr;
-		this->num_orders = 0;
+		for (const Order &o : this->orders) {
+			RemoveFromOrderDestinationIndex(this->index, &o);
+			InvalidateStationListForOrder(o);
+		}
+		this->orders.clear();
 		this->num_manual_orders = 0;
 		this->timetable_duration = 0;
 	} else {
@@ -322,23 +425,6 @@ void OrderList::FreeChain(bool keep_orderlist)
 	}
 }
 
-/**
- * Get a certain order of the order chain.
- * @param index zero-based index of the order within the chain.
- * @return the order at position index.
- */
-Order *OrderList::GetOrderAt(int index) const
-{
-	if (index < 0) return nullptr;
-
-	Order *order = this->first;
-
-	while (order != nullptr && index-- > 0) {
-		order = order->next;
-	}
-	return order;
-}
-
 /**
  * Get the next order which will make the given vehicle stop at a station
  * or refit at a depot or evaluate a non-trivial condition.
@@ -438,41 +524,21 @@ StationIDStack OrderList::GetNextStoppingStation(const Vehicle *v, const Order *
 }
 
 /**
- * Insert a new order into the order chain.
- * @param new_order is the order to insert into the chain.
+ * Insert a new order into the order list.
+ * @param new_order is the order to insert into the list.
  * @param index is the position where the order is supposed to be inserted.
  */
-void OrderList::InsertOrderAt(Order *new_order, int index)
+void OrderList::InsertOrderAt(Order &&new_order, int index)
 {
-	if (this->first == nullptr) {
-		this->first = new_order;
-	} else {
-		if (index == 0) {
-			/* Insert as first or only order */
-			new_order->next = this->first;
-			this->first = new_order;
-		} else if (index >= this->num_orders) {
-			/* index is after the last order, add it to the end */
-			this->GetLastOrder()->next = new_order;
-		} else {
-			/* Put the new order in between */
-			Order *order = this->GetOrderAt(index - 1);
-			new_order->next = order->next;
-			order->next = new_order;
-		}
-	}
-	++this->num_orders;
-	if (!new_order->IsType(OT_IMPLICIT)) ++this->num_manual_orders;
-	this->timetable_duration += new_order->GetTimetabledWait() + new_order->GetTimetabledTravel();
-	this->total_duration += new_order->GetWaitTime() + new_order->GetTravelTime();
-
-	/* We can visit oil rigs and buoys that are not our own. They will be shown in
-	 * the list of stations. So, we need to invalidate that window if needed. */
-	if (new_order->IsType(OT_GOTO_STATION) || new_order->IsType(OT_GOTO_WAYPOINT)) {
-		BaseStation *bs = BaseStation::Get(new_order->GetDestination().ToStationID());
-		if (bs->owner == OWNER_NONE) InvalidateWindowClassesData(WC_STATION_LIST, 0);
-	}
+	index = std::min<int>(index, this->GetNumOrders());
+	const Order &order = *this->orders.insert(this->orders.begin() + index, std::move(new_order));
+
+	if (!order.IsType(OT_IMPLICIT)) ++this->num_manual_orders;
+	AddToOrderDestinationIndex(this->index, &order);
+	this->timetable_duration += order.GetTimetabledWait() + order.GetTimetabledTravel();
+	this->total_duration += order.GetWaitTime() + order.GetTravelTime();
 
+	InvalidateStationListForOrder(order);
 }
 
 
@@ -482,23 +548,15 @@ void OrderList::InsertOrderAt(Order *new_order, int index)
  */
 void OrderList::DeleteOrderAt(int index)
 {
-	if (index >= this->num_orders) return;
-
-	Order *to_remove;
+	if (index >= this->GetNumOrders()) return;
 
-	if (index == 0) {
-		to_remove = this->first;
-		this->first = to_remove->next;
-	} else {
-		Order *prev = GetOrderAt(index - 1);
-		to_remove = prev->next;
-		prev->next = to_remove->next;
-	}
-	--this->num_orders;
+	auto to_remove = this->orders.begin() + index;
 	if (!to_remove->IsType(OT_IMPLICIT)) --this->num_manual_orders;
+	RemoveFromOrderDestinationIndex(this->index, &*to_remove);
 	this->timetable_duration -= (to_remove->GetTimetabledWait() + to_remove->GetTimetabledTravel());
 	this->total_duration -= (to_remove->GetWaitTime() + to_remove->GetTravelTime());
-	delete to_remove;
+	InvalidateStationListForOrder(*to_remove);
+	this->orders.erase(to_remove);
 }
 
 /**
@@ -508,28 +566,12 @@ void OrderList::DeleteOrderAt(int index)
  */
 void OrderList::MoveOrder(int from, int to)
 {
-	if (from >= this->num_orders || to >= this->num_orders || from == to) return;
-
-	Order *moving_one;
-
-	/* Take the moving order out of the pointer-chain */
-	if (from == 0) {
-		moving_one = this->first;
-		this->first = moving_one->next;
-	} else {
-		Order *one_before = GetOrderAt(from - 1);
-		moving_one = one_before->next;
-		one_before->next = moving_one->next;
-	}
+	if (from >= this->GetNumOrders() || to >= this->GetNumOrders() || from == to) return;
 
-	/* Insert the moving_order again in the pointer-chain */
-	if (to == 0) {
-		moving_one->next = this->first;
-		this->first = moving_one;
+	if (from < to) {
+		std::rotate(this->orders.begin() + from, this->orders.begin() + from + 1, this->orders.begin() + to + 1);
 	} else {
-		Order *one_before = GetOrderAt(to - 1);
-		moving_one->next = one_before->next;
-		one_before->next = moving_one;
+		std::rotate(this->orders.begin() + to, this->orders.begin() + from, this->orders.begin() + from + 1);
 	}
 }
 
@@ -550,10 +592,10 @@ void OrderList::RemoveVehicle(Vehicle *v)
  */
 bool OrderList::IsCompleteTimetable() const
 {
-	for (Order *o = this->first; o != nullptr; o = o->next) {
+	for (const Order &o : this->orders) {
 		/* Implicit orders are, by definition, not timetabled. */
-		if (o->IsType(OT_IMPLICIT)) continue;
-		if (!o->IsCompletelyTimetabled()) return false;
+		if (o.IsType(OT_IMPLICIT)) continue;
+		if (!o.IsCompletelyTimetabled()) return false;
 	}
 	return true;
 }
@@ -564,7 +606,6 @@ bool OrderList::IsCompleteTimetable() const
  */
 void OrderList::DebugCheckSanity() const
 {
-	VehicleOrderID check_num_orders = 0;
 	VehicleOrderID check_num_manual_orders = 0;
 	uint check_num_vehicles = 0;
 	TimerGameTick::Ticks check_timetable_duration = 0;
@@ -572,13 +613,12 @@ void OrderList::DebugCheckSanity() const
 
 	Debug(misc, 6, "Checking OrderList {} for sanity...", this->index);
 
-	for (const Order *o = this->first; o != nullptr; o = o->next) {
-		++check_num_orders;
-		if (!o->IsType(OT_IMPLICIT)) ++check_num_manual_orders;
-		check_timetable_duration += o->GetTimetabledWait() + o->GetTimetabledTravel();
-		check_total_duration += o->GetWaitTime() + o->GetTravelTime();
+	assert(this->orders.size() <= MAX_VEH_ORDER_ID);
+	for (const Order &o : this->orders) {
+		if (!o.IsType(OT_IMPLICIT)) ++check_num_manual_orders;
+		check_timetable_duration += o.GetTimetabledWait() + o.GetTimetabledTravel();
+		check_total_duration += o.GetWaitTime() + o.GetTravelTime();
 	}
-	assert(this->num_orders == check_num_orders);
 	assert(this->num_manual_orders == check_num_manual_orders);
 	assert(this->timetable_duration == check_timetable_duration);
 	assert(this->total_duration == check_total_duration);
@@ -589,7 +629,7 @@ void OrderList::DebugCheckSanity() const
 	}
 	assert(this->num_vehicles == check_num_vehicles);
 	Debug(misc, 6, "... detected {} orders ({} manual), {} vehicles, {} timetabled, {} total",
-			(uint)this->num_orders, (uint)this->num_manual_orders,
+			(uint)this->GetNumOrders(), (uint)this->num_manual_orders,
 			this->num_vehicles, this->timetable_duration, this->total_duration);
 }
 #endif
@@ -659,7 +699,7 @@ uint GetOrderDistance(const Order *prev, const Order *cur, const Vehicle *v, int
 		conditional_depth++;
 
 		int dist1 = GetOrderDistance(prev, v->GetOrder(cur->GetConditionSkipToOrder()), v, conditional_depth);
-		int dist2 = GetOrderDistance(prev, cur->next == nullptr ? v->orders->GetFirstOrder() : cur->next, v, conditional_depth);
+		int dist2 = GetOrderDistance(prev, v->orders->GetNext(cur), v, conditional_depth);
 		return std::max(dist1, dist2);
 	}
 
@@ -876,13 +916,12 @@ CommandCost CmdInsertOrder(DoCommandFlags flags, VehicleID veh, VehicleOrderID s
 	if (sel_ord > v->GetNumOrders()) return CMD_ERROR;
 
 	if (v->GetNumOrders() >= MAX_VEH_ORDER_ID) return CommandCost(STR_ERROR_TOO_MANY_ORDERS);
-	if (!Order::CanAllocateItem()) return CommandCost(STR_ERROR_NO_MORE_SPACE_FOR_ORDERS);
 	if (v->orders == nullptr && !OrderList::CanAllocateItem()) return CommandCost(STR_ERROR_NO_MORE_SPACE_FOR_ORDERS);
 
 	if (flags.Test(DoCommandFlag::Execute)) {
-		Order *new_o = new Order();
-		new_o->AssignOrder(new_order);
-		InsertOrder(v, new_o, sel_ord);
+		Order new_o;
+		new_o.AssignOrder(new_order);
+		InsertOrder(v, std::move(new_o), sel_ord);
 	}
 
 	return CommandCost();
@@ -894,13 +933,13 @@ CommandCost CmdInsertOrder(DoCommandFlags flags, VehicleID veh, VehicleOrderID s
  * @param new_o   The new order.
  * @param sel_ord The position the order should be inserted at.
  */
-void InsertOrder(Vehicle *v, Order *new_o, VehicleOrderID sel_ord)
+void InsertOrder(Vehicle *v, Order &&new_o, VehicleOrderID sel_ord)
 {
 	/* Create new order and link in list */
 	if (v->orders == nullptr) {
-		v->orders = new OrderList(new_o, v);
+		v->orders = new OrderList({new_o}, v);
 	} else {
-		v->orders->InsertOrderAt(new_o, sel_ord);
+		v->orders->InsertOrderAt(std::move(new_o), sel_ord);
 	}
 
 	Vehicle *u = v->FirstShared();
@@ -1471,22 +1510,21 @@ CommandCost CmdModifyOrder(DoCommandFlags flags, VehicleID veh, VehicleOrderID s
  * Check if an aircraft has enough range for an order list.
  * @param v_new Aircraft to check.
  * @param v_order Vehicle currently holding the order list.
- * @param first First order in the source order list.
  * @return True if the aircraft has enough range for the orders, false otherwise.
  */
-static bool CheckAircraftOrderDistance(const Aircraft *v_new, const Vehicle *v_order, const Order *first)
+static bool CheckAircraftOrderDistance(const Aircraft *v_new, const Vehicle *v_order)
 {
-	if (first == nullptr || v_new->acache.cached_max_range == 0) return true;
+	if (v_order->orders == nullptr || v_new->acache.cached_max_range == 0) return true;
 
 	/* Iterate over all orders to check the distance between all
 	 * 'goto' orders and their respective next order (of any type). */
-	for (const Order *o = first; o != nullptr; o = o->next) {
+	for (const Order *o : v_order->Orders()) {
 		switch (o->GetType()) {
 			case OT_GOTO_STATION:
 			case OT_GOTO_DEPOT:
 			case OT_GOTO_WAYPOINT:
 				/* If we don't have a next order, we've reached the end and must check the first order instead. */
-				if (GetOrderDistance(o, o->next != nullptr ? o->next : first, v_order) > v_new->acache.cached_max_range_sqr) return false;
+				if (GetOrderDistance(o, v_order->orders->GetNext(o), v_order) > v_new->acache.cached_max_range_sqr) return false;
 				break;
 
 			default: break;
@@ -1543,7 +1581,7 @@ CommandCost CmdCloneOrder(DoCommandFlags flags, CloneOptions action, VehicleID v
 			}
 
 			/* Check for aircraft range limits. */
-			if (dst->type == VEH_AIRCRAFT && !CheckAircraftOrderDistance(Aircraft::From(dst), src, src->GetFirstOrder())) {
+			if (dst->type == VEH_AIRCRAFT && !CheckAircraftOrderDistance(Aircraft::From(dst), src)) {
 				return CommandCost(STR_ERROR_AIRCRAFT_NOT_ENOUGH_RANGE);
 			}
 
@@ -1590,38 +1628,32 @@ CommandCost CmdCloneOrder(DoCommandFlags flags, CloneOptions action, VehicleID v
 			}
 
 			/* Check for aircraft range limits. */
-			if (dst->type == VEH_AIRCRAFT && !CheckAircraftOrderDistance(Aircraft::From(dst), src, src->GetFirstOrder())) {
+			if (dst->type == VEH_AIRCRAFT && !CheckAircraftOrderDistance(Aircraft::From(dst), src)) {
 				return CommandCost(STR_ERROR_AIRCRAFT_NOT_ENOUGH_RANGE);
 			}
 
-			/* make sure there are orders available */
-			if (!Order::CanAllocateItem(src->GetNumOrders()) || !OrderList::CanAllocateItem()) {
+			/* make sure there is an order list available */
+			if (!OrderList::CanAllocateItem()) {
 				return CommandCost(STR_ERROR_NO_MORE_SPACE_FOR_ORDERS);
 			}
 
 			if (flags.Test(DoCommandFlag::Execute)) {
-				Order *first = nullptr;
-				Order **order_dst;
-
-				/* If the destination vehicle had an order list, destroy the chain but keep the OrderList.
+				/* If the destination vehicle had an order list, destroy the orders but keep the OrderList.
 				 * We only reset the order indices, if the new orders are obviously different.
 				 * (We mainly do this to keep the order indices valid and in range.) */
 				DeleteVehicleOrders(dst, true, dst->GetNumOrders() != src->GetNumOrders());
 
-				order_dst = &first;
-				for (const Order *order : src->Orders()) {
-					*order_dst = new Order();
-					(*order_dst)->AssignOrder(*order);
-					order_dst = &(*order_dst)->next;
-				}
+				std::vector<Order> orders;
+				if (src->orders != nullptr) orders.assign(src->orders->GetOrders().begin(), src->orders->GetOrders().end());
+
 				if (dst->orders == nullptr) {
-					dst->orders = new OrderList(first, dst);
+					dst->orders = new OrderList(std::move(orders), dst);
 				} else {
 					assert(dst->orders->GetFirstOrder() == nullptr);
 					assert(!dst->orders->IsShared());
 					delete dst->orders;
 					assert(OrderList::CanAllocateItem());
-					dst->orders = new OrderList(first, dst);
+					dst->orders = new OrderList(std::move(orders), dst);
 				}
 
 				InvalidateVehicleOrder(dst, VIWD_REMOVE_ALL_ORDERS);
@@ -1774,6 +1806,18 @@ void RemoveOrderFromAllVehicles(OrderType type, DestinationID destination, bool
 	 * This fact is handled specially below
 	 */
 
+	/* Only the order lists with orders to the destination need to be searched. Copy them, as removing orders changes the index. */
+	std::set<OrderListID> lists;
+	auto add_lists = [&lists, destination](OrderDestinationKind kind) {
+		for (const auto &[list, count] : GetOrderListsWithDestination(kind, destination)) lists.insert(list);
+	};
+	if (type == OT_GOTO_DEPOT) {
+		add_lists(OrderDestinationKind::Depot);
+	} else {
+		add_lists(OrderDestinationKind::Station);
+		if (type == OT_GOTO_STATION && !hangar) add_lists(OrderDestinationKind::Depot);
+	}
+
 	/* Go through all vehicles */
 	for (Vehicle *v : Vehicle::Iterate()) {
 		if ((v->type == VEH_AIRCRAFT && v->current_order.IsType(OT_GOTO_DEPOT) && !hangar ? OT_GOTO_STATION : v->current_order.GetType()) == type &&
@@ -1782,12 +1826,11 @@ void RemoveOrderFromAllVehicles(OrderType type, DestinationID destination, bool
 			SetWindowDirty(WC_VEHICLE_VIEW, v->index);
 		}
 
-		/* Clear the order from the order-list */
-		int id = -1;
-		for (Order *order : v->Orders()) {
-			id++;
-restart:
+		if (v->orders == nullptr || !lists.contains(v->orders->index)) continue;
 
+		/* Clear the order from the order-list */
+		for (int id = 0; id < v->GetNumOrders(); id++) {
+			Order *order = v->GetOrder(id);
 			OrderType ot = order->GetType();
 			if (ot == OT_GOTO_DEPOT && (order->GetDepotActionType() & ODATFB_NEAREST_DEPOT) != 0) continue;
 			if (ot == OT_GOTO_DEPOT && hangar && v->type != VEH_AIRCRAFT) continue; // Not an aircraft? Can't have a hangar order.
@@ -1797,10 +1840,9 @@ restart:
 				 * dummy orders. They should just vanish. Also check the actual order
 				 * type as ot is currently OT_GOTO_STATION. */
 				if (order->IsType(OT_IMPLICIT)) {
-					order = order->next; // DeleteOrder() invalidates current order
 					DeleteOrder(v, id);
-					if (order != nullptr) goto restart;
-					break;
+					id--;
+					continue;
 				}
 
 				/* Clear wait time */
@@ -1813,6 +1855,7 @@ restart:
 
 				/* Clear order, preserving travel time */
 				bool travel_timetabled = order->IsTravelTimetabled();
+				RemoveFromOrderDestinationIndex(v->orders->index, order);
 				order->MakeDummy();
 				order->SetTravelTimetabled(travel_timetabled);
 
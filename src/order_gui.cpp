@@ -352,7 +352,7 @@ void DrawOrderString(const Vehicle *v, const Order *order, int order_index, int
 
 	/* Check range for aircraft. */
 	if (v->type == VEH_AIRCRAFT && Aircraft::From(v)->GetRange() > 0 && order->IsGotoOrder()) {
-		const Order *next = order->next != nullptr ? order->next : v->GetFirstOrder();
+		const Order *next = v->orders->GetNext(order);
 		if (GetOrderDistance(order, next, v) > Aircraft::From(v)->acache.cached_max_range_sqr) {
 			line += GetString(STR_ORDER_OUT_OF_RANGE);
 		}
@@ -369,9 +369,7 @@ void DrawOrderString(const Vehicle *v, const Order *order, int order_index, int
  */
 static Order GetOrderCmdFromTile(const Vehicle *v, TileIndex tile)
 {
-	/* Override the index as it is not coming from a pool, so would not be initialised correctly. */
 	Order order;
-	order.index = OrderID::Begin();
 
 	/* check depot first */
 	if (IsDepotTypeTile(tile, (TransportType)(uint)v->type) && IsTileOwner(tile, _local_company)) {
@@ -655,8 +653,6 @@ private:
 	void OrderClick_NearestDepot()
 	{
 		Order order;
-		order.next = nullptr;
-		order.index = OrderID::Begin();
 		order.MakeGoToDepot(DepotID::Invalid(), ODTFB_PART_OF_ORDERS,
 				_settings_client.gui.new_nonstop && this->vehicle->IsGroundVehicle() ? ONSF_NO_STOP_AT_INTERMEDIATE_STATIONS : ONSF_STOP_EVERYWHERE);
 		order.SetDepotActionType(ODATFB_NEAREST_DEPOT);
@@ -1130,7 +1126,7 @@ public:
 				y += line_height;
 
 				i++;
-				order = order->next;
+				order = this->vehicle->GetOrder(i);
 			}
 
 			/* Reset counters for drawing the orders. */
@@ -1148,7 +1144,7 @@ public:
 			y += line_height;
 
 			i++;
-			order = order->next;
+			order = this->vehicle->GetOrder(i);
 		}
 
 		if (this->vscroll->IsVisible(i)) {
@@ -1201,8 +1197,6 @@ public:
 					VehicleOrderID order_id = this->GetOrderFromPt(_cursor.pos.y - this->top);
 					if (order_id != INVALID_VEH_ORDER_ID) {
 						Order order;
-						order.next = nullptr;
-						order.index = OrderID::Begin();
 						order.MakeConditional(order_id);
 
 						Command<CMD_INSERT_ORDER>::Post(STR_ERROR_CAN_T_INSERT_NEW_ORDER, this->vehicle->tile, this->vehicle->index, this->OrderGetSel(), order);
@@ -219,6 +219,9 @@ public:
 
 std::vector<WaterRegionData> _water_region_data;
 std::vector<bool> _is_water_region_valid;
+static uint32_t _water_regions_version = 0; ///< Changed whenever a valid water region is invalidated.
+static uint32_t _water_regions_allocated_version = 0; ///< Version of the water regions when they were allocated.
+static std::vector<uint32_t> _water_region_versions; ///< Version of the water regions when each water region was last invalidated.
 
 static TileIndex GetTileIndexFromLocalCoordinate(int region_x, int region_y, int local_x, int local_y)
 {
@@ -313,6 +316,7 @@ void InvalidateWaterRegion(TileIndex tile)
 	auto invalidate_region = [](TileIndex tile) {
 		const TWaterRegionIndex water_region_index = GetWaterRegionIndex(tile);
 		if (!_is_water_region_valid[water_region_index]) Debug(map, 3, "Invalidated water region ({},{})", GetWaterRegionX(tile), GetWaterRegionY(tile));
+		if (_is_water_region_valid[water_region_index]) _water_region_versions[water_region_index] = ++_water_regions_version;
 		_is_water_region_valid[water_region_index] = false;
 	};
 
@@ -328,6 +332,29 @@ void InvalidateWaterRegion(TileIndex tile)
 	}
 }
 
+/**
+ * Get the version of the water regions. It changes whenever a water region is invalidated
+ * that may have been looked at since it was last invalidated. Anything derived from the water
+ * regions of the same version, like a route over them, is thus still valid.
+ * @return The version.
+ */
+uint32_t GetWaterRegionsVersion()
+{
+	return _water_regions_version;
+}
+
+/**
+ * Get the version of the water regions when a water region was last invalidated. Anything
+ * derived from the water region at a later version, like a route over it, is thus still valid.
+ * @param water_region The water region.
+ * @return The version; for water regions outside of the map, the version when the water regions were allocated.
+ */
+uint32_t GetWaterRegionVersion(const WaterRegionDesc &water_region)
+{
+	if (water_region.x < 0 || water_region.y < 0 || water_region.x >= GetWaterRegionMapSizeX() || water_region.y >= GetWaterRegionMapSizeY()) return _water_regions_allocated_version;
+	return _water_region_versions[GetWaterRegionIndex(water_region)];
+}
+
 /**
  * Calls the provided callback function for all water region patches
  * accessible from one particular side of the starting patch.
@@ -417,6 +444,10 @@ void AllocateWaterRegions()
 	_is_water_region_valid.clear();
 	_is_water_region_valid.resize(number_of_regions, false);
 
+	_water_regions_allocated_version = ++_water_regions_version;
+	_water_region_versions.clear();
+	_water_region_versions.resize(number_of_regions, _water_regions_allocated_version);
+
 	Debug(map, 2, "Allocating {} x {} water regions", GetWaterRegionMapSizeX(), GetWaterRegionMapSizeY());
 	assert(_is_water_region_valid.size() == _water_region_data.size());
 }
@@ -12,20 +12,94 @@
 
 #include "../../tile_type.h"
 #include "../../track_type.h"
+#include "../../road_type.h"
+#include "../../company_type.h"
 #include "nodelist.hpp"
 #include "yapf_node.hpp"
 
+/**
+ * Key for cached segment cost for road YAPF.
+ * Besides where the segment starts, it contains the properties of the
+ * vehicle that change where the segment leads to or what it costs.
+ */
+struct CYapfRoadSegmentKey
+{
+	TileIndex tile; ///< First tile of the segment.
+	Trackdir td; ///< Trackdir on the first tile.
+	Owner owner; ///< Owner of the vehicle, it may only enter depots of its owner.
+	RoadType roadtype; ///< Road type of the vehicle.
+	RoadTypes compatible_roadtypes; ///< Road types the vehicle can drive on.
+	int max_speed; ///< Maximum speed of the vehicle, for the speed limit penalties.
+
+	inline int32_t CalcHash() const
+	{
+		return (this->tile.base() << 4) | this->td;
+	}
+
+	inline bool operator==(const CYapfRoadSegmentKey &other) const = default;
+};
+
+/** A tile of a cached road segment. */
+struct CYapfRoadSegmentTile
+{
+	TileIndex tile; ///< The tile.
+	Trackdir td; ///< Trackdir on the tile.
+	bool road_stop; ///< Whether this is a road stop, whose cost depends on its occupancy and is not included in #cost.
+	int cost; ///< Cost of the segment up to and including this tile.
+
+	inline bool operator==(const CYapfRoadSegmentTile &other) const = default;
+};
+
+/**
+ * Cached segment cost for road YAPF.
+ * The segment runs up to the next junction, dead end or depot. Destinations and the
+ * maximum path cost are applied when a node uses the segment, so it can be shared
+ * by searches for different destinations.
+ */
+struct CYapfRoadSegment
+{
+	typedef CYapfRoadSegmentKey Key;
+
+	CYapfRoadSegmentKey key;
+	std::vector<CYapfRoadSegmentTile> tiles; ///< Tiles of the segment, empty when the segment has not been followed yet.
+	TileIndex last_tile = INVALID_TILE; ///< Tile at the end of the segment.
+	Trackdir last_td = INVALID_TRACKDIR; ///< Trackdir at the end of the segment.
+	int end_cost = 0; ///< Cost of the whole segment, excluding road stops.
+	bool is_loop = false; ///< Whether the segment is a loop without junctions.
+	CYapfRoadSegment *hash_next = nullptr;
+
+	inline CYapfRoadSegment(const CYapfRoadSegmentKey &key) : key(key) {}
+
+	inline const Key &GetKey() const
+	{
+		return this->key;
+	}
+
+	inline CYapfRoadSegment *GetHashNext()
+	{
+		return this->hash_next;
+	}
+
+	inline void SetHashNext(CYapfRoadSegment *next)
+	{
+		this->hash_next = next;
+	}
+};
+
 /** Yapf Node for road YAPF */
 template <class Tkey_>
 struct CYapfRoadNodeT : CYapfNodeT<Tkey_, CYapfRoadNodeT<Tkey_> > {
 	typedef CYapfNodeT<Tkey_, CYapfRoadNodeT<Tkey_> > base;
+	typedef CYapfRoadSegment CachedData;
 
+	CYapfRoadSegment *segment;
 	TileIndex segment_last_tile;
 	Trackdir segment_last_td;
 
 	void Set(CYapfRoadNodeT *parent, TileIndex tile, Trackdir td, bool is_choice)
 	{
 		this->base::Set(parent, tile, td, is_choice);
+		this->segment = nullptr;
 		this->segment_last_tile = tile;
 		this->segment_last_td = td;
 	}
@@ -16,6 +16,7 @@
 #include "yapf_destrail.hpp"
 #include "../../viewport_func.h"
 #include "../../newgrf_station.h"
+#include "../../signal_func.h"
 
 #include "../../safeguards.h"
 
@@ -639,4 +640,6 @@ int CSegmentCostCacheBase::s_rail_change_counter = 0;
 void YapfNotifyTrackLayoutChange(TileIndex tile, Track track)
 {
 	CSegmentCostCacheBase::NotifyTrackLayoutChange(tile, track);
+	/* Signal blocks are explored over the same track layout. */
+	InvalidateSignalBlocks();
 }
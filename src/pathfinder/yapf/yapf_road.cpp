@@ -14,6 +14,14 @@
 
 #include "../../safeguards.h"
 
+/** Incremented whenever the road layout changes, which invalidates the cached road segments. */
+static int _road_layout_change_counter = 0;
+/** Maximum number of road segments to keep in the cache, to bound its memory use. */
+static const size_t MAX_NUMBER_OF_CACHED_ROAD_SEGMENTS = 1 << 16;
+/** Number of times a cached road segment was used since the cache was last flushed. */
+static uint64_t _road_segment_cache_hits = 0;
+/** Number of road segments that had to be followed since the cache was last flushed. */
+static uint64_t _road_segment_cache_misses = 0;
 
 template <class Types>
 class CYapfCostRoadT
@@ -107,32 +115,26 @@ public:
 	}
 
 	/**
-	 * Called by YAPF to calculate the cost from the origin to the given node.
-	 *  Calculates only the cost of given node, adds it to the parent node cost
-	 *  and stores the result into Node::cost member
+	 * Follow a segment from its first tile up to the next junction, dead end or depot, and
+	 * store its tiles with their costs. Destinations, the maximum path cost and the occupancy
+	 * of road stops are not taken into account, so the segment can be cached and shared by
+	 * searches for other destinations.
+	 * @param segment The segment to follow, only its key has to be set.
 	 */
-	inline bool PfCalcCost(Node &n, const TrackFollower *)
+	void CalcSegment(CYapfRoadSegment &segment)
 	{
 		int segment_cost = 0;
 		uint tiles = 0;
-		/* start at n.key.tile / n.key.td and walk to the end of segment */
-		TileIndex tile = n.key.tile;
-		Trackdir trackdir = n.key.td;
-		int parent_cost = (n.parent != nullptr) ? n.parent->cost : 0;
+		/* start at segment.key.tile / segment.key.td and walk to the end of segment */
+		TileIndex tile = segment.key.tile;
+		Trackdir trackdir = segment.key.td;
+		const RoadVehicle *v = Yapf().GetVehicle();
 
 		for (;;) {
-			/* base tile cost depending on distance between edges */
-			segment_cost += Yapf().OneTileCost(tile, trackdir);
-
-			const RoadVehicle *v = Yapf().GetVehicle();
-			/* we have reached the vehicle's destination - segment should end here to avoid target skipping */
-			if (Yapf().PfDetectDestinationTile(tile, trackdir)) break;
-
-			/* Finish if we already exceeded the maximum path cost (i.e. when
-			 * searching for the nearest depot). */
-			if (this->max_cost > 0 && (parent_cost + segment_cost) > this->max_cost) {
-				return false;
-			}
+			/* base tile cost depending on distance between edges, road stops are added when the segment is used */
+			bool road_stop = IsDiagonalTrackdir(trackdir) && IsTileType(tile, MP_STATION) && !IsRoadWaypoint(tile);
+			if (!road_stop) segment_cost += Yapf().OneTileCost(tile, trackdir);
+			segment.tiles.emplace_back(tile, trackdir, road_stop, segment_cost);
 
 			/* stop if we have just entered the depot */
 			if (IsRoadDepotTile(tile) && trackdir == DiagDirToDiagTrackdir(ReverseDiagDir(GetRoadDepotDirection(tile)))) {
@@ -141,7 +143,7 @@ public:
 			}
 
 			/* if there are no reachable trackdirs on new tile, we have end of road */
-			TrackFollower F(Yapf().GetVehicle());
+			TrackFollower F(v);
 			if (!F.Follow(tile, trackdir)) break;
 
 			/* if there are more trackdirs available & reachable, we are at the end of segment */
@@ -150,7 +152,10 @@ public:
 			Trackdir new_td = (Trackdir)FindFirstBit(F.new_td_bits);
 
 			/* stop if RV is on simple loop with no junctions */
-			if (F.new_tile == n.key.tile && new_td == n.key.td) return false;
+			if (F.new_tile == segment.key.tile && new_td == segment.key.td) {
+				segment.is_loop = true;
+				break;
+			}
 
 			/* if we skipped some tunnel tiles, add their cost */
 			segment_cost += F.tiles_skipped * YAPF_TILE_LENGTH;
@@ -161,7 +166,7 @@ public:
 
 			/* add min/max speed penalties */
 			int min_speed = 0;
-			int max_veh_speed = std::min<int>(v->GetDisplayMaxSpeed(), v->current_order.GetMaxSpeed() * 2);
+			int max_veh_speed = segment.key.max_speed;
 			int max_speed = F.GetSpeedLimit(&min_speed);
 			if (max_speed < max_veh_speed) segment_cost += YAPF_TILE_LENGTH * (max_veh_speed - max_speed) * (4 + F.tiles_skipped) / max_veh_speed;
 			if (min_speed > max_veh_speed) segment_cost += YAPF_TILE_LENGTH * (min_speed - max_veh_speed);
@@ -172,16 +177,131 @@ public:
 			if (tiles > MAX_MAP_SIZE) break;
 		}
 
+		/* save end of segment */
+		segment.last_tile = tile;
+		segment.last_td = trackdir;
+		segment.end_cost = segment_cost;
+	}
+
+	/**
+	 * Called by YAPF to calculate the cost from the origin to the given node.
+	 *  Calculates only the cost of given node, adds it to the parent node cost
+	 *  and stores the result into Node::cost member
+	 */
+	inline bool PfCalcCost(Node &n, const TrackFollower *)
+	{
+		CYapfRoadSegment &segment = *n.segment;
+		if (segment.tiles.empty()) {
+			Yapf().CalcSegment(segment);
+			_road_segment_cache_misses++;
+		} else {
+			_road_segment_cache_hits++;
+
+			if (_debug_desync_level >= 2) {
+				CYapfRoadSegment check(segment.key);
+				Yapf().CalcSegment(check);
+				if (check.tiles != segment.tiles || check.last_tile != segment.last_tile || check.last_td != segment.last_td || check.end_cost != segment.end_cost || check.is_loop != segment.is_loop) {
+					Debug(desync, 2, "warning: road segment cache mismatch: tile {}, trackdir {}", segment.key.tile.base(), to_underlying(segment.key.td));
+				}
+			}
+		}
+
+		int parent_cost = (n.parent != nullptr) ? n.parent->cost : 0;
+		int road_stop_cost = 0;
+
+		for (const CYapfRoadSegmentTile &t : segment.tiles) {
+			if (t.road_stop) road_stop_cost += Yapf().OneTileCost(t.tile, t.td);
+			int segment_cost = t.cost + road_stop_cost;
+
+			/* we have reached the vehicle's destination - segment should end here to avoid target skipping */
+			if (Yapf().PfDetectDestinationTile(t.tile, t.td)) {
+				n.segment_last_tile = t.tile;
+				n.segment_last_td = t.td;
+				n.cost = parent_cost + segment_cost;
+				return true;
+			}
+
+			/* Finish if we already exceeded the maximum path cost (i.e. when
+			 * searching for the nearest depot). */
+			if (this->max_cost > 0 && (parent_cost + segment_cost) > this->max_cost) {
+				return false;
+			}
+		}
+
+		if (segment.is_loop) return false;
+
 		/* save end of segment back to the node */
-		n.segment_last_tile = tile;
-		n.segment_last_td = trackdir;
+		n.segment_last_tile = segment.last_tile;
+		n.segment_last_td = segment.last_td;
 
 		/* save also tile cost */
-		n.cost = parent_cost + segment_cost;
+		n.cost = parent_cost + segment.end_cost + road_stop_cost;
 		return true;
 	}
 };
 
+/**
+ * CYapfSegmentCostCacheRoadT - the yapf cost cache provider for road vehicles.
+ *  Segments are cached for all searches, as the parts of their cost that depend
+ *  on the search or the occupancy of road stops are applied when a node uses them.
+ */
+template <class Types>
+class CYapfSegmentCostCacheRoadT {
+public:
+	typedef typename Types::Tpf Tpf; ///< the pathfinder class (derived from THIS class)
+	typedef typename Types::NodeList::Item Node; ///< this will be our node type
+	typedef CSegmentCostCacheT<CYapfRoadSegment> Cache;
+
+protected:
+	Cache &global_cache;
+
+	inline CYapfSegmentCostCacheRoadT() : global_cache(stGetGlobalCache()) {};
+
+	/** to access inherited path finder */
+	inline Tpf &Yapf()
+	{
+		return *static_cast<Tpf *>(this);
+	}
+
+	inline static Cache &stGetGlobalCache()
+	{
+		static int last_road_change_counter = 0;
+		static std::array<uint32_t, 3> last_penalties{};
+		static Cache C;
+
+		/* The cached costs include these penalties, so they have to be flushed when the settings change. */
+		const YAPFSettings &settings = _settings_game.pf.yapf;
+		std::array<uint32_t, 3> penalties = {settings.road_slope_penalty, settings.road_curve_penalty, settings.road_crossing_penalty};
+
+		if (last_road_change_counter != _road_layout_change_counter || last_penalties != penalties || C.heap.size() >= MAX_NUMBER_OF_CACHED_ROAD_SEGMENTS) {
+			Debug(yapf, 2, "Flushing road segment cache: {} segments, {} hits, {} misses", C.heap.size(), _road_segment_cache_hits, _road_segment_cache_misses);
+			_road_segment_cache_hits = 0;
+			_road_segment_cache_misses = 0;
+
+			last_road_change_counter = _road_layout_change_counter;
+			last_penalties = penalties;
+			C.Flush();
+		}
+		return C;
+	}
+
+public:
+	/**
+	 * Called by YAPF to attach cached or local segment cost data to the given node.
+	 *  @return true if globally cached data were used or false if local data was used
+	 */
+	inline bool PfNodeCacheFetch(Node &n)
+	{
+		const RoadVehicle *v = Yapf().GetVehicle();
+		CYapfRoadSegmentKey key{n.GetTile(), n.GetTrackdir(), v->owner, v->roadtype, v->compatible_roadtypes,
+				std::min<int>(v->GetDisplayMaxSpeed(), v->current_order.GetMaxSpeed() * 2)};
+
+		bool found;
+		n.segment = &this->global_cache.Get(key, &found);
+		return found && !n.segment->tiles.empty();
+	}
+};
+
 
 template <class Types>
 class CYapfDestinationAnyDepotRoadT
@@ -515,7 +635,7 @@ struct CYapfRoad_TypesT
 	typedef CYapfFollowRoadT<Types>           PfFollow;
 	typedef CYapfOriginTileT<Types>           PfOrigin;
 	typedef Tdestination<Types>               PfDestination;
-	typedef CYapfSegmentCostCacheNoneT<Types> PfCache;
+	typedef CYapfSegmentCostCacheRoadT<Types> PfCache;
 	typedef CYapfCostRoadT<Types>             PfCost;
 };
 
@@ -535,6 +655,11 @@ Trackdir YapfRoadVehicleChooseTrack(const RoadVehicle *v, TileIndex tile, DiagDi
 	return (td_ret != INVALID_TRACKDIR) ? td_ret : (Trackdir)FindFirstBit(trackdirs);
 }
 
+void YapfNotifyRoadLayoutChange(TileIndex)
+{
+	_road_layout_change_counter++;
+}
+
 FindDepotData YapfRoadVehicleFindNearestDepot(const RoadVehicle *v, int max_distance)
 {
 	TileIndex tile = v->tile;
@@ -19,6 +19,42 @@
 constexpr int DIRECT_NEIGHBOUR_COST = 100;
 constexpr int NODES_PER_REGION = 4;
 constexpr int MAX_NUMBER_OF_NODES = 65536;
+constexpr size_t MAX_NUMBER_OF_CACHED_ROUTES = 4096;
+
+/** Key of a route in the cache of routes over water regions. */
+struct WaterRegionRouteKey {
+	int start; ///< Hash of the water region patch the route starts at.
+	std::vector<int> destinations; ///< Hashes of the water region patches the route may end at, in the order they are given to the pathfinder.
+
+	auto operator<=>(const WaterRegionRouteKey &other) const = default;
+};
+
+/** A route over water regions in the cache, with what is needed to tell whether it is still valid. */
+struct CachedWaterRegionRoute {
+	std::vector<WaterRegionPatchDesc> route; ///< The water region patches from start to destination; empty when there is no route.
+	std::vector<WaterRegionDesc> regions; ///< The water regions the search looked at; a change to any other region cannot change the route.
+	uint32_t version = 0; ///< Version of the water regions when the route was searched.
+};
+
+/**
+ * Routes that have been found over water regions.
+ * Ships sailing the same lanes keep looking for the same routes, which only change when the water regions they were found on change.
+ */
+static std::map<WaterRegionRouteKey, CachedWaterRegionRoute> _water_region_route_cache;
+static uint32_t _water_region_route_cache_version = 0; ///< Version of the water regions when the cache was last checked for changed routes.
+static WaterRegionRouteCacheStatistics _water_region_route_cache_statistics; ///< Number of lookups and hits of the route cache.
+
+/** Remove the cached routes whose search looked at a water region that has changed since. */
+static void RemoveChangedWaterRegionRoutes()
+{
+	if (_water_region_route_cache_version == GetWaterRegionsVersion()) return;
+	_water_region_route_cache_version = GetWaterRegionsVersion();
+
+	std::erase_if(_water_region_route_cache, [](const auto &item) {
+		const CachedWaterRegionRoute &cached = item.second;
+		return std::ranges::any_of(cached.regions, [&cached](const WaterRegionDesc &region) { return GetWaterRegionVersion(region) > cached.version; });
+	});
+}
 
 /** Yapf Node Key that represents a single patch of interconnected water within a water region. */
 struct CYapfRegionPatchNodeKey {
@@ -162,10 +198,23 @@ protected:
 	inline Tpf &Yapf() { return *static_cast<Tpf*>(this); }
 
 public:
+	std::vector<WaterRegionDesc> examined_regions; ///< The water regions whose contents the search depends on.
+
 	inline void PfFollowNode(Node &old_node)
 	{
+		/* Which neighbours there are depends on the region itself, and on the edges of the regions next to it. */
+		const WaterRegionDesc region(old_node.key.water_region_patch);
+		this->examined_regions.push_back(region);
+		for (DiagDirection side = DIAGDIR_BEGIN; side < DIAGDIR_END; side++) {
+			const TileIndexDiffC offset = TileIndexDiffCByDiagDir(side);
+			this->examined_regions.emplace_back(region.x + offset.x, region.y + offset.y);
+		}
+
 		TVisitWaterRegionPatchCallBack visitFunc = [&](const WaterRegionPatchDesc &water_region_patch)
 		{
+			/* Neighbours reached over an aqueduct can be in any region. */
+			this->examined_regions.emplace_back(water_region_patch);
+
 			Node &node = Yapf().CreateNewNode();
 			node.Set(&old_node, water_region_patch);
 			Yapf().AddNewNode(node, TrackFollower{});
@@ -175,14 +224,53 @@ public:
 
 	inline char TransportTypeChar() const { return '^'; }
 
-	static std::vector<WaterRegionPatchDesc> FindWaterRegionPath(const Ship *v, TileIndex start_tile, int max_returned_path_length)
+	/**
+	 * Find the best route from a water region patch to any of the given water region patches.
+	 * The destinations are the origins of the search, as the search is done backwards.
+	 * @param v The ship to find the route for.
+	 * @param start The water region patch to start at.
+	 * @param destinations The water region patches to find a route to.
+	 * @return The water region patches of the route from start to destination, or an empty vector if there is no route,
+	 *         together with the water regions the search looked at.
+	 */
+	static CachedWaterRegionRoute FindWaterRegionRoute(const Ship *v, const WaterRegionPatchDesc &start, const std::vector<WaterRegionPatchDesc> &destinations)
 	{
-		const WaterRegionPatchDesc start_water_region_patch = GetWaterRegionPatchInfo(start_tile);
-
 		/* We reserve 4 nodes (patches) per water region. The vast majority of water regions have 1 or 2 regions so this should be a pretty
 		 * safe limit. We cap the limit at 65536 which is at a region size of 16x16 is equivalent to one node per region for a 4096x4096 map. */
 		Tpf pf(std::min(static_cast<int>(Map::Size() * NODES_PER_REGION) / WATER_REGION_NUMBER_OF_TILES, MAX_NUMBER_OF_NODES));
-		pf.SetDestination(start_water_region_patch);
+		pf.SetDestination(start);
+		for (const WaterRegionPatchDesc &destination : destinations) pf.AddOrigin(destination);
+
+		CachedWaterRegionRoute result{ {}, {}, GetWaterRegionsVersion() };
+
+		/* Find best path. */
+		if (pf.FindPath(v)) {
+			for (Node *node = pf.GetBestNode(); node != nullptr; node = node->parent) result.route.push_back(node->key.water_region_patch);
+		}
+
+		/* The labels of the start and destination patches are part of the key, so their regions matter even when the search did not look inside them. */
+		result.regions = std::move(pf.examined_regions);
+		result.regions.emplace_back(start);
+		for (const WaterRegionPatchDesc &destination : destinations) result.regions.emplace_back(destination);
+
+		auto region_order = [](const WaterRegionDesc &a, const WaterRegionDesc &b) { return std::tie(a.y, a.x) < std::tie(b.y, b.x); };
+		std::ranges::sort(result.regions, region_order);
+		auto [first, last] = std::ranges::unique(result.regions);
+		result.regions.erase(first, last);
+		result.regions.shrink_to_fit();
+
+		return result;
+	}
+
+	static std::vector<WaterRegionPatchDesc> FindWaterRegionPath(const Ship *v, TileIndex start_tile, int max_returned_path_length)
+	{
+		const WaterRegionPatchDesc start_water_region_patch = GetWaterRegionPatchInfo(start_tile);
+
+		std::vector<WaterRegionPatchDesc> destinations;
+		auto add_destination = [&destinations](const WaterRegionPatchDesc &water_region_patch) {
+			if (water_region_patch.label == INVALID_WATER_REGION_PATCH) return;
+			if (std::ranges::find(destinations, water_region_patch) == destinations.end()) destinations.push_back(water_region_patch);
+		};
 
 		if (v->current_order.IsType(OT_GOTO_STATION)) {
 			StationID station_id = v->current_order.GetDestination().ToStationID();
@@ -191,32 +279,37 @@ public:
 			station->GetTileArea(&tile_area, StationType::Dock);
 			for (const auto &tile : tile_area) {
 				if (IsDockingTile(tile) && IsShipDestinationTile(tile, station_id)) {
-					pf.AddOrigin(GetWaterRegionPatchInfo(tile));
+					add_destination(GetWaterRegionPatchInfo(tile));
 				}
 			}
 		} else {
 			TileIndex tile = v->dest_tile;
-			pf.AddOrigin(GetWaterRegionPatchInfo(tile));
+			add_destination(GetWaterRegionPatchInfo(tile));
 		}
 
 		/* If origin and destination are the same we simply return that water patch. */
-		std::vector<WaterRegionPatchDesc> path = { start_water_region_patch };
-		path.reserve(max_returned_path_length);
-		if (pf.HasOrigin(start_water_region_patch)) return path;
+		if (std::ranges::find(destinations, start_water_region_patch) != destinations.end()) return { start_water_region_patch };
 
-		/* Find best path. */
-		if (!pf.FindPath(v)) return {}; // Path not found.
+		/* The routes are only valid as long as none of the water regions they were found on have changed. */
+		RemoveChangedWaterRegionRoutes();
+		if (_water_region_route_cache.size() >= MAX_NUMBER_OF_CACHED_ROUTES) _water_region_route_cache.clear();
 
-		Node *node = pf.GetBestNode();
-		for (int i = 0; i < max_returned_path_length - 1; ++i) {
-			if (node != nullptr) {
-				node = node->parent;
-				if (node != nullptr) path.push_back(node->key.water_region_patch);
-			}
+		WaterRegionRouteKey key{ CalculateWaterRegionPatchHash(start_water_region_patch), {} };
+		for (const WaterRegionPatchDesc &destination : destinations) key.destinations.push_back(CalculateWaterRegionPatchHash(destination));
+
+		_water_region_route_cache_statistics.lookups++;
+		auto [it, inserted] = _water_region_route_cache.try_emplace(std::move(key));
+		if (inserted) {
+			it->second = FindWaterRegionRoute(v, start_water_region_patch, destinations);
+		} else {
+			_water_region_route_cache_statistics.hits++;
 		}
 
-		assert(!path.empty());
-		return path;
+		const std::vector<WaterRegionPatchDesc> &route = it->second.route;
+		if (route.empty()) return {}; // Path not found.
+
+		assert(route.front() == start_water_region_patch);
+		return { route.begin(), route.begin() + std::min<size_t>(route.size(), max_returned_path_length) };
 	}
 };
 
@@ -298,3 +391,12 @@ std::vector<WaterRegionPatchDesc> YapfShipFindWaterRegionPath(const Ship *v, Til
 {
 	return CYapfRegionWater::FindWaterRegionPath(v, start_tile, max_returned_path_length);
 }
+
+/**
+ * Get the number of lookups and hits of the cache of routes over water regions since the game was started.
+ * @return The statistics of the route cache.
+ */
+WaterRegionRouteCacheStatistics GetWaterRegionRouteCacheStatistics()
+{
+	return _water_region_route_cache_statistics;
+}
@@ -16,6 +16,13 @@
 
 struct Ship;
 
+/** Statistics of the cache of routes over water regions. */
+struct WaterRegionRouteCacheStatistics {
+	uint64_t lookups = 0; ///< Number of times a route was looked for.
+	uint64_t hits = 0; ///< Number of times the route was found in the cache.
+};
+
 std::vector<WaterRegionPatchDesc> YapfShipFindWaterRegionPath(const Ship *v, TileIndex start_tile, int max_returned_path_length);
+WaterRegionRouteCacheStatistics GetWaterRegionRouteCacheStatistics();
 
 #endif /* YAPF_SHIP_REGIONS_H */
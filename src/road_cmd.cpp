@@ -15,6 +15,7 @@
 #include "company_func.h"
 #include "pathfinder/yapf/yapf_cache.h"
 #include "depot_base.h"
+#include "depot_kdtree.h"
 #include "newgrf.h"
 #include "autoslope.h"
 #include "tunnelbridge_map.h"
@@ -377,6 +378,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlags flags, RoadBits pie
 
 				SetRoadType(other_end, rtt, INVALID_ROADTYPE);
 				SetRoadType(tile,      rtt, INVALID_ROADTYPE);
+				YapfNotifyRoadLayoutChange(tile);
 
 				/* If the owner of the bridge sells all its road, also move the ownership
 				 * to the owner of the other roadtype, unless the bridge owner is a town. */
@@ -401,6 +403,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlags flags, RoadBits pie
 				/* A full diagonal road tile has two road bits. */
 				UpdateCompanyRoadInfrastructure(existing_rt, GetRoadOwner(tile, rtt), -2);
 				SetRoadType(tile, rtt, INVALID_ROADTYPE);
+				YapfNotifyRoadLayoutChange(tile);
 				MarkTileDirtyByTile(tile);
 			}
 		}
@@ -455,6 +458,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlags flags, RoadBits pie
 				}
 
 				UpdateCompanyRoadInfrastructure(existing_rt, GetRoadOwner(tile, rtt), -(int)CountBits(pieces));
+				YapfNotifyRoadLayoutChange(tile);
 
 				if (present == ROAD_NONE) {
 					/* No other road type, just clear tile. */
@@ -519,6 +523,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlags flags, RoadBits pie
 				}
 				MarkTileDirtyByTile(tile);
 				YapfNotifyTrackLayoutChange(tile, railtrack);
+				YapfNotifyRoadLayoutChange(tile);
 			}
 			return CommandCost(EXPENSES_CONSTRUCTION, RoadClearCost(existing_rt) * 2);
 		}
@@ -678,6 +683,7 @@ CommandCost CmdBuildRoad(DoCommandFlags flags, TileIndex tile, RoadBits pieces,
 							/* Ignore half built tiles */
 							if (flags.Test(DoCommandFlag::Execute) && IsStraightRoad(existing)) {
 								SetDisallowedRoadDirections(tile, dis_new);
+								YapfNotifyRoadLayoutChange(tile);
 								MarkTileDirtyByTile(tile);
 							}
 							return CommandCost();
@@ -762,6 +768,7 @@ CommandCost CmdBuildRoad(DoCommandFlags flags, TileIndex tile, RoadBits pieces,
 			if (flags.Test(DoCommandFlag::Execute)) {
 				Track railtrack = AxisToTrack(OtherAxis(roaddir));
 				YapfNotifyTrackLayoutChange(tile, railtrack);
+				YapfNotifyRoadLayoutChange(tile);
 				/* Update company infrastructure counts. A level crossing has two road bits. */
 				UpdateCompanyRoadInfrastructure(rt, company, 2);
 
@@ -925,6 +932,7 @@ do_clear:;
 		/* Update company infrastructure count. */
 		if (IsTileType(tile, MP_TUNNELBRIDGE)) num_pieces *= TUNNELBRIDGE_TRACKBIT_FACTOR;
 		UpdateCompanyRoadInfrastructure(rt, GetRoadOwner(tile, rtt), num_pieces);
+		YapfNotifyRoadLayoutChange(tile);
 
 		if (rtt == RTT_ROAD && IsNormalRoadTile(tile)) {
 			existing |= pieces;
@@ -1188,11 +1196,13 @@ CommandCost CmdBuildRoadDepot(DoCommandFlags flags, TileIndex tile, RoadType rt,
 			Depot *dep = new Depot(tile);
 			MakeRoadDepot(tile, _current_company, dep->index, dir, rt);
 			MakeDefaultName(dep);
+			AddDepotToKdtree(dep);
 
 			/* A road depot has two road bits. */
 			UpdateCompanyRoadInfrastructure(rt, _current_company, ROAD_DEPOT_TRACKBIT_FACTOR);
 		}
 
+		YapfNotifyRoadLayoutChange(tile);
 		MarkTileDirtyByTile(tile);
 	}
 
@@ -1222,6 +1232,7 @@ static CommandCost RemoveRoadDepot(TileIndex tile, DoCommandFlags flags)
 
 		delete Depot::GetByTile(tile);
 		DoClearSquare(tile);
+		YapfNotifyRoadLayoutChange(tile);
 	}
 
 	return CommandCost(EXPENSES_CONSTRUCTION, _price[PR_CLEAR_DEPOT_ROAD]);
@@ -2011,6 +2022,7 @@ static void TileLoop_Road(TileIndex tile)
 					IsNormalRoad(tile) && !HasAtMostOneBit(GetAllRoadBits(tile))) {
 				if (std::get<0>(GetFoundationSlope(tile)) == SLOPE_FLAT && EnsureNoVehicleOnGround(tile).Succeeded() && Chance16(1, 40)) {
 					StartRoadWorks(tile);
+					YapfNotifyRoadLayoutChange(tile);
 
 					if (_settings_client.sound.ambient) SndPlayTileFx(SND_21_ROAD_WORKS, tile);
 					CreateEffectVehicleAbove(
@@ -2047,6 +2059,7 @@ static void TileLoop_Road(TileIndex tile)
 		}
 	} else if (IncreaseRoadWorksCounter(tile)) {
 		TerminateRoadWorks(tile);
+		YapfNotifyRoadLayoutChange(tile);
 
 		if (_settings_game.economy.mod_road_rebuild) {
 			/* Generate a nicer town surface */
@@ -2069,6 +2082,7 @@ static void TileLoop_Road(TileIndex tile)
 			RoadType rt = GetTownRoadType();
 			if (rt != GetRoadTypeRoad(tile)) {
 				SetRoadType(tile, RTT_ROAD, rt);
+				YapfNotifyRoadLayoutChange(tile);
 			}
 		}
 
@@ -2294,6 +2308,7 @@ static void ChangeTileOwner_Road(TileIndex tile, Owner old_owner, Owner new_owne
 				Company::Get(new_owner)->infrastructure.road[rt] += 2;
 
 				SetTileOwner(tile, new_owner);
+				YapfNotifyRoadLayoutChange(tile);
 				for (RoadTramType rtt : _roadtramtypes) {
 					if (GetRoadOwner(tile, rtt) == old_owner) {
 						SetRoadOwner(tile, rtt, new_owner);
@@ -2538,6 +2553,7 @@ CommandCost CmdConvertRoad(DoCommandFlags flags, TileIndex tile, TileIndex area_
 
 				/* Perform the conversion */
 				SetRoadType(tile, rtt, to_type);
+				YapfNotifyRoadLayoutChange(tile);
 				MarkTileDirtyByTile(tile);
 
 				/* update power of train on this tile */
@@ -2593,6 +2609,7 @@ CommandCost CmdConvertRoad(DoCommandFlags flags, TileIndex tile, TileIndex area_
 				/* Perform the conversion */
 				SetRoadType(tile,    rtt, to_type);
 				SetRoadType(endtile, rtt, to_type);
+				YapfNotifyRoadLayoutChange(tile);
 
 				FindVehicleOnPos(tile, &affected_rvs, &UpdateRoadVehPowerProc);
 				FindVehicleOnPos(endtile, &affected_rvs, &UpdateRoadVehPowerProc);
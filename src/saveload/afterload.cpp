@@ -11,6 +11,7 @@
 #include "../void_map.h"
 #include "../signs_base.h"
 #include "../depot_base.h"
+#include "../depot_kdtree.h"
 #include "../fios.h"
 #include "../gamelog_internal.h"
 #include "../network/network.h"
@@ -540,6 +541,22 @@ static inline bool MayHaveBridgeAbove(Tile t)
 			IsTileType(t, MP_WATER) || IsTileType(t, MP_TUNNELBRIDGE) || IsTileType(t, MP_OBJECT);
 }
 
+/**
+ * Call a function for each order of all order lists and order backups, to convert them.
+ * Order backups are saved by network servers too, so they need the same conversions.
+ * @param func The function to call for each order.
+ */
+template <typename Func>
+static void ForAllOrders(Func func)
+{
+	for (OrderList *list : OrderList::Iterate()) {
+		for (Order &order : list->GetOrders()) func(order);
+	}
+	for (OrderBackup *ob : OrderBackup::Iterate()) {
+		for (Order &order : ob->GetOrders()) func(order);
+	}
+}
+
 /**
  * Start the scripts.
  */
@@ -1435,6 +1452,7 @@ bool AfterLoadGame()
 	}
 
 	YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
+	YapfNotifyRoadLayoutChange(INVALID_TILE);
 
 	if (IsSavegameVersionBefore(SLV_34)) {
 		for (Company *c : Company::Iterate()) ResetCompanyLivery(c);
@@ -1489,9 +1507,7 @@ bool AfterLoadGame()
 
 	/* Setting no refit flags to all orders in savegames from before refit in orders were added */
 	if (IsSavegameVersionBefore(SLV_36)) {
-		for (Order *order : Order::Iterate()) {
-			order->SetRefit(CARGO_NO_REFIT);
-		}
+		ForAllOrders([](Order &order) { order.SetRefit(CARGO_NO_REFIT); });
 
 		for (Vehicle *v : Vehicle::Iterate()) {
 			v->current_order.SetRefit(CARGO_NO_REFIT);
@@ -1785,7 +1801,7 @@ bool AfterLoadGame()
 
 	if (IsSavegameVersionBefore(SLV_93)) {
 		/* Rework of orders. */
-		for (Order *order : Order::Iterate()) order->ConvertFromOldSavegame();
+		ForAllOrders([](Order &order) { order.ConvertFromOldSavegame(); });
 
 		for (Vehicle *v : Vehicle::Iterate()) {
 			if (v->orders != nullptr && v->orders->GetFirstOrder() != nullptr && v->orders->GetFirstOrder()->IsType(OT_NOTHING)) {
@@ -1800,12 +1816,12 @@ bool AfterLoadGame()
 		}
 	} else if (IsSavegameVersionBefore(SLV_94)) {
 		/* Unload and transfer are now mutual exclusive. */
-		for (Order *order : Order::Iterate()) {
-			if ((order->GetUnloadType() & (OUFB_UNLOAD | OUFB_TRANSFER)) == (OUFB_UNLOAD | OUFB_TRANSFER)) {
-				order->SetUnloadType(OUFB_TRANSFER);
-				order->SetLoadType(OLFB_NO_LOAD);
+		ForAllOrders([](Order &order) {
+			if ((order.GetUnloadType() & (OUFB_UNLOAD | OUFB_TRANSFER)) == (OUFB_UNLOAD | OUFB_TRANSFER)) {
+				order.SetUnloadType(OUFB_TRANSFER);
+				order.SetLoadType(OLFB_NO_LOAD);
 			}
-		}
+		});
 
 		for (Vehicle *v : Vehicle::Iterate()) {
 			if ((v->current_order.GetUnloadType() & (OUFB_UNLOAD | OUFB_TRANSFER)) == (OUFB_UNLOAD | OUFB_TRANSFER)) {
@@ -1815,10 +1831,10 @@ bool AfterLoadGame()
 		}
 	} else if (IsSavegameVersionBefore(SLV_DEPOT_UNBUNCHING)) {
 		/* OrderDepotActionFlags were moved, instead of starting at bit 4 they now start at bit 3. */
-		for (Order *order : Order::Iterate()) {
-			if (!order->IsType(OT_GOTO_DEPOT)) continue;
-			order->SetDepotActionType((OrderDepotActionFlags)(order->GetDepotActionType() >> 1));
-		}
+		ForAllOrders([](Order &order) {
+			if (!order.IsType(OT_GOTO_DEPOT)) return;
+			order.SetDepotActionType((OrderDepotActionFlags)(order.GetDepotActionType() >> 1));
+		});
 
 		for (Vehicle *v : Vehicle::Iterate()) {
 			if (!v->current_order.IsType(OT_GOTO_DEPOT)) continue;
@@ -2179,9 +2195,9 @@ bool AfterLoadGame()
 
 	/* Trains could now stop in a specific location. */
 	if (IsSavegameVersionBefore(SLV_117)) {
-		for (Order *o : Order::Iterate()) {
-			if (o->IsType(OT_GOTO_STATION)) o->SetStopLocation(OSL_PLATFORM_FAR_END);
-		}
+		ForAllOrders([](Order &order) {
+			if (order.IsType(OT_GOTO_STATION)) order.SetStopLocation(OSL_PLATFORM_FAR_END);
+		});
 	}
 
 	if (IsSavegameVersionBefore(SLV_120)) {
@@ -3058,10 +3074,10 @@ bool AfterLoadGame()
 	}
 
 	if (IsSavegameVersionBefore(SLV_190)) {
-		for (Order *order : Order::Iterate()) {
-			order->SetTravelTimetabled(order->GetTravelTime() > 0);
-			order->SetWaitTimetabled(order->GetWaitTime() > 0);
-		}
+		ForAllOrders([](Order &order) {
+			order.SetTravelTimetabled(order.GetTravelTime() > 0);
+			order.SetWaitTimetabled(order.GetWaitTime() > 0);
+		});
 		for (OrderList *orderlist : OrderList::Iterate()) {
 			orderlist->RecalculateTimetableDuration();
 		}
@@ -3297,6 +3313,12 @@ bool AfterLoadGame()
 	/* Compute station catchment areas. This is needed here in case UpdateStationAcceptance is called below. */
 	Station::RecomputeCatchmentForAll();
 
+	/* Orders may have been converted above, so index them now. */
+	RebuildOrderDestinationIndex();
+
+	/* Depots and airports may have been converted above as well. */
+	RebuildDepotKdtrees();
+
 	/* Station acceptance is some kind of cache */
 	if (IsSavegameVersionBefore(SLV_127)) {
 		for (Station *st : Station::Iterate()) UpdateStationAcceptance(st, false);
@@ -3422,6 +3444,8 @@ void ReloadNewGRFData()
 	RecomputePrices();
 	/* reload vehicles */
 	ResetVehicleHash();
+	/* Cached callback results were resolved with the old NewGRF data. */
+	for (Vehicle *v : Vehicle::Iterate()) v->InvalidateNewGRFCache();
 	AfterLoadLabelMaps();
 	AfterLoadVehiclesPhase1(false);
 	AfterLoadVehiclesPhase2(false);
@@ -3429,6 +3453,10 @@ void ReloadNewGRFData()
 	GroupStatistics::UpdateAfterLoad();
 	/* update station graphics */
 	AfterLoadStations();
+	/* The acceptance of tiles, and whether it comes from a callback, depends on the NewGRF data. */
+	for (Station *st : Station::Iterate()) st->acceptance_cache.valid = false;
+	/* Cached road segment costs depend on the road types of the NewGRFs. */
+	YapfNotifyRoadLayoutChange(INVALID_TILE);
 	/* Update company statistics. */
 	AfterLoadCompanyStats();
 	/* Check and update house and town values */
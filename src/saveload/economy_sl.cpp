@@ -54,6 +54,7 @@ static const SaveLoad _economy_desc[] = {
 	    SLE_VAR(Economy, infl_amount,                   SLE_UINT8),
 	    SLE_VAR(Economy, infl_amount_pr,                SLE_UINT8),
 	SLE_CONDVAR(Economy, industry_daily_change_counter, SLE_UINT32,                SLV_102, SL_MAX_VERSION),
+	SLE_CONDVAR(Economy, spread_monthly_loop,           SLE_BOOL,                  SLV_SPREAD_MONTHLY_LOOP, SL_MAX_VERSION),
 };
 
 /** Economy variables */
@@ -643,16 +643,15 @@ static bool LoadOldOrder(LoadgameState &ls, int num)
 {
 	if (!LoadChunk(ls, nullptr, order_chunk)) return false;
 
-	Order *o = new (OrderID(num)) Order();
-	o->AssignOrder(UnpackOldOrder(_old_order));
+	Order order = UnpackOldOrder(_old_order);
+
+	if (!order.IsType(OT_NOTHING)) {
+		AllocateOldOrder(num).order = order;
 
-	if (o->IsType(OT_NOTHING)) {
-		delete o;
-	} else {
 		/* Relink the orders to each other (in the orders for one vehicle are behind each other,
 		 * with an invalid order (OT_NOTHING) as indication that it is the last order */
-		Order *prev = Order::GetIfValid(num - 1);
-		if (prev != nullptr) prev->next = o;
+		OldOrderSaveLoadItem *prev = num == 0 ? nullptr : GetOldOrder(num - 1);
+		if (prev != nullptr) prev->next = num + 1;
 	}
 
 	return true;
@@ -1364,7 +1363,7 @@ bool LoadOldVehicle(LoadgameState &ls, int num)
 		if (_old_order_ptr != 0 && _old_order_ptr != 0xFFFFFFFF) {
 			uint max = _savegame_type == SGT_TTO ? 3000 : 5000;
 			uint old_id = RemapOrderIndex(_old_order_ptr);
-			if (old_id < max) v->old_orders = Order::Get(old_id); // don't accept orders > max number of orders
+			if (old_id < max) v->old_orders = GetOldOrder(old_id); // don't accept orders > max number of orders
 		}
 		v->current_order.AssignOrder(UnpackOldOrder(_old_order));
 
@@ -1793,6 +1792,7 @@ bool LoadTTDMain(LoadgameState &ls)
 	Debug(oldloader, 3, "Reading main chunk...");
 
 	_read_ttdpatch_flags = false;
+	ClearOldOrders();
 
 	/* Load the biggest chunk */
 	if (!LoadChunk(ls, nullptr, main_chunk)) {
@@ -1826,6 +1826,7 @@ bool LoadTTOMain(LoadgameState &ls)
 	Debug(oldloader, 3, "Reading main chunk...");
 
 	_read_ttdpatch_flags = false;
+	ClearOldOrders();
 
 	std::array<uint8_t, 103 * sizeof(Engine)> engines; // we don't want to call Engine constructor here
 	_old_engines = (Engine *)engines.data();
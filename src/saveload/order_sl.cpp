@@ -102,13 +102,79 @@ Order UnpackOldOrder(uint16_t packed)
 	return order;
 }
 
+static uint32_t _old_order_next; ///< Index plus one of the next order of a loaded order, for savegames from before orders were stored in their order list.
+static uint32_t _old_order_list_first; ///< Index plus one of the first order of a loaded order list or order backup, for savegames from before orders were stored in their order list.
+static std::map<uint32_t, OldOrderSaveLoadItem> _old_orders; ///< Orders of savegames from before orders were stored in their order list, by their index.
+
+/**
+ * Allocate an order of a savegame from before orders were stored in their order list.
+ * @param index The index of the order in the savegame.
+ * @return The order.
+ */
+OldOrderSaveLoadItem &AllocateOldOrder(size_t index)
+{
+	return _old_orders[static_cast<uint32_t>(index)];
+}
+
+/**
+ * Get an order of a savegame from before orders were stored in their order list.
+ * @param index The index of the order in the savegame.
+ * @return The order, or nullptr if there is no order with that index.
+ */
+OldOrderSaveLoadItem *GetOldOrder(size_t index)
+{
+	auto it = _old_orders.find(static_cast<uint32_t>(index));
+	return it == _old_orders.end() ? nullptr : &it->second;
+}
+
+/**
+ * Get the orders of a chain of orders of a savegame from before orders were stored in their order list.
+ * @param first The first order of the chain, or nullptr for an empty chain.
+ * @return The orders of the chain.
+ */
+std::vector<Order> GetOrdersFromOldChain(const OldOrderSaveLoadItem *first)
+{
+	std::vector<Order> orders;
+	for (const OldOrderSaveLoadItem *item = first; item != nullptr;) {
+		/* A chain can never be longer than the number of orders, unless it loops. */
+		if (orders.size() >= _old_orders.size()) SlErrorCorrupt("Order chain contains a loop");
+		orders.push_back(item->order);
+
+		if (item->next == 0) break;
+		item = GetOldOrder(item->next - 1);
+		if (item == nullptr) SlErrorCorrupt("Referencing invalid Order");
+	}
+	return orders;
+}
+
+/**
+ * Get the orders of a chain of orders of a savegame from before orders were stored in their order list.
+ * @param first The index plus one of the first order of the chain, or 0 for an empty chain.
+ * @return The orders of the chain.
+ */
+std::vector<Order> GetOrdersFromOldChain(uint32_t first)
+{
+	if (first == 0) return {};
+
+	const OldOrderSaveLoadItem *item = GetOldOrder(first - 1);
+	if (item == nullptr) SlErrorCorrupt("Referencing invalid Order");
+	return GetOrdersFromOldChain(item);
+}
+
+/** Free the orders of a savegame from before orders were stored in their order list, once they have been moved to their order lists. */
+void ClearOldOrders()
+{
+	_old_orders.clear();
+}
+
 SaveLoadTable GetOrderDescription()
 {
 	static const SaveLoad _order_desc[] = {
 		     SLE_VAR(Order, type,           SLE_UINT8),
 		     SLE_VAR(Order, flags,          SLE_UINT8),
 		     SLE_VAR(Order, dest,           SLE_UINT16),
-		     SLE_REF(Order, next,           REF_ORDER),
+		SLEG_CONDVAR("next", _old_order_next, SLE_FILE_U16 | SLE_VAR_U32, SL_MIN_VERSION, SLV_69),
+		SLEG_CONDVAR("next", _old_order_next, SLE_UINT32,                 SLV_69, SLV_ORDERS_OWNED_BY_ORDERLIST),
 		 SLE_CONDVAR(Order, refit_cargo,    SLE_UINT8,   SLV_36, SL_MAX_VERSION),
 		 SLE_CONDVAR(Order, wait_time,      SLE_UINT16,  SLV_67, SL_MAX_VERSION),
 		 SLE_CONDVAR(Order, travel_time,    SLE_UINT16,  SLV_67, SL_MAX_VERSION),
@@ -118,22 +184,14 @@ SaveLoadTable GetOrderDescription()
 	return _order_desc;
 }
 
+/** Orders used to be stored in their own chunk, from which they are now only loaded to be moved into their order lists. */
 struct ORDRChunkHandler : ChunkHandler {
-	ORDRChunkHandler() : ChunkHandler('ORDR', CH_TABLE) {}
-
-	void Save() const override
-	{
-		const SaveLoadTable slt = GetOrderDescription();
-		SlTableHeader(slt);
-
-		for (Order *order : Order::Iterate()) {
-			SlSetArrayIndex(order->index);
-			SlObject(order, slt);
-		}
-	}
+	ORDRChunkHandler() : ChunkHandler('ORDR', CH_READONLY) {}
 
 	void Load() const override
 	{
+		ClearOldOrders();
+
 		if (IsSavegameVersionBefore(SLV_5, 2)) {
 			/* Version older than 5.2 did not have a ->next pointer. Convert them
 			 * (in the old days, the orderlist was 5000 items big) */
@@ -148,8 +206,7 @@ struct ORDRChunkHandler : ChunkHandler {
 				SlCopy(&orders[0], len, SLE_UINT16);
 
 				for (size_t i = 0; i < len; ++i) {
-					Order *o = new (OrderID(static_cast<uint32_t>(i))) Order();
-					o->AssignOrder(UnpackVersion4Order(orders[i]));
+					AllocateOldOrder(i).order.AssignOrder(UnpackVersion4Order(orders[i]));
 				}
 			} else if (IsSavegameVersionBefore(SLV_5, 2)) {
 				len /= sizeof(uint32_t);
@@ -158,22 +215,22 @@ struct ORDRChunkHandler : ChunkHandler {
 				SlCopy(&orders[0], len, SLE_UINT32);
 
 				for (size_t i = 0; i < len; ++i) {
-					new (OrderID(static_cast<uint32_t>(i))) Order(GB(orders[i], 0, 8), GB(orders[i], 8, 8), GB(orders[i], 16, 16));
+					AllocateOldOrder(i).order = Order(GB(orders[i], 0, 8), GB(orders[i], 8, 8), GB(orders[i], 16, 16));
 				}
 			}
 
 			/* Update all the next pointer */
-			for (Order *o : Order::Iterate()) {
-				size_t order_index = o->index.base();
+			for (auto it = _old_orders.begin(); it != _old_orders.end(); /* nothing */) {
 				/* Delete invalid orders */
-				if (o->IsType(OT_NOTHING)) {
-					delete o;
+				if (it->second.order.IsType(OT_NOTHING)) {
+					it = _old_orders.erase(it);
 					continue;
 				}
 				/* The orders were built like this:
 				 * While the order is valid, set the previous will get its next pointer set */
-				Order *prev = Order::GetIfValid(order_index - 1);
-				if (prev != nullptr) prev->next = o;
+				OldOrderSaveLoadItem *prev = it->first == 0 ? nullptr : GetOldOrder(it->first - 1);
+				if (prev != nullptr) prev->next = it->first + 1;
+				++it;
 			}
 		} else {
 			const std::vector<SaveLoad> slt = SlCompatTableHeader(GetOrderDescription(), _order_sl_compat);
@@ -181,27 +238,43 @@ struct ORDRChunkHandler : ChunkHandler {
 			int index;
 
 			while ((index = SlIterateArray()) != -1) {
-				Order *order = new (OrderID(index)) Order();
-				SlObject(order, slt);
+				OldOrderSaveLoadItem &item = AllocateOldOrder(index);
+				SlObject(&item.order, slt);
+				item.next = _old_order_next;
 			}
 		}
 	}
+};
 
-	void FixPointers() const override
-	{
-		/* Orders from old savegames have pointers corrected in Load_ORDR */
-		if (IsSavegameVersionBefore(SLV_5, 2)) return;
+/**
+ * Handler for saving and loading the orders of an object.
+ * @tparam TImpl The class initializing this template.
+ * @tparam TObject The class of the object with the orders.
+ */
+template <class TImpl, class TObject>
+class SlOrders : public VectorSaveLoadHandler<TImpl, TObject, Order, MAX_VEH_ORDER_ID> {
+public:
+	static inline const SaveLoadTable description = GetOrderDescription();
+	static inline const SaveLoadCompatTable compat_description = _order_sl_compat;
+};
 
-		for (Order *o : Order::Iterate()) {
-			SlObject(o, GetOrderDescription());
-		}
-	}
+/** Handler for saving and loading the orders of order lists. */
+class SlOrderListOrders : public SlOrders<SlOrderListOrders, OrderList> {
+public:
+	std::vector<Order> &GetVector(OrderList *list) const override { return list->orders; }
+};
+
+/** Handler for saving and loading the orders of order backups. */
+class SlOrderBackupOrders : public SlOrders<SlOrderBackupOrders, OrderBackup> {
+public:
+	std::vector<Order> &GetVector(OrderBackup *ob) const override { return ob->orders; }
 };
 
 SaveLoadTable GetOrderListDescription()
 {
 	static const SaveLoad _orderlist_desc[] = {
-		SLE_REF(OrderList, first,              REF_ORDER),
+		SLEG_CONDVAR("first", _old_order_list_first, SLE_UINT32, SL_MIN_VERSION, SLV_ORDERS_OWNED_BY_ORDERLIST),
+		SLEG_CONDSTRUCTLIST("orders", SlOrderListOrders, SLV_ORDERS_OWNED_BY_ORDERLIST, SL_MAX_VERSION),
 	};
 
 	return _orderlist_desc;
@@ -228,17 +301,11 @@ struct ORDLChunkHandler : ChunkHandler {
 		int index;
 
 		while ((index = SlIterateArray()) != -1) {
-			/* set num_orders to 0 so it's a valid OrderList */
-			OrderList *list = new (OrderListID(index)) OrderList(0);
+			OrderList *list = new (OrderListID(index)) OrderList();
 			SlObject(list, slt);
-		}
 
-	}
-
-	void FixPointers() const override
-	{
-		for (OrderList *list : OrderList::Iterate()) {
-			SlObject(list, GetOrderListDescription());
+			/* The orders were loaded before the order lists, so they can be moved into their order list right away. */
+			if (IsSavegameVersionBefore(SLV_ORDERS_OWNED_BY_ORDERLIST)) list->orders = GetOrdersFromOldChain(_old_order_list_first);
 		}
 	}
 };
@@ -261,12 +328,16 @@ SaveLoadTable GetOrderBackupDescription()
 		 SLE_CONDVAR(OrderBackup, timetable_start,          SLE_UINT64,                 SLV_TIMETABLE_START_TICKS_FIX, SL_MAX_VERSION),
 		 SLE_CONDVAR(OrderBackup, vehicle_flags,            SLE_FILE_U8 | SLE_VAR_U16, SLV_176, SLV_180),
 		 SLE_CONDVAR(OrderBackup, vehicle_flags,            SLE_UINT16,                SLV_180, SL_MAX_VERSION),
-		     SLE_REF(OrderBackup, orders,                   REF_ORDER),
+		SLEG_CONDVAR("orders", _old_order_list_first,      SLE_UINT32,                 SL_MIN_VERSION, SLV_ORDERS_OWNED_BY_ORDERLIST),
+		SLEG_CONDSTRUCTLIST("orders", SlOrderBackupOrders,                            SLV_ORDERS_OWNED_BY_ORDERLIST, SL_MAX_VERSION),
 	};
 
 	return _order_backup_desc;
 }
 
+/** Index plus one of the first order of each loaded order backup, for savegames from before orders were stored in their order list. */
+static std::vector<std::pair<OrderBackupID, uint32_t>> _old_order_backup_orders;
+
 struct BKORChunkHandler : ChunkHandler {
 	BKORChunkHandler() : ChunkHandler('BKOR', CH_TABLE) {}
 
@@ -290,12 +361,15 @@ struct BKORChunkHandler : ChunkHandler {
 	{
 		const std::vector<SaveLoad> slt = SlCompatTableHeader(GetOrderBackupDescription(), _order_backup_sl_compat);
 
+		_old_order_backup_orders.clear();
+
 		int index;
 
 		while ((index = SlIterateArray()) != -1) {
-			/* set num_orders to 0 so it's a valid OrderList */
 			OrderBackup *ob = new (OrderBackupID(index)) OrderBackup();
 			SlObject(ob, slt);
+
+			if (IsSavegameVersionBefore(SLV_ORDERS_OWNED_BY_ORDERLIST)) _old_order_backup_orders.emplace_back(ob->index, _old_order_list_first);
 		}
 	}
 
@@ -304,6 +378,12 @@ struct BKORChunkHandler : ChunkHandler {
 		for (OrderBackup *ob : OrderBackup::Iterate()) {
 			SlObject(ob, GetOrderBackupDescription());
 		}
+
+		/* The orders are loaded after the order backups, so they can only be moved into their order backup now. */
+		for (const auto &[index, first] : _old_order_backup_orders) {
+			OrderBackup::Get(index)->orders = GetOrdersFromOldChain(first);
+		}
+		_old_order_backup_orders.clear();
 	}
 };
 
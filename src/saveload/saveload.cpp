@@ -1181,7 +1181,6 @@ static size_t ReferenceToInt(const void *obj, SLRefType rt)
 		case REF_VEHICLE:   return ((const  Vehicle*)obj)->index + 1;
 		case REF_STATION:   return ((const  Station*)obj)->index + 1;
 		case REF_TOWN:      return ((const     Town*)obj)->index + 1;
-		case REF_ORDER:     return ((const    Order*)obj)->index + 1;
 		case REF_ROADSTOPS: return ((const RoadStop*)obj)->index + 1;
 		case REF_ENGINE_RENEWS:  return ((const       EngineRenew*)obj)->index + 1;
 		case REF_CARGO_PACKET:   return ((const       CargoPacket*)obj)->index + 1;
@@ -1228,7 +1227,7 @@ static void *IntToReference(size_t index, SLRefType rt)
 			SlErrorCorrupt("Referencing invalid OrderList");
 
 		case REF_ORDER:
-			if (Order::IsValidID(index)) return Order::Get(index);
+			if (OldOrderSaveLoadItem *item = GetOldOrder(index); item != nullptr) return item;
 			/* in old versions, invalid order was used to mark end of order list */
 			if (IsSavegameVersionBefore(SLV_5, 2)) return nullptr;
 			SlErrorCorrupt("Referencing invalid Order");
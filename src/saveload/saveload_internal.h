@@ -58,4 +58,16 @@ CompanyManagerFace ConvertFromOldCompanyManagerFace(uint32_t face);
 
 Order UnpackOldOrder(uint16_t packed);
 
+/** An order of a savegame from before orders were stored in their order list, when orders were linked into chains. */
+struct OldOrderSaveLoadItem {
+	uint32_t next = 0; ///< Index of the next order in the chain plus one, or 0 at the end of the chain.
+	Order order{}; ///< The order.
+};
+
+OldOrderSaveLoadItem &AllocateOldOrder(size_t index);
+OldOrderSaveLoadItem *GetOldOrder(size_t index);
+std::vector<Order> GetOrdersFromOldChain(const OldOrderSaveLoadItem *first);
+std::vector<Order> GetOrdersFromOldChain(uint32_t first);
+void ClearOldOrders();
+
 #endif /* SAVELOAD_INTERNAL_H */
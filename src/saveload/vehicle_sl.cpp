@@ -11,6 +11,7 @@
 
 #include "saveload.h"
 #include "compat/vehicle_sl_compat.h"
+#include "saveload_internal.h"
 
 #include "../debug.h"
 #include "../vehicle_func.h"
@@ -274,7 +275,7 @@ void AfterLoadVehiclesPhase1(bool part_of_load)
 		 * a) both next_shared and previous_shared are not set for pre 5,2 games
 		 * b) both next_shared and previous_shared are set for later games
 		 */
-		std::map<Order*, OrderList*> mapping;
+		std::map<OldOrderSaveLoadItem *, OrderList *> mapping;
 
 		for (Vehicle *v : Vehicle::Iterate()) {
 			if (v->old_orders != nullptr) {
@@ -286,7 +287,8 @@ void AfterLoadVehiclesPhase1(bool part_of_load)
 						 * allowed in these savegames matches the number of OrderLists. As
 						 * such each vehicle can get an OrderList and it will (still) fit. */
 						assert(OrderList::CanAllocateItem());
-						v->orders = mapping[v->old_orders] = new OrderList(v->old_orders, v);
+						OldOrderSaveLoadItem *old_orders = v->old_orders;
+						v->orders = mapping[old_orders] = new OrderList(GetOrdersFromOldChain(old_orders), v);
 					} else {
 						v->orders = mapping[v->old_orders];
 						/* For old games (case a) we must create the shared vehicle chain */
@@ -296,11 +298,14 @@ void AfterLoadVehiclesPhase1(bool part_of_load)
 					}
 				} else { // OrderList was saved as such, only recalculate not saved values
 					if (v->PreviousShared() == nullptr) {
-						v->orders->Initialize(v->orders->first, v);
+						v->orders->Initialize(v);
 					}
 				}
 			}
 		}
+
+		/* All orders of old savegames have been moved to their order list. */
+		ClearOldOrders();
 	}
 
 	for (Vehicle *v : Vehicle::Iterate()) {
@@ -320,7 +325,7 @@ void AfterLoadVehiclesPhase1(bool part_of_load)
 
 				/* As above, allocating OrderList here is safe. */
 				assert(OrderList::CanAllocateItem());
-				v->orders = new OrderList(nullptr, v);
+				v->orders = new OrderList({}, v);
 				for (Vehicle *u = v; u != nullptr; u = u->next_shared) {
 					u->orders = v->orders;
 				}
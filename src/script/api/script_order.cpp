@@ -67,15 +67,12 @@ static const Order *ResolveOrder(VehicleID vehicle_id, ScriptOrder::OrderPositio
 		order_position = ScriptOrder::ResolveOrderPosition(vehicle_id, order_position);
 		if (order_position == ScriptOrder::ORDER_INVALID) return nullptr;
 	}
-	const Order *order = v->GetFirstOrder();
-	assert(order != nullptr);
-	while (order->GetType() == OT_IMPLICIT) order = order->next;
-	while (order_position > 0) {
+	for (const Order *order : v->Orders()) {
+		if (order->GetType() == OT_IMPLICIT) continue;
+		if (order_position == 0) return order;
 		order_position = (ScriptOrder::OrderPosition)(order_position - 1);
-		order = order->next;
-		while (order->GetType() == OT_IMPLICIT) order = order->next;
 	}
-	return order;
+	NOT_REACHED();
 }
 
 /**
@@ -91,14 +88,13 @@ static int ScriptOrderPositionToRealOrderPosition(VehicleID vehicle_id, ScriptOr
 
 	assert(ScriptOrder::IsValidVehicleOrder(vehicle_id, order_position));
 
-	int res = (int)order_position;
-	const Order *order = v->orders->GetFirstOrder();
-	assert(order != nullptr);
-	for (; order->GetType() == OT_IMPLICIT; order = order->next) res++;
-	while (order_position > 0) {
-		order_position = (ScriptOrder::OrderPosition)(order_position - 1);
-		order = order->next;
-		for (; order->GetType() == OT_IMPLICIT; order = order->next) res++;
+	int res = 0;
+	for (const Order *order : v->Orders()) {
+		if (order->GetType() != OT_IMPLICIT) {
+			if (order_position == 0) break;
+			order_position = (ScriptOrder::OrderPosition)(order_position - 1);
+		}
+		res++;
 	}
 
 	return res;
@@ -111,12 +107,10 @@ static int ScriptOrderPositionToRealOrderPosition(VehicleID vehicle_id, ScriptOr
  */
 static ScriptOrder::OrderPosition RealOrderPositionToScriptOrderPosition(VehicleID vehicle_id, int order_position)
 {
-	const Order *order = ::Vehicle::Get(vehicle_id)->GetFirstOrder();
-	assert(order != nullptr);
+	const Vehicle *v = ::Vehicle::Get(vehicle_id);
 	int num_implicit_orders = 0;
 	for (int i = 0; i < order_position; i++) {
-		if (order->GetType() == OT_IMPLICIT) num_implicit_orders++;
-		order = order->next;
+		if (v->GetOrder(i)->GetType() == OT_IMPLICIT) num_implicit_orders++;
 	}
 	return static_cast<ScriptOrder::OrderPosition>(order_position - num_implicit_orders);
 }
@@ -41,7 +41,7 @@ ScriptVehicleList_Station::ScriptVehicleList_Station(StationID station_id)
 	bool is_deity = ScriptCompanyMode::IsDeity();
 	::CompanyID owner = ScriptObject::GetCompany();
 
-	FindVehiclesWithOrder(
+	FindVehiclesWithOrder(OrderDestinationKind::Station, station_id,
 		[is_deity, owner](const Vehicle *v) { return is_deity || v->owner == owner; },
 		[station_id](const Order *order) { return (order->IsType(OT_GOTO_STATION) || order->IsType(OT_GOTO_WAYPOINT)) && order->GetDestination() == station_id; },
 		[this](const Vehicle *v) { this->AddItem(v->index.base()); }
@@ -88,7 +88,7 @@ ScriptVehicleList_Depot::ScriptVehicleList_Depot(TileIndex tile)
 	bool is_deity = ScriptCompanyMode::IsDeity();
 	::CompanyID owner = ScriptObject::GetCompany();
 
-	FindVehiclesWithOrder(
+	FindVehiclesWithOrder(OrderDestinationKind::Depot, dest,
 		[is_deity, owner, type](const Vehicle *v) { return (is_deity || v->owner == owner) && v->type == type; },
 		[dest](const Order *order) { return order->IsType(OT_GOTO_DEPOT) && order->GetDestination() == dest; },
 		[this](const Vehicle *v) { this->AddItem(v->index.base()); }
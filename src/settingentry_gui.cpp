@@ -901,6 +901,8 @@ SettingsContainer &GetSettingsTree()
 				industries->Add(new SettingEntry("economy.multiple_industry_per_town"));
 				industries->Add(new SettingEntry("game_creation.oil_refinery_limit"));
 				industries->Add(new SettingEntry("economy.type"));
+				industries->Add(new SettingEntry("economy.spread_monthly_loop"));
+				industries->Add(new SettingEntry("economy.parallel_industry_production"));
 				industries->Add(new SettingEntry("station.serve_neutral_industries"));
 			}
 
@@ -308,6 +308,7 @@ struct NewsSettings {
 /** All settings related to the network. */
 struct NetworkSettings {
 	uint16_t      sync_freq;                                ///< how often do we check whether we are still in-sync
+	bool        sync_state_hash;                          ///< also check the hash of the game state when checking whether we are still in-sync
 	uint8_t       frame_freq;                               ///< how often do we send commands to the clients
 	uint16_t      commands_per_frame;                       ///< how many commands may be sent each frame_freq frames?
 	uint16_t      commands_per_frame_server;                ///< how many commands may be sent each frame_freq frames? (server-originating commands)
@@ -545,6 +546,8 @@ struct EconomySettings {
 	uint16_t minutes_per_calendar_year;      ///< minutes per calendar year. Special value 0 means that calendar time is frozen.
 	uint16_t town_cargo_scale;               ///< scale cargo production of towns by this percentage.
 	uint16_t industry_cargo_scale;           ///< scale cargo production of industries by this percentage.
+	bool   spread_monthly_loop;              ///< spread the monthly updates of industries and towns over the days of the month.
+	bool   parallel_industry_production;     ///< run the production callbacks of industries in parallel.
 };
 
 struct LinkGraphSettings {
@@ -14,6 +14,7 @@
 #include "news_func.h"
 #include "company_func.h"
 #include "depot_base.h"
+#include "depot_kdtree.h"
 #include "station_base.h"
 #include "newgrf_engine.h"
 #include "pathfinder/yapf/yapf.h"
@@ -157,48 +158,42 @@ static const Depot *FindClosestShipDepot(const Vehicle *v, uint max_distance)
 	visited_patch_hashes.clear();
 	patches_to_search.clear();
 
-	/* Step 1: find a set of reachable Water Region Patches using BFS. */
-	const WaterRegionPatchDesc start_patch = GetWaterRegionPatchInfo(v->tile);
-	patches_to_search.push_back(start_patch);
-	visited_patch_hashes.insert(CalculateWaterRegionPatchHash(start_patch));
-
-	while (!patches_to_search.empty()) {
-		/* Remove first patch from the queue and make it the current patch. */
-		const WaterRegionPatchDesc current_node = patches_to_search.front();
-		patches_to_search.pop_front();
-
-		/* Add neighbours of the current patch to the search queue. */
-		TVisitWaterRegionPatchCallBack visitFunc = [&](const WaterRegionPatchDesc &water_region_patch) {
-			/* Note that we check the max distance per axis, not the total distance. */
-			if (std::abs(water_region_patch.x - start_patch.x) > max_region_distance ||
-					std::abs(water_region_patch.y - start_patch.y) > max_region_distance) return;
-
-			const int hash = CalculateWaterRegionPatchHash(water_region_patch);
-			if (visited_patch_hashes.count(hash) == 0) {
-				visited_patch_hashes.insert(hash);
-				patches_to_search.push_back(water_region_patch);
-			}
-		};
-
-		VisitWaterRegionPatchNeighbours(current_node, visitFunc);
-	}
+	/* Step 1: find a set of reachable Water Region Patches using BFS.
+	 * This is only done once there is a depot within range to check. */
+	auto find_reachable_patches = [&]() {
+		const WaterRegionPatchDesc start_patch = GetWaterRegionPatchInfo(v->tile);
+		patches_to_search.push_back(start_patch);
+		visited_patch_hashes.insert(CalculateWaterRegionPatchHash(start_patch));
+
+		while (!patches_to_search.empty()) {
+			/* Remove first patch from the queue and make it the current patch. */
+			const WaterRegionPatchDesc current_node = patches_to_search.front();
+			patches_to_search.pop_front();
+
+			/* Add neighbours of the current patch to the search queue. */
+			TVisitWaterRegionPatchCallBack visitFunc = [&](const WaterRegionPatchDesc &water_region_patch) {
+				/* Note that we check the max distance per axis, not the total distance. */
+				if (std::abs(water_region_patch.x - start_patch.x) > max_region_distance ||
+						std::abs(water_region_patch.y - start_patch.y) > max_region_distance) return;
+
+				const int hash = CalculateWaterRegionPatchHash(water_region_patch);
+				if (visited_patch_hashes.count(hash) == 0) {
+					visited_patch_hashes.insert(hash);
+					patches_to_search.push_back(water_region_patch);
+				}
+			};
 
-	/* Step 2: Find the closest depot within the reachable Water Region Patches. */
-	const Depot *best_depot = nullptr;
-	uint best_dist_sq = std::numeric_limits<uint>::max();
-	for (const Depot *depot : Depot::Iterate()) {
-		const TileIndex tile = depot->xy;
-		if (IsShipDepotTile(tile) && IsTileOwner(tile, v->owner)) {
-			const uint dist_sq = DistanceSquare(tile, v->tile);
-			if (dist_sq < best_dist_sq && dist_sq <= max_distance * max_distance &&
-					visited_patch_hashes.count(CalculateWaterRegionPatchHash(GetWaterRegionPatchInfo(tile))) > 0) {
-				best_dist_sq = dist_sq;
-				best_depot = depot;
-			}
+			VisitWaterRegionPatchNeighbours(current_node, visitFunc);
 		}
-	}
+	};
+
+	/* Step 2: Find the closest depot of the owner within the reachable Water Region Patches. */
+	DepotID best_depot = FindNearestInKdtree(_depot_kdtrees[v->owner][VEH_SHIP], v->tile, max_distance, [&](DepotID depot) {
+		if (visited_patch_hashes.empty()) find_reachable_patches();
+		return visited_patch_hashes.count(CalculateWaterRegionPatchHash(GetWaterRegionPatchInfo(Depot::Get(depot)->xy))) > 0;
+	});
 
-	return best_depot;
+	return Depot::GetIfValid(best_depot);
 }
 
 static void CheckIfShipNeedsService(Vehicle *v)
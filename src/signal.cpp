@@ -20,14 +20,6 @@
 #include "safeguards.h"
 
 
-/** these are the maximums used for updating signal blocks */
-static const uint SIG_TBU_SIZE    =  64; ///< number of signals entering to block
-static const uint SIG_TBD_SIZE    = 256; ///< number of intersections - open nodes in current block
-static const uint SIG_GLOB_SIZE   = 128; ///< number of open blocks (block can be opened more times until detected)
-static const uint SIG_GLOB_UPDATE =  64; ///< how many items need to be in _globset to force update
-
-static_assert(SIG_GLOB_UPDATE <= SIG_GLOB_SIZE);
-
 /** incidating trackbits with given enterdir */
 static const TrackBits _enterdir_to_trackbits[DIAGDIR_END] = {
 	TRACK_BIT_3WAY_NE,
@@ -45,87 +37,87 @@ static const TrackdirBits _enterdir_to_trackdirbits[DIAGDIR_END] = {
 };
 
 /**
- * Set containing 'items' items of 'tile and Tdir'
- * No tree structure is used because it would cause
- * slowdowns in most usual cases
+ * Set containing items of 'tile and Tdir', growing as needed.
+ * Small sets are searched linearly, as a tree or hash structure would cause
+ * slowdowns in most usual cases. Large sets, as made by long signal blocks or
+ * many changes in a single tick, get an index so they are not searched linearly.
  */
-template <typename Tdir, uint items>
-struct SmallSet {
+template <typename Tdir>
+class SignalSet {
 private:
-	uint n;           // actual number of units
-	bool overflowed;  // did we try to overflow the set?
-	const char *name; // name, used for debugging purposes...
+	/** Number of items above which the index is used. */
+	static constexpr size_t INDEX_THRESHOLD = 64;
 
 	/** Element of set */
 	struct SSdata {
 		TileIndex tile;
 		Tdir dir;
-	} data[items];
 
-public:
-	/** Constructor - just set default values and 'name' */
-	SmallSet(const char *name) : n(0), overflowed(false), name(name) { }
+		bool operator==(const SSdata &other) const = default;
+	};
 
-	/** Reset variables to default values */
-	void Reset()
-	{
-		this->n = 0;
-		this->overflowed = false;
-	}
+	std::vector<SSdata> data; ///< The items, the last one is returned first by #Get.
+	std::unordered_map<uint64_t, size_t> index; ///< Position of each item in #data, only valid when #indexed.
+	bool indexed = false; ///< Whether #index is in use.
 
 	/**
-	 * Returns value of 'overflowed'
-	 * @return did we try to overflow the set?
+	 * Find the position of an item.
+	 * @param tile tile
+	 * @param dir dir
+	 * @return The position in #data, or SIZE_MAX when the item is not in the set.
 	 */
-	bool Overflowed()
+	size_t Find(TileIndex tile, Tdir dir) const
 	{
-		return this->overflowed;
-	}
+		if (this->indexed) {
+			auto it = this->index.find(Key(tile, dir));
+			return it == this->index.end() ? SIZE_MAX : it->second;
+		}
 
-	/**
-	 * Checks for empty set
-	 * @return is the set empty?
-	 */
-	bool IsEmpty()
-	{
-		return this->n == 0;
+		for (size_t i = 0; i < this->data.size(); i++) {
+			if (this->data[i].tile == tile && this->data[i].dir == dir) return i;
+		}
+		return SIZE_MAX;
 	}
 
+public:
 	/**
-	 * Checks for full set
-	 * @return is the set full?
+	 * Get the key of an item, unique for each tile and dir.
+	 * @param tile tile
+	 * @param dir dir
+	 * @return The key.
 	 */
-	bool IsFull()
+	static inline uint64_t Key(TileIndex tile, Tdir dir)
 	{
-		return this->n == lengthof(data);
+		return static_cast<uint64_t>(tile.base()) << 8 | static_cast<uint8_t>(dir);
 	}
 
 	/**
-	 * Reads the number of items
-	 * @return current number of items
+	 * Checks for empty set
+	 * @return is the set empty?
 	 */
-	uint Items()
+	bool IsEmpty() const
 	{
-		return this->n;
+		return this->data.empty();
 	}
 
-
 	/**
-	 * Tries to remove first instance of given tile and dir
+	 * Tries to remove given tile and dir
 	 * @param tile tile
 	 * @param dir and dir to remove
 	 * @return element was found and removed
 	 */
 	bool Remove(TileIndex tile, Tdir dir)
 	{
-		for (uint i = 0; i < this->n; i++) {
-			if (this->data[i].tile == tile && this->data[i].dir == dir) {
-				this->data[i] = this->data[--this->n];
-				return true;
-			}
-		}
+		size_t i = this->Find(tile, dir);
+		if (i == SIZE_MAX) return false;
 
-		return false;
+		if (this->indexed) {
+			this->index.erase(Key(tile, dir));
+			if (i != this->data.size() - 1) this->index[Key(this->data.back().tile, this->data.back().dir)] = i;
+		}
+		this->data[i] = this->data.back();
+		this->data.pop_back();
+		return true;
 	}
 
 	/**
@@ -134,35 +126,28 @@ public:
 	 * @param dir and dir to find
 	 * @return true iff the tile & dir element was found
 	 */
-	bool IsIn(TileIndex tile, Tdir dir)
+	bool IsIn(TileIndex tile, Tdir dir) const
 	{
-		for (uint i = 0; i < this->n; i++) {
-			if (this->data[i].tile == tile && this->data[i].dir == dir) return true;
-		}
-
-		return false;
+		return this->Find(tile, dir) != SIZE_MAX;
 	}
 
 	/**
-	 * Adds tile & dir into the set, checks for full set
-	 * Sets the 'overflowed' flag if the set was full
+	 * Adds tile & dir into the set, unless it is already in there.
 	 * @param tile tile
 	 * @param dir and dir to add
-	 * @return true iff the item could be added (set wasn't full)
 	 */
-	bool Add(TileIndex tile, Tdir dir)
+	void Add(TileIndex tile, Tdir dir)
 	{
-		if (this->IsFull()) {
-			overflowed = true;
-			Debug(misc, 0, "SignalSegment too complex. Set {} is full (maximum {})", name, items);
-			return false; // set is full
-		}
+		if (this->IsIn(tile, dir)) return;
 
-		this->data[this->n].tile = tile;
-		this->data[this->n].dir = dir;
-		this->n++;
+		this->data.emplace_back(tile, dir);
 
-		return true;
+		if (this->indexed) {
+			this->index[Key(tile, dir)] = this->data.size() - 1;
+		} else if (this->data.size() > INDEX_THRESHOLD) {
+			for (size_t i = 0; i < this->data.size(); i++) this->index[Key(this->data[i].tile, this->data[i].dir)] = i;
+			this->indexed = true;
+		}
 	}
 
 	/**
@@ -173,19 +158,39 @@ public:
 	 */
 	bool Get(TileIndex *tile, Tdir *dir)
 	{
-		if (this->n == 0) return false;
+		if (this->data.empty()) return false;
 
-		this->n--;
-		*tile = this->data[this->n].tile;
-		*dir = this->data[this->n].dir;
+		*tile = this->data.back().tile;
+		*dir = this->data.back().dir;
+		this->data.pop_back();
+
+		if (this->data.empty()) {
+			this->index.clear();
+			this->indexed = false;
+		} else if (this->indexed) {
+			this->index.erase(Key(*tile, *dir));
+		}
 
 		return true;
 	}
+
+	auto begin() const { return this->data.begin(); }
+	auto end() const { return this->data.end(); }
+
+	/**
+	 * Compare the items of two sets, including the order in which #Get returns them.
+	 * @param other The other set.
+	 * @return True iff both sets have the same items in the same order.
+	 */
+	bool operator==(const SignalSet &other) const
+	{
+		return this->data == other.data;
+	}
 };
 
-static SmallSet<Trackdir, SIG_TBU_SIZE> _tbuset("_tbuset");         ///< set of signals that will be updated
-static SmallSet<DiagDirection, SIG_TBD_SIZE> _tbdset("_tbdset");    ///< set of open nodes in current signal block
-static SmallSet<DiagDirection, SIG_GLOB_SIZE> _globset("_globset"); ///< set of places to be updated in following runs
+static SignalSet<Trackdir> _tbuset;      ///< set of signals that will be updated
+static SignalSet<DiagDirection> _tbdset; ///< set of open nodes in current signal block
+static SignalSet<DiagDirection> _globset; ///< set of places to be updated in following runs
 
 
 /** Check whether there is a train on rail, not in a depot */
@@ -196,6 +201,67 @@ static Vehicle *TrainOnTileEnum(Vehicle *v, void *)
 	return v;
 }
 
+/** Check whether there is a train on some tracks, like #EnsureNoTrainOnTrackBits */
+static Vehicle *TrainOnTrackBitsEnum(Vehicle *v, void *data)
+{
+	TrackBits tracks = *(TrackBits *)data;
+	TrackBits train_tracks = Train::From(v)->track;
+
+	if (train_tracks != tracks && !TracksOverlap(train_tracks | tracks)) return nullptr;
+
+	return v;
+}
+
+/**
+ * Check whether there is a train on a tile of a signal block.
+ * Trains are looked for at the tiles they are listed at in the vehicle tile hash,
+ * as that is where the trains in recorded signal blocks are counted.
+ * @param tile The tile.
+ * @param tracks The tracks of the block on the tile, or #TRACK_BIT_NONE when the whole tile is part of the block.
+ * @return True iff a train is found.
+ */
+static bool IsTrainOnSignalBlockTile(TileIndex tile, TrackBits tracks)
+{
+	if (tracks == TRACK_BIT_NONE) return HasVehicleInTileHash(tile, VEH_TRAIN, nullptr, &TrainOnTileEnum);
+	return HasVehicleInTileHash(tile, VEH_TRAIN, &tracks, &TrainOnTrackBitsEnum);
+}
+
+
+/** Current signal block state flags */
+enum class SigFlag : uint8_t {
+	Train, ///< train found in segment
+	Exit, ///< exitsignal found
+	MultiExit, ///< two or more exits found
+	Green, ///< green exitsignal found
+	MultiGreen, ///< two or more green exits found
+	Pbs, ///< pbs signal found
+	Split, ///< track merge/split found
+	Enter, ///< signal entering the block found
+	MultiEnter, ///< two or more signals entering the block found
+};
+using SigFlags = EnumBitSet<SigFlag, uint16_t>;
+
+/**
+ * Recorded exploration of a signal block, starting at a place from the Global set.
+ * As exploring only depends on the rail layout, the recording stays valid until the layout changes.
+ * The signal states and trains in the block are looked at each time the recording is used.
+ */
+struct SignalBlock {
+	SigFlags flags{}; ///< Flags of the block, except for the ones about trains and green exits.
+	std::vector<std::pair<TileIndex, Trackdir>> signals; ///< Signals around the block, in the order they were found.
+	std::vector<std::pair<TileIndex, Trackdir>> exits; ///< Presignal exits out of the block.
+	std::vector<std::pair<TileIndex, TrackBits>> tiles; ///< Tiles to look for trains on, with the tracks to look at or #TRACK_BIT_NONE for the whole tile.
+	std::unordered_map<uint64_t, uint> removed; ///< For each place removed from the Global set while exploring, the order in which it was first removed.
+	uint trains = 0; ///< Number of train parts listed in the vehicle tile hash at the tiles of the block.
+};
+
+/** Maximum number of recorded signal blocks, the recordings are thrown away when there are more. */
+static const size_t MAX_SIGNAL_BLOCKS = 1 << 16;
+
+static std::vector<SignalBlock> _signal_blocks; ///< Recorded signal blocks.
+static std::unordered_map<uint64_t, uint> _signal_block_index; ///< Index in #_signal_blocks by the place where the exploration started and the owner.
+static std::unordered_multimap<uint32_t, uint> _signal_block_tiles; ///< Indices in #_signal_blocks of the blocks at each tile.
+
 
 /**
  * Perform some operations before adding data into Todo set
@@ -208,13 +274,19 @@ static Vehicle *TrainOnTileEnum(Vehicle *v, void *)
  * @param d1 direction (tile side) we are entering
  * @param t2 tile we are leaving
  * @param d2 direction (tile side) we are leaving
+ * @param block block to record the removals from the Global set in, or nullptr
  * @return false iff reverse direction was in Todo set
  */
-static inline bool CheckAddToTodoSet(TileIndex t1, DiagDirection d1, TileIndex t2, DiagDirection d2)
+static inline bool CheckAddToTodoSet(TileIndex t1, DiagDirection d1, TileIndex t2, DiagDirection d2, SignalBlock *block)
 {
 	_globset.Remove(t1, d1); // it can be in Global but not in Todo
 	_globset.Remove(t2, d2); // remove in all cases
 
+	if (block != nullptr) {
+		block->removed.try_emplace(SignalSet<DiagDirection>::Key(t1, d1), static_cast<uint>(block->removed.size()));
+		block->removed.try_emplace(SignalSet<DiagDirection>::Key(t2, d2), static_cast<uint>(block->removed.size()));
+	}
+
 	assert(!_tbdset.IsIn(t1, d1)); // it really shouldn't be there already
 
 	return !_tbdset.Remove(t2, d2);
@@ -232,41 +304,30 @@ static inline bool CheckAddToTodoSet(TileIndex t1, DiagDirection d1, TileIndex t
  * @param d1 direction (tile side) we are entering
  * @param t2 tile we are leaving
  * @param d2 direction (tile side) we are leaving
- * @return false iff the Todo buffer would be overrun
+ * @param block block to record the removals from the Global set in, or nullptr
  */
-static inline bool MaybeAddToTodoSet(TileIndex t1, DiagDirection d1, TileIndex t2, DiagDirection d2)
+static inline void MaybeAddToTodoSet(TileIndex t1, DiagDirection d1, TileIndex t2, DiagDirection d2, SignalBlock *block)
 {
-	if (!CheckAddToTodoSet(t1, d1, t2, d2)) return true;
-
-	return _tbdset.Add(t1, d1);
+	if (CheckAddToTodoSet(t1, d1, t2, d2, block)) _tbdset.Add(t1, d1);
 }
 
-
-/** Current signal block state flags */
-enum class SigFlag : uint8_t {
-	Train, ///< train found in segment
-	Exit, ///< exitsignal found
-	MultiExit, ///< two or more exits found
-	Green, ///< green exitsignal found
-	MultiGreen, ///< two or more green exits found
-	Full, ///< some of buffers was full, do not continue
-	Pbs, ///< pbs signal found
-	Split, ///< track merge/split found
-	Enter, ///< signal entering the block found
-	MultiEnter, ///< two or more signals entering the block found
-};
-using SigFlags = EnumBitSet<SigFlag, uint16_t>;
-
 /**
  * Search signal block
  *
  * @param owner owner whose signals we are updating
+ * @param block block to record the exploration in, or nullptr
  * @return SigFlags
  */
-static SigFlags ExploreSegment(Owner owner)
+static SigFlags ExploreSegment(Owner owner, SignalBlock *block)
 {
 	SigFlags flags{};
 
+	/* Look for trains on a tile, and remember where to look when recording. */
+	auto check_train = [&flags, block](TileIndex tile, TrackBits tracks) {
+		if (block != nullptr) block->tiles.emplace_back(tile, tracks);
+		if (!flags.Test(SigFlag::Train) && IsTrainOnSignalBlockTile(tile, tracks)) flags.Set(SigFlag::Train);
+	};
+
 	TileIndex tile = INVALID_TILE; // Stop GCC from complaining about a possibly uninitialized variable (issue #8280).
 	DiagDirection enterdir = INVALID_DIAGDIR;
 
@@ -280,13 +341,13 @@ static SigFlags ExploreSegment(Owner owner)
 
 				if (IsRailDepot(tile)) {
 					if (enterdir == INVALID_DIAGDIR) { // from 'inside' - train just entered or left the depot
-						if (!flags.Test(SigFlag::Train) && HasVehicleOnPos(tile, nullptr, &TrainOnTileEnum)) flags.Set(SigFlag::Train);
+						check_train(tile, TRACK_BIT_NONE);
 						exitdir = GetRailDepotDirection(tile);
 						tile += TileOffsByDiagDir(exitdir);
 						enterdir = ReverseDiagDir(exitdir);
 						break;
 					} else if (enterdir == GetRailDepotDirection(tile)) { // entered a depot
-						if (!flags.Test(SigFlag::Train) && HasVehicleOnPos(tile, nullptr, &TrainOnTileEnum)) flags.Set(SigFlag::Train);
+						check_train(tile, TRACK_BIT_NONE);
 						continue;
 					} else {
 						continue;
@@ -300,10 +361,10 @@ static SigFlags ExploreSegment(Owner owner)
 				if (tracks == TRACK_BIT_HORZ || tracks == TRACK_BIT_VERT) { // there is exactly one incidating track, no need to check
 					tracks = tracks_masked;
 					/* If no train detected yet, and there is not no train -> there is a train -> set the flag */
-					if (!flags.Test(SigFlag::Train) && EnsureNoTrainOnTrackBits(tile, tracks).Failed()) flags. Set(SigFlag::Train);
+					check_train(tile, tracks);
 				} else {
 					if (tracks_masked == TRACK_BIT_NONE) continue; // no incidating track
-					if (!flags.Test(SigFlag::Train) && HasVehicleOnPos(tile, nullptr, &TrainOnTileEnum)) flags.Set(SigFlag::Train);
+					check_train(tile, TRACK_BIT_NONE);
 				}
 
 				/* Is this a track merge or split? */
@@ -323,17 +384,20 @@ static SigFlags ExploreSegment(Owner owner)
 							if (flags.Test(SigFlag::Enter)) flags.Set(SigFlag::MultiEnter);
 							flags.Set(SigFlag::Enter);
 
-							if (!_tbuset.Add(tile, reversedir)) return flags | SigFlag::Full;
+							_tbuset.Add(tile, reversedir);
 						}
 						if (HasSignalOnTrackdir(tile, trackdir) && !IsOnewaySignal(tile, track)) flags.Set(SigFlag::Pbs);
 
 						/* if it is a presignal EXIT in OUR direction and we haven't found 2 green exits yes, do special check */
-						if (!flags.Test(SigFlag::MultiGreen) && IsPresignalExit(tile, track) && HasSignalOnTrackdir(tile, trackdir)) { // found presignal exit
-							if (flags.Test(SigFlag::Exit)) flags.Set(SigFlag::MultiExit); // found two (or more) exits
-							flags.Set(SigFlag::Exit); // found at least one exit - allow for compiler optimizations
-							if (GetSignalStateByTrackdir(tile, trackdir) == SIGNAL_STATE_GREEN) { // found green presignal exit
-								if (flags.Test(SigFlag::Green)) flags.Set(SigFlag::MultiGreen);
-								flags.Set(SigFlag::Green);
+						if (IsPresignalExit(tile, track) && HasSignalOnTrackdir(tile, trackdir)) { // found presignal exit
+							if (block != nullptr) block->exits.emplace_back(tile, trackdir);
+							if (!flags.Test(SigFlag::MultiGreen)) {
+								if (flags.Test(SigFlag::Exit)) flags.Set(SigFlag::MultiExit); // found two (or more) exits
+								flags.Set(SigFlag::Exit); // found at least one exit - allow for compiler optimizations
+								if (GetSignalStateByTrackdir(tile, trackdir) == SIGNAL_STATE_GREEN) { // found green presignal exit
+									if (flags.Test(SigFlag::Green)) flags.Set(SigFlag::MultiGreen);
+									flags.Set(SigFlag::Green);
+								}
 							}
 						}
 
@@ -345,7 +409,7 @@ static SigFlags ExploreSegment(Owner owner)
 					if (dir != enterdir && (tracks & _enterdir_to_trackbits[dir])) { // any track incidating?
 						TileIndex newtile = tile + TileOffsByDiagDir(dir);  // new tile to check
 						DiagDirection newdir = ReverseDiagDir(dir); // direction we are entering from
-						if (!MaybeAddToTodoSet(newtile, newdir, tile, dir)) return flags | SigFlag::Full;
+						MaybeAddToTodoSet(newtile, newdir, tile, dir, block);
 					}
 				}
 
@@ -358,7 +422,7 @@ static SigFlags ExploreSegment(Owner owner)
 				if (DiagDirToAxis(enterdir) != GetRailStationAxis(tile)) continue; // different axis
 				if (IsStationTileBlocked(tile)) continue; // 'eye-candy' station tile
 
-				if (!flags.Test(SigFlag::Train) && HasVehicleOnPos(tile, nullptr, &TrainOnTileEnum)) flags.Set(SigFlag::Train);
+				check_train(tile, TRACK_BIT_NONE);
 				tile += TileOffsByDiagDir(exitdir);
 				break;
 
@@ -367,7 +431,7 @@ static SigFlags ExploreSegment(Owner owner)
 				if (GetTileOwner(tile) != owner) continue;
 				if (DiagDirToAxis(enterdir) == GetCrossingRoadAxis(tile)) continue; // different axis
 
-				if (!flags.Test(SigFlag::Train) && HasVehicleOnPos(tile, nullptr, &TrainOnTileEnum)) flags.Set(SigFlag::Train);
+				check_train(tile, TRACK_BIT_NONE);
 				tile += TileOffsByDiagDir(exitdir);
 				break;
 
@@ -377,13 +441,13 @@ static SigFlags ExploreSegment(Owner owner)
 				DiagDirection dir = GetTunnelBridgeDirection(tile);
 
 				if (enterdir == INVALID_DIAGDIR) { // incoming from the wormhole
-					if (!flags.Test(SigFlag::Train) && HasVehicleOnPos(tile, nullptr, &TrainOnTileEnum)) flags.Set(SigFlag::Train);
+					check_train(tile, TRACK_BIT_NONE);
 					enterdir = dir;
 					exitdir = ReverseDiagDir(dir);
 					tile += TileOffsByDiagDir(exitdir); // just skip to next tile
 				} else { // NOT incoming from the wormhole!
 					if (ReverseDiagDir(enterdir) != dir) continue;
-					if (!flags.Test(SigFlag::Train) && HasVehicleOnPos(tile, nullptr, &TrainOnTileEnum)) flags.Set(SigFlag::Train);
+					check_train(tile, TRACK_BIT_NONE);
 					tile = GetOtherTunnelBridgeEnd(tile); // just skip to exit tile
 					enterdir = INVALID_DIAGDIR;
 					exitdir = INVALID_DIAGDIR;
@@ -395,7 +459,7 @@ static SigFlags ExploreSegment(Owner owner)
 				continue; // continue the while() loop
 		}
 
-		if (!MaybeAddToTodoSet(tile, enterdir, oldtile, exitdir)) return flags | SigFlag::Full;
+		MaybeAddToTodoSet(tile, enterdir, oldtile, exitdir, block);
 	}
 
 	return flags;
@@ -450,7 +514,7 @@ static void UpdateSignalsAroundSegment(SigFlags flags)
 			if (IsPresignalExit(tile, TrackdirToTrack(trackdir))) {
 				/* for pre-signal exits, add block to the global set */
 				DiagDirection exitdir = TrackdirToExitdir(ReverseTrackdir(trackdir));
-				_globset.Add(tile, exitdir); // do not check for full global set, first update all signals
+				_globset.Add(tile, exitdir);
 			}
 			SetSignalStateByTrackdir(tile, trackdir, newstate);
 			MarkTileDirtyByTile(tile);
@@ -460,12 +524,176 @@ static void UpdateSignalsAroundSegment(SigFlags flags)
 }
 
 
-/** Reset all sets after one set overflowed */
-static inline void ResetSets()
+/**
+ * Add the places to start exploring a signal block from to the Todo set
+ *
+ * @param tile tile from the Global set
+ * @param dir direction from the Global set
+ * @return false iff there is no block to explore
+ */
+static bool AddSegmentStartToTodoSet(TileIndex tile, DiagDirection dir)
 {
-	_tbuset.Reset();
-	_tbdset.Reset();
-	_globset.Reset();
+	/* After updating signal, data stored are always MP_RAILWAY with signals.
+	 * Other situations happen when data are from outside functions -
+	 * modification of railbits (including both rail building and removal),
+	 * train entering/leaving block, train leaving depot...
+	 */
+	switch (GetTileType(tile)) {
+		case MP_TUNNELBRIDGE:
+			/* 'optimization assert' - do not try to update signals when it is not needed */
+			assert(GetTunnelBridgeTransportType(tile) == TRANSPORT_RAIL);
+			assert(dir == INVALID_DIAGDIR || dir == ReverseDiagDir(GetTunnelBridgeDirection(tile)));
+			_tbdset.Add(tile, INVALID_DIAGDIR);  // we can safely start from wormhole centre
+			_tbdset.Add(GetOtherTunnelBridgeEnd(tile), INVALID_DIAGDIR);
+			break;
+
+		case MP_RAILWAY:
+			if (IsRailDepot(tile)) {
+				/* 'optimization assert' do not try to update signals in other cases */
+				assert(dir == INVALID_DIAGDIR || dir == GetRailDepotDirection(tile));
+				_tbdset.Add(tile, INVALID_DIAGDIR); // start from depot inside
+				break;
+			}
+			[[fallthrough]];
+
+		case MP_STATION:
+		case MP_ROAD:
+			if ((TrackStatusToTrackBits(GetTileTrackStatus(tile, TRANSPORT_RAIL, 0)) & _enterdir_to_trackbits[dir]) != TRACK_BIT_NONE) {
+				/* only add to set when there is some 'interesting' track */
+				_tbdset.Add(tile, dir);
+				_tbdset.Add(tile + TileOffsByDiagDir(dir), ReverseDiagDir(dir));
+				break;
+			}
+			[[fallthrough]];
+
+		default:
+			/* jump to next tile */
+			tile = tile + TileOffsByDiagDir(dir);
+			dir = ReverseDiagDir(dir);
+			if ((TrackStatusToTrackBits(GetTileTrackStatus(tile, TRANSPORT_RAIL, 0)) & _enterdir_to_trackbits[dir]) != TRACK_BIT_NONE) {
+				_tbdset.Add(tile, dir);
+				break;
+			}
+			/* happens when removing a rail that wasn't connected at one or both sides */
+			return false;
+	}
+
+	assert(!_tbdset.IsEmpty()); // it wouldn't hurt anyone, but shouldn't happen too
+	return true;
+}
+
+
+/**
+ * Get the key of a recorded signal block
+ *
+ * @param tile tile from the Global set where the exploration starts
+ * @param dir direction from the Global set where the exploration starts
+ * @param owner owner whose signals we are updating
+ * @return the key in _signal_block_index
+ */
+static inline uint64_t GetSignalBlockKey(TileIndex tile, DiagDirection dir, Owner owner)
+{
+	return SignalSet<DiagDirection>::Key(tile, dir) << 8 | owner.base();
+}
+
+
+/**
+ * Record a new signal block, after it was explored
+ *
+ * @param key key of the block
+ * @param block the recorded exploration
+ */
+static void AddSignalBlock(uint64_t key, SignalBlock &&block)
+{
+	if (_signal_blocks.size() >= MAX_SIGNAL_BLOCKS) InvalidateSignalBlocks();
+
+	uint index = static_cast<uint>(_signal_blocks.size());
+
+	/* Count the trains at each tile of the block once, from now on they are counted as they move. */
+	std::vector<TileIndex> tiles;
+	for (const auto &[tile, tracks] : block.tiles) tiles.push_back(tile);
+	std::sort(tiles.begin(), tiles.end());
+	tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+	for (TileIndex tile : tiles) {
+		_signal_block_tiles.emplace(tile.base(), index);
+		block.trains += CountVehiclesInTileHash(tile, VEH_TRAIN);
+	}
+
+	_signal_blocks.push_back(std::move(block));
+	_signal_block_index[key] = index;
+}
+
+
+/**
+ * Use a recorded signal block instead of exploring it
+ * Does the same to the sets as exploring the block does
+ *
+ * @param block the recorded block
+ * @return SigFlags
+ */
+static SigFlags UseSignalBlock(const SignalBlock &block)
+{
+	/* Remove what exploring would remove from the Global set, in the same order. */
+	if (!_globset.IsEmpty()) {
+		std::vector<std::pair<uint, std::pair<TileIndex, DiagDirection>>> removed;
+		for (const auto &item : _globset) {
+			auto it = block.removed.find(SignalSet<DiagDirection>::Key(item.tile, item.dir));
+			if (it != block.removed.end()) removed.emplace_back(it->second, std::make_pair(item.tile, item.dir));
+		}
+		std::sort(removed.begin(), removed.end());
+		for (const auto &[order, item] : removed) _globset.Remove(item.first, item.second);
+	}
+
+	for (const auto &[tile, trackdir] : block.signals) _tbuset.Add(tile, trackdir);
+
+	SigFlags flags = block.flags;
+
+	for (const auto &[tile, trackdir] : block.exits) {
+		if (GetSignalStateByTrackdir(tile, trackdir) == SIGNAL_STATE_GREEN) {
+			if (flags.Test(SigFlag::Green)) flags.Set(SigFlag::MultiGreen);
+			flags.Set(SigFlag::Green);
+		}
+	}
+
+	/* Without train parts at the tiles of the block, there cannot be a train in it. */
+	if (block.trains > 0) {
+		for (const auto &[tile, tracks] : block.tiles) {
+			if (IsTrainOnSignalBlockTile(tile, tracks)) {
+				flags.Set(SigFlag::Train);
+				break;
+			}
+		}
+	}
+
+	return flags;
+}
+
+
+/**
+ * Check a recorded signal block against exploring it again
+ *
+ * @param tile tile from the Global set where the exploration starts
+ * @param dir direction from the Global set where the exploration starts
+ * @param owner owner whose signals we are updating
+ * @param flags SigFlags from the recorded block
+ * @param globset the Global set before the recorded block was used
+ * @return SigFlags from exploring the block
+ */
+static SigFlags CheckSignalBlock(TileIndex tile, DiagDirection dir, Owner owner, SigFlags flags, SignalSet<DiagDirection> &&globset)
+{
+	SignalSet<Trackdir> tbuset;
+	std::swap(tbuset, _tbuset);
+	std::swap(globset, _globset);
+
+	SigFlags explored{};
+	if (AddSegmentStartToTodoSet(tile, dir)) explored = ExploreSegment(owner, nullptr);
+
+	if (explored != flags || !(_tbuset == tbuset) || !(_globset == globset)) {
+		Debug(desync, 2, "warning: signal block cache mismatch: tile {}, dir {}", tile.base(), to_underlying(dir));
+	}
+
+	/* Continue with the results of exploring. */
+	return explored;
 }
 
 
@@ -490,72 +718,38 @@ static SigSegState UpdateSignalsInBuffer(Owner owner)
 		assert(_tbuset.IsEmpty());
 		assert(_tbdset.IsEmpty());
 
-		/* After updating signal, data stored are always MP_RAILWAY with signals.
-		 * Other situations happen when data are from outside functions -
-		 * modification of railbits (including both rail building and removal),
-		 * train entering/leaving block, train leaving depot...
-		 */
-		switch (GetTileType(tile)) {
-			case MP_TUNNELBRIDGE:
-				/* 'optimization assert' - do not try to update signals when it is not needed */
-				assert(GetTunnelBridgeTransportType(tile) == TRANSPORT_RAIL);
-				assert(dir == INVALID_DIAGDIR || dir == ReverseDiagDir(GetTunnelBridgeDirection(tile)));
-				_tbdset.Add(tile, INVALID_DIAGDIR);  // we can safely start from wormhole centre
-				_tbdset.Add(GetOtherTunnelBridgeEnd(tile), INVALID_DIAGDIR);
-				break;
-
-			case MP_RAILWAY:
-				if (IsRailDepot(tile)) {
-					/* 'optimization assert' do not try to update signals in other cases */
-					assert(dir == INVALID_DIAGDIR || dir == GetRailDepotDirection(tile));
-					_tbdset.Add(tile, INVALID_DIAGDIR); // start from depot inside
-					break;
-				}
-				[[fallthrough]];
+		SigFlags flags;
+		uint64_t key = GetSignalBlockKey(tile, dir, owner);
+		auto it = _signal_block_index.find(key);
+		if (it != _signal_block_index.end()) {
+			if (_debug_desync_level >= 2) {
+				SignalSet<DiagDirection> globset = _globset;
+				flags = CheckSignalBlock(tile, dir, owner, UseSignalBlock(_signal_blocks[it->second]), std::move(globset));
+			} else {
+				flags = UseSignalBlock(_signal_blocks[it->second]);
+			}
+		} else {
+			if (!AddSegmentStartToTodoSet(tile, dir)) continue;
 
-			case MP_STATION:
-			case MP_ROAD:
-				if ((TrackStatusToTrackBits(GetTileTrackStatus(tile, TRANSPORT_RAIL, 0)) & _enterdir_to_trackbits[dir]) != TRACK_BIT_NONE) {
-					/* only add to set when there is some 'interesting' track */
-					_tbdset.Add(tile, dir);
-					_tbdset.Add(tile + TileOffsByDiagDir(dir), ReverseDiagDir(dir));
-					break;
-				}
-				[[fallthrough]];
+			SignalBlock block;
+			flags = ExploreSegment(owner, &block);
 
-			default:
-				/* jump to next tile */
-				tile = tile + TileOffsByDiagDir(dir);
-				dir = ReverseDiagDir(dir);
-				if ((TrackStatusToTrackBits(GetTileTrackStatus(tile, TRANSPORT_RAIL, 0)) & _enterdir_to_trackbits[dir]) != TRACK_BIT_NONE) {
-					_tbdset.Add(tile, dir);
-					break;
-				}
-				/* happens when removing a rail that wasn't connected at one or both sides */
-				continue; // continue the while() loop
+			block.flags = flags;
+			block.flags.Reset({SigFlag::Train, SigFlag::Green, SigFlag::MultiGreen});
+			for (const auto &item : _tbuset) block.signals.emplace_back(item.tile, item.dir);
+			AddSignalBlock(key, std::move(block));
 		}
 
-		assert(!_tbdset.Overflowed()); // it really shouldn't overflow by these one or two items
-		assert(!_tbdset.IsEmpty()); // it wouldn't hurt anyone, but shouldn't happen too
-
-		SigFlags flags = ExploreSegment(owner);
-
 		if (first) {
 			first = false;
 			/* SIGSEG_FREE is set by default */
 			if (flags.Test(SigFlag::Pbs)) {
 				state = SIGSEG_PBS;
-			} else if (flags.Test(SigFlag::Train) || (flags.Test(SigFlag::Exit) && !flags.Test(SigFlag::Green)) || flags.Test(SigFlag::Full)) {
+			} else if (flags.Test(SigFlag::Train) || (flags.Test(SigFlag::Exit) && !flags.Test(SigFlag::Green))) {
 				state = SIGSEG_FULL;
 			}
 		}
 
-		/* do not do anything when some buffer was full */
-		if (flags.Test(SigFlag::Full)) {
-			ResetSets(); // free all sets
-			break;
-		}
-
 		UpdateSignalsAroundSegment(flags);
 	}
 
@@ -563,6 +757,43 @@ static SigSegState UpdateSignalsInBuffer(Owner owner)
 }
 
 
+/**
+ * Throw away all recorded signal blocks, so they are explored again.
+ * Must be called whenever the rail layout, or the owner of rail, changes.
+ */
+void InvalidateSignalBlocks()
+{
+	_signal_blocks.clear();
+	_signal_block_index.clear();
+	_signal_block_tiles.clear();
+}
+
+
+/**
+ * Update the number of train parts in the recorded signal blocks, after a train part is listed at another tile of the vehicle tile hash.
+ *
+ * @param from tile the train part was listed at, or INVALID_TILE
+ * @param to tile the train part is listed at now, or INVALID_TILE
+ */
+void MoveTrainInSignalBlocks(TileIndex from, TileIndex to)
+{
+	if (_signal_blocks.empty()) return;
+
+	if (from != INVALID_TILE) {
+		auto [begin, end] = _signal_block_tiles.equal_range(from.base());
+		for (auto it = begin; it != end; ++it) {
+			assert(_signal_blocks[it->second].trains > 0);
+			_signal_blocks[it->second].trains--;
+		}
+	}
+
+	if (to != INVALID_TILE) {
+		auto [begin, end] = _signal_block_tiles.equal_range(to.base());
+		for (auto it = begin; it != end; ++it) _signal_blocks[it->second].trains++;
+	}
+}
+
+
 static Owner _last_owner = INVALID_OWNER; ///< last owner whose track was put into _globset
 
 
@@ -602,12 +833,6 @@ void AddTrackToSignalBuffer(TileIndex tile, Track track, Owner owner)
 
 	_globset.Add(tile, _search_dir_1[track]);
 	_globset.Add(tile, _search_dir_2[track]);
-
-	if (_globset.Items() >= SIG_GLOB_UPDATE) {
-		/* too many items, force update */
-		UpdateSignalsInBuffer(_last_owner);
-		_last_owner = INVALID_OWNER;
-	}
 }
 
 
@@ -626,12 +851,6 @@ void AddSideToSignalBuffer(TileIndex tile, DiagDirection side, Owner owner)
 	_last_owner = owner;
 
 	_globset.Add(tile, side);
-
-	if (_globset.Items() >= SIG_GLOB_UPDATE) {
-		/* too many items, force update */
-		UpdateSignalsInBuffer(_last_owner);
-		_last_owner = INVALID_OWNER;
-	}
 }
 
 /**
@@ -57,5 +57,7 @@ void SetSignalsOnBothDir(TileIndex tile, Track track, Owner owner);
 void AddTrackToSignalBuffer(TileIndex tile, Track track, Owner owner);
 void AddSideToSignalBuffer(TileIndex tile, DiagDirection side, Owner owner);
 void UpdateSignalsInBuffer();
+void InvalidateSignalBlocks();
+void MoveTrainInSignalBlocks(TileIndex from, TileIndex to);
 
 #endif /* SIGNAL_FUNC_H */
@@ -0,0 +1,273 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file state_hash.cpp Hashing of the game state, to find where two games diverge. */
+
+#include "stdafx.h"
+#include "state_hash.h"
+#include "map_func.h"
+#include "company_base.h"
+#include "vehicle_base.h"
+#include "station_base.h"
+#include "town.h"
+#include "industry.h"
+#include "core/random_func.hpp"
+
+#include "safeguards.h"
+
+/** Names of the parts of the game state, as used in logs. */
+static const std::string_view _game_state_hash_part_names[] = {
+	"random",
+	"map",
+	"companies",
+	"vehicles",
+	"stations",
+	"towns",
+	"industries",
+};
+static_assert(lengthof(_game_state_hash_part_names) == GSHP_END);
+
+/**
+ * Get the name of a part of the game state.
+ * @param part The part.
+ * @return The name, as used in logs.
+ */
+std::string_view GetGameStateHashPartName(GameStateHashPart part)
+{
+	return _game_state_hash_part_names[part];
+}
+
+/**
+ * Get a single hash of the whole game state.
+ * @return The combined hash of all parts.
+ */
+uint64_t GameStateHash::GetCombined() const
+{
+	StateHasher hasher(GSHP_END);
+	for (uint64_t part : this->parts) hasher.Add(part);
+	return hasher.Get();
+}
+
+/**
+ * Hash the contents of a tile.
+ * @param index The tile.
+ * @return The hash.
+ */
+static uint64_t GetTileStateHash(TileIndex index)
+{
+	Tile tile(index);
+	return StateHasher(index.base())
+			.Add(tile.type() | tile.height() << 8 | tile.m1() << 16 | static_cast<uint64_t>(tile.m2()) << 24 | static_cast<uint64_t>(tile.m3()) << 40 | static_cast<uint64_t>(tile.m4()) << 48 | static_cast<uint64_t>(tile.m5()) << 56)
+			.Add(tile.m6() | tile.m7() << 8 | static_cast<uint64_t>(tile.m8()) << 16)
+			.Get();
+}
+
+/**
+ * Hash the state of the random generator.
+ * @return The hash.
+ */
+static uint64_t GetRandomStateHash()
+{
+	return StateHasher(0).Add(_random.state[0]).Add(_random.state[1]).Get();
+}
+
+/**
+ * Hash the state of a company.
+ * @param c The company.
+ * @return The hash.
+ */
+static uint64_t GetStateHash(const Company *c)
+{
+	return StateHasher(c->index.base())
+			.Add(static_cast<int64_t>(c->money))
+			.Add(c->money_fraction)
+			.Add(static_cast<int64_t>(c->current_loan))
+			.Add(c->months_of_bankruptcy)
+			.Get();
+}
+
+/**
+ * Hash the state of a vehicle.
+ * @param v The vehicle.
+ * @return The hash.
+ */
+static uint64_t GetStateHash(const Vehicle *v)
+{
+	return StateHasher(v->index.base())
+			.Add(v->type)
+			.Add(v->tile.base())
+			.Add(static_cast<uint32_t>(v->x_pos) | static_cast<uint64_t>(static_cast<uint32_t>(v->y_pos)) << 32)
+			.Add(static_cast<uint32_t>(v->z_pos) | static_cast<uint64_t>(v->direction) << 32)
+			.Add(v->cur_speed | v->subspeed << 16 | v->progress << 24 | static_cast<uint64_t>(v->vehstatus.base()) << 32)
+			.Add(v->current_order.GetType() | v->current_order.GetDestination().base() << 8)
+			.Add(v->cargo.StoredCount())
+			.Add(v->reliability | v->breakdown_ctr << 16)
+			.Add(static_cast<int64_t>(v->profit_this_year))
+			.Get();
+}
+
+/**
+ * Hash the state of a station.
+ * @param st The station.
+ * @return The hash.
+ */
+static uint64_t GetStateHash(const Station *st)
+{
+	StateHasher hasher(st->index.base());
+	hasher.Add(st->xy.base());
+	for (const GoodsEntry &ge : st->goods) {
+		hasher.Add(ge.rating | ge.time_since_pickup << 8 | static_cast<uint64_t>(ge.HasData() ? ge.GetData().cargo.TotalCount() : 0) << 16);
+	}
+	return hasher.Get();
+}
+
+/**
+ * Hash the state of a town.
+ * @param t The town.
+ * @return The hash.
+ */
+static uint64_t GetStateHash(const Town *t)
+{
+	return StateHasher(t->index.base())
+			.Add(t->xy.base())
+			.Add(t->cache.population)
+			.Add(t->grow_counter | t->growth_rate << 16)
+			.Get();
+}
+
+/**
+ * Hash the state of an industry.
+ * @param i The industry.
+ * @return The hash.
+ */
+static uint64_t GetStateHash(const Industry *i)
+{
+	StateHasher hasher(i->index.base());
+	hasher.Add(i->location.tile.base()).Add(i->prod_level | i->counter << 8 | static_cast<uint64_t>(i->random) << 24);
+	for (const Industry::ProducedCargo &p : i->produced) hasher.Add(p.cargo | p.waiting << 8 | p.rate << 24);
+	for (const Industry::AcceptedCargo &a : i->accepted) hasher.Add(a.cargo | a.waiting << 8);
+	return hasher.Get();
+}
+
+/**
+ * Add the hashes of a slice of the items of a pool to a hash.
+ * The slice consists of every item with an index equal to \a slice modulo \a slices,
+ * which does not depend on the allocated size of the pool.
+ * @tparam T The type of the items.
+ * @param[in,out] hash The hash to add to.
+ * @param slice The slice to hash.
+ * @param slices The number of slices.
+ */
+template <typename T>
+static void HashPoolSlice(uint64_t &hash, uint slice, uint slices)
+{
+	for (size_t index = slice; index < T::GetPoolSize(); index += slices) {
+		const T *item = T::GetIfValid(index);
+		if (item != nullptr) hash += GetStateHash(item);
+	}
+}
+
+/**
+ * Add the hashes of a slice of the game state to a hash.
+ * The random state is not included, as that is a snapshot rather than a sum.
+ * @param[in,out] hash The hash to add to.
+ * @param slice The slice to hash.
+ * @param slices The number of slices.
+ */
+static void HashGameStateSlice(GameStateHash &hash, uint slice, uint slices)
+{
+	uint tiles = Map::Size();
+	uint first = static_cast<uint>(static_cast<uint64_t>(tiles) * slice / slices);
+	uint last = static_cast<uint>(static_cast<uint64_t>(tiles) * (slice + 1) / slices);
+	for (uint i = first; i < last; i++) {
+		hash.parts[GSHP_MAP] += GetTileStateHash(TileIndex{i});
+	}
+
+	HashPoolSlice<Company>(hash.parts[GSHP_COMPANIES], slice, slices);
+	HashPoolSlice<Vehicle>(hash.parts[GSHP_VEHICLES], slice, slices);
+	HashPoolSlice<Station>(hash.parts[GSHP_STATIONS], slice, slices);
+	HashPoolSlice<Town>(hash.parts[GSHP_TOWNS], slice, slices);
+	HashPoolSlice<Industry>(hash.parts[GSHP_INDUSTRIES], slice, slices);
+}
+
+/**
+ * Compute the hash of the whole game state.
+ * This visits every tile and every item in the pools, so it is slow on large games.
+ * @return The hash, split by part of the game state.
+ */
+GameStateHash ComputeGameStateHash()
+{
+	GameStateHash result;
+	result.parts[GSHP_RANDOM] = GetRandomStateHash();
+	HashGameStateSlice(result, 0, 1);
+	return result;
+}
+
+static bool _state_hashing = false; ///< Whether the game state is hashed over the frames.
+static bool _state_hash_cycle_started = false; ///< Whether the current cycle was started from its first slice.
+static GameStateHash _state_hash_cycle{}; ///< Hash of the slices of the current cycle so far.
+static std::optional<CompletedGameStateHash> _last_state_hash{}; ///< The hash of the last complete cycle.
+
+/**
+ * Start or stop hashing the game state over the frames.
+ * Hashing starts with the next cycle, so the first hash is only available after up to two cycles.
+ * @param enable Whether to hash.
+ */
+void SetGameStateHashing(bool enable)
+{
+	if (enable == _state_hashing) return;
+
+	_state_hashing = enable;
+	_state_hash_cycle_started = false;
+	_last_state_hash.reset();
+}
+
+/**
+ * Check whether the game state is hashed over the frames.
+ * @return True iff hashing.
+ */
+bool IsGameStateHashing()
+{
+	return _state_hashing;
+}
+
+/**
+ * Hash the next slice of the game state, after a frame has been run.
+ * Every frame hashes a different slice, so after #GAME_STATE_HASH_CYCLE frames the whole
+ * game state has been hashed at a fraction of the cost per frame. As the game is in the
+ * same state at the same frame on all clients, their hashes are the same while in sync.
+ * @param frame The frame that has been run.
+ */
+void UpdateGameStateHash(uint32_t frame)
+{
+	if (!_state_hashing) return;
+
+	uint slice = frame % GAME_STATE_HASH_CYCLE;
+	if (slice == 0) {
+		_state_hash_cycle = {};
+		_state_hash_cycle_started = true;
+	}
+
+	/* A cycle that was joined halfway gives a hash that cannot be compared. */
+	if (!_state_hash_cycle_started) return;
+
+	HashGameStateSlice(_state_hash_cycle, slice, GAME_STATE_HASH_CYCLE);
+
+	if (slice == GAME_STATE_HASH_CYCLE - 1) {
+		_state_hash_cycle.parts[GSHP_RANDOM] = GetRandomStateHash();
+		_last_state_hash = CompletedGameStateHash{frame, _state_hash_cycle};
+	}
+}
+
+/**
+ * Get the hash of the last complete cycle of hashing the game state over the frames.
+ * @return The hash and the frame at which it was completed, or std::nullopt when no cycle has been completed.
+ */
+const std::optional<CompletedGameStateHash> &GetLastGameStateHash()
+{
+	return _last_state_hash;
+}
@@ -0,0 +1,97 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file state_hash.h Hashing of the game state, to find where two games diverge. */
+
+#ifndef STATE_HASH_H
+#define STATE_HASH_H
+
+/** Parts of the game state that are hashed separately. */
+enum GameStateHashPart : uint8_t {
+	GSHP_RANDOM,     ///< State of the game's random generator.
+	GSHP_MAP,        ///< Contents of all tiles.
+	GSHP_COMPANIES,  ///< Finances of the companies.
+	GSHP_VEHICLES,   ///< Positions, movement and cargo of vehicles.
+	GSHP_STATIONS,   ///< Cargo and ratings of stations.
+	GSHP_TOWNS,      ///< Population and growth of towns.
+	GSHP_INDUSTRIES, ///< Production of industries.
+	GSHP_END,        ///< End marker.
+};
+
+/** Hash of the game state, split by part of the game state. */
+struct GameStateHash {
+	std::array<uint64_t, GSHP_END> parts{}; ///< Hash of each part of the game state.
+
+	uint64_t GetCombined() const;
+
+	bool operator==(const GameStateHash &other) const = default;
+};
+
+/**
+ * Hasher for the state of a single item, such as a tile or a vehicle.
+ * The hash of a part of the game state is the sum of the hashes of its items,
+ * so the order in which items are visited does not matter.
+ */
+class StateHasher {
+public:
+	/**
+	 * Start hashing an item.
+	 * @param id Identification of the item, e.g. its index in the pool.
+	 */
+	explicit StateHasher(uint64_t id) : hash(Mix(id + 0x9E3779B97F4A7C15ULL)) {}
+
+	/**
+	 * Add a value of the item to the hash.
+	 * @param value The value.
+	 * @return This hasher.
+	 */
+	inline StateHasher &Add(uint64_t value)
+	{
+		this->hash = Mix(this->hash ^ value);
+		return *this;
+	}
+
+	/**
+	 * Get the hash of the item.
+	 * @return The hash.
+	 */
+	inline uint64_t Get() const { return this->hash; }
+
+	/**
+	 * Scramble the bits of a value (the finaliser of splitmix64).
+	 * @param x The value.
+	 * @return The scrambled value.
+	 */
+	static inline uint64_t Mix(uint64_t x)
+	{
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+		return x ^ (x >> 31);
+	}
+
+private:
+	uint64_t hash; ///< Hash so far.
+};
+
+/** Number of frames over which the game state is hashed incrementally. */
+static constexpr uint GAME_STATE_HASH_CYCLE = 64;
+
+/** Hash of the game state that was computed over a cycle of frames. */
+struct CompletedGameStateHash {
+	uint32_t frame; ///< Frame at which the last slice was hashed.
+	GameStateHash hash; ///< The hash.
+};
+
+std::string_view GetGameStateHashPartName(GameStateHashPart part);
+GameStateHash ComputeGameStateHash();
+
+void SetGameStateHashing(bool enable);
+bool IsGameStateHashing();
+void UpdateGameStateHash(uint32_t frame);
+const std::optional<CompletedGameStateHash> &GetLastGameStateHash();
+
+#endif /* STATE_HASH_H */
@@ -19,6 +19,7 @@
 #include "vehiclelist.h"
 #include "core/pool_func.hpp"
 #include "station_base.h"
+#include "station_func.h"
 #include "station_kdtree.h"
 #include "roadstop_base.h"
 #include "industry.h"
@@ -38,6 +39,118 @@ INSTANTIATE_POOL_METHODS(Station)
 
 StationKdtree _station_kdtree{};
 
+/** Size of the square regions of the map in the catchment index, in tiles. */
+static const uint CATCHMENT_INDEX_REGION_SIZE = 16;
+
+/** Stations whose catchment area overlaps a region of the map, for each region. */
+using CatchmentIndex = std::vector<std::vector<Station *>>;
+
+/** NOSAVE: Stations whose catchment area overlaps a region of the map, for each region. Rebuilt when catchments are recomputed. */
+static CatchmentIndex _catchment_index;
+
+/**
+ * Call a function on all regions of the catchment index that overlap an area.
+ * @param index The catchment index.
+ * @param area The area.
+ * @param func The function to call with the stations of each region.
+ */
+template <typename Func>
+static void ForAllCatchmentIndexRegions(CatchmentIndex &index, const TileArea &area, Func func)
+{
+	if (area.w == 0 || area.h == 0 || index.empty()) return;
+
+	uint regions_x = Map::SizeX() / CATCHMENT_INDEX_REGION_SIZE;
+	uint x0 = TileX(area.tile) / CATCHMENT_INDEX_REGION_SIZE;
+	uint y0 = TileY(area.tile) / CATCHMENT_INDEX_REGION_SIZE;
+	uint x1 = (TileX(area.tile) + area.w - 1) / CATCHMENT_INDEX_REGION_SIZE;
+	uint y1 = (TileY(area.tile) + area.h - 1) / CATCHMENT_INDEX_REGION_SIZE;
+	for (uint y = y0; y <= y1; y++) {
+		for (uint x = x0; x <= x1; x++) {
+			func(index[y * regions_x + x]);
+		}
+	}
+}
+
+/**
+ * Get an empty catchment index for the current map.
+ * @return The index.
+ */
+static CatchmentIndex GetEmptyCatchmentIndex()
+{
+	return CatchmentIndex((Map::SizeX() / CATCHMENT_INDEX_REGION_SIZE) * (Map::SizeY() / CATCHMENT_INDEX_REGION_SIZE));
+}
+
+/**
+ * Add a station to the regions of the catchment index its catchment area overlaps.
+ * @param st The station.
+ */
+static void AddToCatchmentIndex(Station *st)
+{
+	/* The map is only reallocated when there are no stations, so the index can be resized without losing anything. */
+	if (_catchment_index.size() != (Map::SizeX() / CATCHMENT_INDEX_REGION_SIZE) * (Map::SizeY() / CATCHMENT_INDEX_REGION_SIZE)) {
+		_catchment_index = GetEmptyCatchmentIndex();
+	}
+
+	ForAllCatchmentIndexRegions(_catchment_index, st->catchment_tiles, [st](std::vector<Station *> &region) {
+		region.push_back(st);
+	});
+}
+
+/**
+ * Remove a station from the regions of the catchment index its catchment area overlaps.
+ * @param st The station.
+ */
+static void RemoveFromCatchmentIndex(Station *st)
+{
+	ForAllCatchmentIndexRegions(_catchment_index, st->catchment_tiles, [st](std::vector<Station *> &region) {
+		auto it = std::ranges::find(region, st);
+		assert(it != region.end());
+		/* The order within a region does not matter, so do not move the other stations. */
+		*it = region.back();
+		region.pop_back();
+	});
+}
+
+/**
+ * Find the stations whose catchment area might contain a tile of an area.
+ * This only looks at the bounds of the catchment areas, so the individual tiles still need to be tested.
+ * @param ta The area.
+ * @param[out] stations The stations, sorted by index.
+ */
+void FindStationsWithCatchmentAround(const TileArea &ta, std::vector<Station *> &stations)
+{
+	stations.clear();
+	ForAllCatchmentIndexRegions(_catchment_index, ta, [&ta, &stations](std::vector<Station *> &region) {
+		for (Station *st : region) {
+			if (st->catchment_tiles.Intersects(ta)) stations.push_back(st);
+		}
+	});
+
+	/* A station can be in several regions, and callers expect a stable order. */
+	std::ranges::sort(stations, [](const Station *a, const Station *b) { return a->index < b->index; });
+	stations.erase(std::unique(stations.begin(), stations.end()), stations.end());
+}
+
+/** Check whether the catchment index still matches the catchment areas of the stations. */
+void CheckCatchmentIndex()
+{
+	if (_catchment_index.empty()) return;
+
+	CatchmentIndex expected = GetEmptyCatchmentIndex();
+	for (Station *st : Station::Iterate()) {
+		ForAllCatchmentIndexRegions(expected, st->catchment_tiles, [st](std::vector<Station *> &region) {
+			region.push_back(st);
+		});
+	}
+
+	for (size_t i = 0; i < expected.size(); i++) {
+		std::vector<Station *> region = _catchment_index[i];
+		std::ranges::sort(region);
+		std::ranges::sort(expected[i]);
+		if (region != expected[i]) Debug(desync, 2, "warning: catchment index mismatch: region {}", i);
+	}
+}
+
 void RebuildStationKdtree()
 {
 	std::vector<StationID> stids;
@@ -87,6 +200,8 @@ Station::~Station()
 			if (!ge.HasData()) continue;
 			ge.GetData().cargo.OnCleanPool();
 		}
+		InvalidateAllHouseTileStations();
+		_catchment_index.clear();
 		return;
 	}
 
@@ -131,6 +246,8 @@ Station::~Station()
 
 	/* Remove station from industries and towns that reference it. */
 	this->RemoveFromAllNearbyLists();
+	InvalidateHouseTileStations(this->catchment_tiles);
+	RemoveFromCatchmentIndex(this);
 
 	/* Clear the persistent storage. */
 	delete this->airport.psa;
@@ -464,8 +581,11 @@ bool Station::CatchmentCoversTown(TownID t) const
  */
 void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 {
+	this->acceptance_cache.valid = false;
+	InvalidateHouseTileStations(this->catchment_tiles);
 	this->industries_near.clear();
 	if (!no_clear_nearby_lists) this->RemoveFromAllNearbyLists();
+	RemoveFromCatchmentIndex(this);
 
 	if (this->rect.IsEmpty()) {
 		this->catchment_tiles.Reset();
@@ -480,6 +600,7 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 				this->catchment_tiles.SetTile(tile);
 			}
 		}
+		AddToCatchmentIndex(this);
 		/* The industry's stations_near may have been computed before its neutral station was built so clear and re-add here. */
 		for (Station *st : this->industry->stations_near) {
 			st->RemoveIndustryToDeliver(this->industry);
@@ -505,6 +626,9 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 		for (TileIndex tile2 : ta2) this->catchment_tiles.SetTile(tile2);
 	}
 
+	AddToCatchmentIndex(this);
+	InvalidateHouseTileStations(this->catchment_tiles);
+
 	/* Search catchment tiles for towns and industries */
 	BitmapTileIterator it(this->catchment_tiles);
 	for (TileIndex tile = it; tile != INVALID_TILE; tile = ++it) {
@@ -534,6 +658,7 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 {
 	for (Town *t : Town::Iterate()) { t->stations_near.clear(); }
 	for (Industry *i : Industry::Iterate()) { i->stations_near.clear(); }
+	InvalidateAllHouseTileStations();
 	for (Station *st : Station::Iterate()) { st->RecomputeCatchment(true); }
 }
 
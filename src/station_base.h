@@ -492,6 +492,20 @@ struct IndustryCompare {
 
 typedef std::set<IndustryListEntry, IndustryCompare> IndustryList;
 
+/**
+ * Running sums of the acceptance of the tiles in a station's catchment.
+ * They are updated whenever a tile in the catchment changes its acceptance, so the
+ * periodic acceptance update does not need to visit every tile of the catchment.
+ */
+struct StationAcceptanceCache {
+	CargoArray acceptance{}; ///< Acceptance in 1/8 of all tiles that do not decide their acceptance with NewGRF callbacks.
+	std::array<uint16_t, NUM_CARGO> always_accepted{}; ///< Number of those tiles that always accept each cargo type.
+	std::vector<TileIndex> callback_tiles{}; ///< Sorted tiles whose acceptance is decided by NewGRF callbacks, and thus has to be asked for each time.
+	bool valid = false; ///< Whether the sums match the current catchment.
+
+	bool operator==(const StationAcceptanceCache &other) const = default;
+};
+
 /** Station data structure */
 struct Station final : SpecializedStation<Station, false> {
 public:
@@ -514,6 +528,7 @@ public:
 	IndustryType indtype = IT_INVALID; ///< Industry type to get the name from
 
 	BitmapTileArea catchment_tiles{}; ///< NOSAVE: Set of individual tiles covered by catchment area
+	StationAcceptanceCache acceptance_cache{}; ///< NOSAVE: Acceptance of the tiles in #catchment_tiles, rebuilt when the catchment changes
 
 	StationHadVehicleOfType had_vehicle_of_type{};
 
@@ -609,6 +624,7 @@ public:
 };
 
 void RebuildStationKdtree();
+void FindStationsWithCatchmentAround(const TileArea &ta, std::vector<Station *> &stations);
 
 /**
  * Call a function on all stations that have any part of the requested area within their catchment.
@@ -623,21 +639,11 @@ void ForAllStationsAroundTiles(const TileArea &ta, Func func)
 	/* There are no stations, so we will never find anything. */
 	if (Station::GetNumItems() == 0) return;
 
-	/* Not using, or don't have a nearby stations list, so we need to scan. */
-	std::set<StationID> seen_stations;
-
-	/* Scan an area around the building covering the maximum possible station
-	 * to find the possible nearby stations. */
-	uint max_c = _settings_game.station.modified_catchment ? MAX_CATCHMENT : CA_UNMODIFIED;
-	TileArea ta_ext = TileArea(ta).Expand(max_c);
-	for (TileIndex tile : ta_ext) {
-		if (IsTileType(tile, MP_STATION)) seen_stations.insert(GetStationIndex(tile));
-	}
-
-	for (StationID stationid : seen_stations) {
-		Station *st = Station::GetIfValid(stationid);
-		if (st == nullptr) continue; /* Waypoint */
+	/* Only the stations whose catchment area overlaps the area can cover any of its tiles. */
+	std::vector<Station *> stations;
+	FindStationsWithCatchmentAround(ta, stations);
 
+	for (Station *st : stations) {
 		/* Check if station is attached to an industry */
 		if (!_settings_game.station.serve_neutral_industries && st->industry != nullptr) continue;
 
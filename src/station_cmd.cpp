@@ -38,6 +38,7 @@
 #include "station_base.h"
 #include "station_func.h"
 #include "station_kdtree.h"
+#include "depot_kdtree.h"
 #include "roadstop_base.h"
 #include "newgrf_railtype.h"
 #include "newgrf_roadtype.h"
@@ -73,6 +74,7 @@
 #include "table/strings.h"
 
 #include <bitset>
+#include <unordered_map>
 
 #include "safeguards.h"
 
@@ -595,19 +597,171 @@ CargoArray GetAcceptanceAroundTiles(TileIndex center_tile, int w, int h, int rad
 	return acceptance;
 }
 
+/**
+ * Check whether the acceptance of a tile is decided by NewGRF callbacks.
+ * Such acceptance can change at any moment, so it cannot be part of the running sums of a station.
+ * @param tile Tile to check.
+ * @return True iff the acceptance has to be asked for each time.
+ */
+static bool IsAcceptanceFromCallback(TileIndex tile)
+{
+	switch (GetTileType(tile)) {
+		case MP_HOUSE:
+			return HouseSpec::Get(GetHouseType(tile))->callback_mask.Any({HouseCallbackMask::AcceptCargo, HouseCallbackMask::CargoAcceptance});
+
+		case MP_INDUSTRY:
+			return GetIndustryTileSpec(GetIndustryGfx(tile))->callback_mask.Any({IndustryTileCallbackMask::AcceptCargo, IndustryTileCallbackMask::CargoAcceptance});
+
+		default:
+			return false;
+	}
+}
+
+/** Acceptance of a single tile, as it is added to or removed from the running sums of stations. */
+struct TileAcceptance {
+	TileIndex tile; ///< The tile.
+	bool from_callback; ///< Whether the acceptance of the tile is decided by NewGRF callbacks.
+	CargoArray acceptance{}; ///< Acceptance of the tile in 1/8, when not decided by callbacks.
+	CargoTypes always_accepted = 0; ///< Cargo types always accepted by the tile, when not decided by callbacks.
+
+	/**
+	 * Determine the acceptance of a tile.
+	 * @param tile The tile.
+	 */
+	TileAcceptance(TileIndex tile) : tile(tile), from_callback(IsAcceptanceFromCallback(tile))
+	{
+		if (!this->from_callback) AddAcceptedCargo(tile, this->acceptance, &this->always_accepted);
+	}
+
+	/**
+	 * Whether the tile changes nothing to the acceptance of a station.
+	 * @return True iff there is no need to update any station.
+	 */
+	bool IsEmpty() const
+	{
+		return !this->from_callback && this->always_accepted == 0 && this->acceptance.GetCount() == 0;
+	}
+
+	/**
+	 * Add this tile to the running sums of a station.
+	 * @param cache The running sums.
+	 */
+	void AddTo(StationAcceptanceCache &cache) const
+	{
+		if (this->from_callback) {
+			cache.callback_tiles.insert(std::ranges::lower_bound(cache.callback_tiles, this->tile), this->tile);
+			return;
+		}
+		for (CargoType c = 0; c < NUM_CARGO; c++) cache.acceptance[c] += this->acceptance[c];
+		for (CargoType c : SetCargoBitIterator(this->always_accepted)) cache.always_accepted[c]++;
+	}
+
+	/**
+	 * Remove this tile from the running sums of a station.
+	 * @param cache The running sums.
+	 */
+	void RemoveFrom(StationAcceptanceCache &cache) const
+	{
+		if (this->from_callback) {
+			auto it = std::ranges::lower_bound(cache.callback_tiles, this->tile);
+			assert(it != cache.callback_tiles.end() && *it == this->tile);
+			cache.callback_tiles.erase(it);
+			return;
+		}
+		for (CargoType c = 0; c < NUM_CARGO; c++) cache.acceptance[c] -= this->acceptance[c];
+		for (CargoType c : SetCargoBitIterator(this->always_accepted)) cache.always_accepted[c]--;
+	}
+};
+
+/**
+ * Rebuild the running sums of the acceptance of a station from all tiles of its catchment.
+ * @param st Station to rebuild the sums of.
+ */
+void RebuildStationAcceptanceCache(Station *st)
+{
+	StationAcceptanceCache &cache = st->acceptance_cache;
+	cache = {};
+
+	BitmapTileIterator it(st->catchment_tiles);
+	for (TileIndex tile = it; tile != INVALID_TILE; tile = ++it) {
+		TileAcceptance(tile).AddTo(cache);
+	}
+
+	cache.valid = true;
+}
+
+/**
+ * Add or remove the acceptance of a tile to the running sums of all stations that have the tile in their catchment.
+ * @param tile The tile that changed.
+ * @param add Whether to add or remove the acceptance.
+ */
+static void ChangeTileAcceptanceOfStations(TileIndex tile, bool add)
+{
+	/* There are no stations, so there are no running sums either. */
+	if (Station::GetNumItems() == 0) return;
+
+	TileAcceptance ta(tile);
+	if (ta.IsEmpty()) return;
+
+	/* Neutral stations are included, as their catchment is the tiles of their industry. */
+	std::set<StationID> seen_stations;
+	uint max_c = _settings_game.station.modified_catchment ? MAX_CATCHMENT : CA_UNMODIFIED;
+	for (TileIndex cur_tile : TileArea(tile, 1, 1).Expand(max_c)) {
+		if (IsTileType(cur_tile, MP_STATION)) seen_stations.insert(GetStationIndex(cur_tile));
+	}
+
+	for (StationID stationid : seen_stations) {
+		Station *st = Station::GetIfValid(stationid);
+		if (st == nullptr || !st->acceptance_cache.valid || !st->TileIsInCatchment(tile)) continue;
+
+		if (add) {
+			ta.AddTo(st->acceptance_cache);
+		} else {
+			ta.RemoveFrom(st->acceptance_cache);
+		}
+	}
+}
+
+/**
+ * Add the acceptance of a tile to the stations around it.
+ * Call this right after the tile got something that might accept cargo.
+ * @param tile The tile that changed.
+ */
+void AddTileAcceptanceToStations(TileIndex tile)
+{
+	ChangeTileAcceptanceOfStations(tile, true);
+}
+
+/**
+ * Remove the acceptance of a tile from the stations around it.
+ * Call this right before the tile loses something that might accept cargo.
+ * @param tile The tile that is going to change.
+ */
+void RemoveTileAcceptanceFromStations(TileIndex tile)
+{
+	ChangeTileAcceptanceOfStations(tile, false);
+}
+
 /**
  * Get the acceptance of cargoes around the station in.
  * @param st Station to get acceptance of.
  * @param always_accepted bitmask of cargo accepted by houses and headquarters; can be nullptr
  */
-static CargoArray GetAcceptanceAroundStation(const Station *st, CargoTypes *always_accepted)
+static CargoArray GetAcceptanceAroundStation(Station *st, CargoTypes *always_accepted)
 {
-	CargoArray acceptance{};
-	if (always_accepted != nullptr) *always_accepted = 0;
+	if (!st->acceptance_cache.valid) RebuildStationAcceptanceCache(st);
+	const StationAcceptanceCache &cache = st->acceptance_cache;
 
-	BitmapTileIterator it(st->catchment_tiles);
-	for (TileIndex tile = it; tile != INVALID_TILE; tile = ++it) {
-		AddAcceptedCargo(tile, acceptance, always_accepted);
+	CargoArray acceptance = cache.acceptance;
+	CargoTypes dummy = 0;
+	CargoTypes &always = always_accepted == nullptr ? dummy : *always_accepted;
+	always = 0;
+	for (CargoType c = 0; c < NUM_CARGO; c++) {
+		if (cache.always_accepted[c] != 0) SetBit(always, c);
+	}
+
+	for (TileIndex tile : cache.callback_tiles) {
+		AddAcceptedCargo(tile, acceptance, &always);
 	}
 
 	return acceptance;
@@ -2091,6 +2245,7 @@ CommandCost CmdBuildRoadStop(DoCommandFlags flags, TileIndex tile, uint8_t width
 			UpdateCompanyRoadInfrastructure(road_rt, road_owner, ROAD_STOP_TRACKBIT_FACTOR);
 			UpdateCompanyRoadInfrastructure(tram_rt, tram_owner, ROAD_STOP_TRACKBIT_FACTOR);
 			Company::Get(st->owner)->infrastructure.station++;
+			YapfNotifyRoadLayoutChange(cur_tile);
 
 			SetCustomRoadStopSpecIndex(cur_tile, specindex);
 			if (roadstopspec != nullptr) {
@@ -2203,13 +2358,14 @@ static CommandCost RemoveRoadStop(TileIndex tile, DoCommandFlags flags, int repl
 		} else {
 			DoClearSquare(tile);
 		}
+		YapfNotifyRoadLayoutChange(tile);
 
 		delete cur_stop;
 
 		/* Make sure no vehicle is going to the old roadstop. Narrow the search to any road vehicles with an order to
 		 * this station, then look for any currently heading to the tile. */
 		StationID station_id = st->index;
-		FindVehiclesWithOrder(
+		FindVehiclesWithOrder(OrderDestinationKind::Station, station_id,
 			[](const Vehicle *v) { return v->type == VEH_ROAD; },
 			[station_id](const Order *order) { return order->IsType(OT_GOTO_STATION) && order->GetDestination() == station_id; },
 			[station_id, tile](Vehicle *v) {
@@ -2279,6 +2435,7 @@ CommandCost RemoveRoadWaypointStop(TileIndex tile, DoCommandFlags flags, int rep
 		DeleteNewGRFInspectWindow(GSF_ROADSTOPS, tile.base());
 
 		DoClearSquare(tile);
+		YapfNotifyRoadLayoutChange(tile);
 
 		wp->rect.AfterRemoveTile(wp, tile);
 
@@ -2353,6 +2510,7 @@ static CommandCost RemoveGenericRoadStop(DoCommandFlags flags, const TileArea &r
 		if (flags.Test(DoCommandFlag::Execute) && (road_type[RTT_ROAD] != INVALID_ROADTYPE || road_type[RTT_TRAM] != INVALID_ROADTYPE)) {
 			MakeRoadNormal(cur_tile, road_bits, road_type[RTT_ROAD], road_type[RTT_TRAM], ClosestTownFromTile(cur_tile, UINT_MAX)->index,
 					road_owner[RTT_ROAD], road_owner[RTT_TRAM]);
+			YapfNotifyRoadLayoutChange(cur_tile);
 
 			/* Update company infrastructure counts. */
 			int count = CountBits(road_bits);
@@ -2626,6 +2784,7 @@ CommandCost CmdBuildAirport(DoCommandFlags flags, TileIndex tile, uint8_t airpor
 		}
 
 		UpdateAirplanesOnNewStation(st);
+		AddHangarsToKdtree(st);
 
 		Company::Get(st->owner)->infrastructure.airport++;
 
@@ -2705,6 +2864,7 @@ static CommandCost RemoveAirport(TileIndex tile, DoCommandFlags flags)
 
 		st->rect.AfterRemoveRect(st, st->airport);
 
+		RemoveHangarsFromKdtree(st);
 		st->airport.Clear();
 		st->facilities.Reset(StationFacility::Airport);
 		SetWindowClassesDirty(WC_VEHICLE_ORDERS);
@@ -2757,8 +2917,8 @@ bool HasStationInUse(StationID station, bool include_company, CompanyID company)
 		assert(v != nullptr);
 		if ((v->owner == company) != include_company) continue;
 
-		for (const Order *order = orderlist->GetFirstOrder(); order != nullptr; order = order->next) {
-			if (order->GetDestination() == station && (order->IsType(OT_GOTO_STATION) || order->IsType(OT_GOTO_WAYPOINT))) {
+		for (const Order &order : orderlist->GetOrders()) {
+			if (order.GetDestination() == station && (order.IsType(OT_GOTO_STATION) || order.IsType(OT_GOTO_WAYPOINT))) {
 				return true;
 			}
 		}
@@ -4041,12 +4201,12 @@ void DeleteStaleLinks(Station *from)
 					for (OrderList *l : OrderList::Iterate()) {
 						bool found_from = false;
 						bool found_to = false;
-						for (Order *order = l->GetFirstOrder(); order != nullptr; order = order->next) {
-							if (!order->IsType(OT_GOTO_STATION) && !order->IsType(OT_IMPLICIT)) continue;
-							if (order->GetDestination() == from->index) {
+						for (const Order &order : l->GetOrders()) {
+							if (!order.IsType(OT_GOTO_STATION) && !order.IsType(OT_IMPLICIT)) continue;
+							if (order.GetDestination() == from->index) {
 								found_from = true;
 								if (found_to) break;
-							} else if (order->GetDestination() == to->index) {
+							} else if (order.GetDestination() == to->index) {
 								found_to = true;
 								if (found_from) break;
 							}
@@ -4344,26 +4504,88 @@ static void AddNearbyStationsByCatchment(TileIndex tile, StationList &stations,
 	}
 }
 
+/**
+ * Stations that have a house tile in their catchment, indexed by the house tile. NOSAVE
+ * Entries are made on demand, and removed when the catchment of a station around them changes or when the house is removed.
+ */
+static std::unordered_map<uint32_t, StationList> _house_tile_stations;
+
+/**
+ * Get the stations that have a house tile in their catchment.
+ * @param tile The house tile.
+ * @return The stations.
+ */
+static const StationList &GetStationsAroundHouseTile(TileIndex tile)
+{
+	auto [it, inserted] = _house_tile_stations.try_emplace(tile.base());
+	if (inserted) {
+		/* Town nearby stations need to be filtered per tile. */
+		AddNearbyStationsByCatchment(tile, it->second, Town::GetByTile(tile)->stations_near);
+	}
+	return it->second;
+}
+
+/**
+ * Forget the stations around a house tile, as the house is removed.
+ * @param tile The house tile.
+ */
+void InvalidateHouseTileStations(TileIndex tile)
+{
+	_house_tile_stations.erase(tile.base());
+}
+
+/**
+ * Forget the stations around all tiles of a catchment, as the catchment changes.
+ * @param catchment_tiles The tiles of the catchment.
+ */
+void InvalidateHouseTileStations(const BitmapTileArea &catchment_tiles)
+{
+	if (_house_tile_stations.empty()) return;
+
+	BitmapTileIterator it(catchment_tiles);
+	for (TileIndex tile = it; tile != INVALID_TILE; tile = ++it) {
+		_house_tile_stations.erase(tile.base());
+	}
+}
+
+/** Forget the stations around all house tiles. */
+void InvalidateAllHouseTileStations()
+{
+	_house_tile_stations.clear();
+}
+
+/** Check whether the stations around house tiles are still the same as when they were computed. */
+void CheckHouseTileStations()
+{
+	for (const auto &[index, stations] : _house_tile_stations) {
+		TileIndex tile{index};
+		StationList found;
+		if (IsTileType(tile, MP_HOUSE)) AddNearbyStationsByCatchment(tile, found, Town::GetByTile(tile)->stations_near);
+		if (found != stations) Debug(desync, 2, "warning: house tile stations mismatch: tile {}", tile);
+	}
+}
+
 /**
  * Run a tile loop to find stations around a tile, on demand. Cache the result for further requests
  * @return pointer to a StationList containing all stations found
  */
 const StationList &StationFinder::GetStations()
 {
-	if (this->tile != INVALID_TILE) {
-		if (IsTileType(this->tile, MP_HOUSE)) {
-			/* Town nearby stations need to be filtered per tile. */
+	if (this->found == nullptr) {
+		this->found = &this->stations;
+		if (this->tile == INVALID_TILE) {
+			/* Nothing to search around. */
+		} else if (IsTileType(this->tile, MP_HOUSE)) {
 			assert(this->w == 1 && this->h == 1);
-			AddNearbyStationsByCatchment(this->tile, this->stations, Town::GetByTile(this->tile)->stations_near);
+			this->found = &GetStationsAroundHouseTile(this->tile);
 		} else {
 			ForAllStationsAroundTiles(*this, [this](Station *st, TileIndex) {
 				this->stations.insert(st);
 				return true;
 			});
 		}
-		this->tile = INVALID_TILE;
 	}
-	return this->stations;
+	return *this->found;
 }
 
 
@@ -18,6 +18,7 @@
 #include "rail.h"
 #include "road.h"
 #include "linkgraph/linkgraph_type.h"
+#include "bitmap_type.h"
 #include "industry_type.h"
 
 void ModifyStationRatingAround(TileIndex tile, Owner owner, int amount, uint radius);
@@ -30,6 +31,15 @@ CargoArray GetProductionAroundTiles(TileIndex tile, int w, int h, int rad);
 CargoArray GetAcceptanceAroundTiles(TileIndex tile, int w, int h, int rad, CargoTypes *always_accepted = nullptr);
 
 void UpdateStationAcceptance(Station *st, bool show_msg);
+void RebuildStationAcceptanceCache(Station *st);
+void AddTileAcceptanceToStations(TileIndex tile);
+void RemoveTileAcceptanceFromStations(TileIndex tile);
+
+void InvalidateHouseTileStations(TileIndex tile);
+void InvalidateHouseTileStations(const BitmapTileArea &catchment_tiles);
+void InvalidateAllHouseTileStations();
+void CheckHouseTileStations();
+void CheckCatchmentIndex();
 CargoTypes GetAcceptanceMask(const Station *st);
 CargoTypes GetEmptyMask(const Station *st);
 
@@ -102,6 +102,7 @@ typedef std::set<Station *, StationCompare> StationList;
  */
 class StationFinder : TileArea {
 	StationList stations; ///< List of stations nearby
+	const StationList *found = nullptr; ///< The stations that were found; either #stations or the cached list of a house tile
 public:
 	/**
 	 * Constructs StationFinder
@@ -0,0 +1,63 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file economy_func.cpp Test functionality from economy_func.h */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../economy_func.h"
+#include "../settings_type.h"
+#include "../timer/timer_game_economy.h"
+
+#include "../safeguards.h"
+
+/**
+ * Count on how many days of a month each slice gets its update.
+ * @param year The year of the month.
+ * @param month The month.
+ * @return For each slice, the number of days it was returned.
+ */
+static std::vector<uint> CountMonthSlices(TimerGameEconomy::Year year, TimerGameEconomy::Month month)
+{
+	std::vector<uint> counts(ECONOMY_MONTH_SLICES);
+	TimerGameEconomy::Date date = TimerGameEconomy::ConvertYMDToDate(year, month, 1);
+	for (; TimerGameEconomy::ConvertDateToYMD(date).month == month; ++date) {
+		TimerGameEconomy::date = date;
+		std::optional<uint> slice = GetEconomyMonthSlice();
+		if (slice.has_value()) counts.at(*slice)++;
+	}
+	return counts;
+}
+
+TEST_CASE("GetEconomyMonthSlice - every slice once a month")
+{
+	const TimerGameEconomy::Date old_date = TimerGameEconomy::date;
+	const TimekeepingUnits old_units = _settings_game.economy.timekeeping_units;
+	const bool old_spread = _economy.spread_monthly_loop;
+	_economy.spread_monthly_loop = true;
+
+	for (TimekeepingUnits units : {TKU_CALENDAR, TKU_WALLCLOCK}) {
+		_settings_game.economy.timekeeping_units = units;
+
+		/* January, February of a common year (28 days), February of a leap year and April. */
+		static const std::pair<int32_t, TimerGameEconomy::Month> months[] = {{2023, 0}, {2023, 1}, {2024, 1}, {2024, 3}};
+		for (auto [year, month] : months) {
+			std::vector<uint> counts = CountMonthSlices(TimerGameEconomy::Year{year}, month);
+			for (uint slice = 0; slice < ECONOMY_MONTH_SLICES; slice++) CHECK(counts[slice] == 1);
+		}
+	}
+
+	_economy.spread_monthly_loop = false;
+	TimerGameEconomy::date = TimerGameEconomy::ConvertYMDToDate(TimerGameEconomy::Year{2023}, 1, 10);
+	CHECK(!GetEconomyMonthSlice().has_value());
+
+	_economy.spread_monthly_loop = old_spread;
+	_settings_game.economy.timekeeping_units = old_units;
+	TimerGameEconomy::date = old_date;
+}
@@ -0,0 +1,158 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file ground_vehicle.cpp Test and benchmark the slope resistance of ground vehicles. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "mock_game.h"
+
+#include "../map_func.h"
+#include "../rail_map.h"
+#include "../settings_type.h"
+#include "../train.h"
+
+#include "../safeguards.h"
+
+/** Result of running the trains over the hills. */
+struct SlopeResistanceRun {
+	int64_t checksum = 0; ///< Sum of the slope resistance of all trains over all ticks.
+	std::chrono::steady_clock::duration duration{}; ///< Time it took.
+};
+
+/**
+ * Get the inclination a part of a train has at a tick. Every part changes inclination once
+ * every 16 ticks, about as often as a train at 100 km/h enters a new tile.
+ * @param tick The tick.
+ * @param part The index of the part in all parts of all trains.
+ * @param[out] flags The inclination flags of the part.
+ * @return Whether the inclination of the part changes at this tick.
+ */
+static bool GetMockInclination(uint tick, uint part, uint16_t &flags)
+{
+	if ((tick + part) % 16 != 0) return false;
+
+	static const uint16_t inclinations[] = {0, 1U << GVF_GOINGUP_BIT, 1U << GVF_GOINGUP_BIT, 0, 1U << GVF_GOINGDOWN_BIT};
+	flags = inclinations[(tick / 16 + part * 7) % std::size(inclinations)];
+	return true;
+}
+
+/**
+ * Let the trains go over the hills, and get their slope resistance each tick using the cached total.
+ * @param trains The trains.
+ * @param ticks The number of ticks.
+ * @return The sum of the slope resistances, and the time it took.
+ */
+static SlopeResistanceRun RunWithCachedSlopeResistance(const std::vector<Train *> &trains, uint ticks)
+{
+	SlopeResistanceRun run;
+	auto start = std::chrono::steady_clock::now();
+	for (uint tick = 0; tick < ticks; tick++) {
+		uint part = 0;
+		for (Train *t : trains) {
+			for (Train *u = t; u != nullptr; u = u->Next(), part++) {
+				uint16_t flags;
+				if (GetMockInclination(tick, part, flags)) u->SetInclination(flags);
+			}
+			run.checksum += t->GetSlopeResistance();
+		}
+	}
+	run.duration = std::chrono::steady_clock::now() - start;
+	return run;
+}
+
+/**
+ * Let the trains go over the hills, and get their slope resistance each tick by adding up the resistance of all parts.
+ * This is how the slope resistance was found before it was cached.
+ * @param trains The trains.
+ * @param ticks The number of ticks.
+ * @return The sum of the slope resistances, and the time it took.
+ */
+static SlopeResistanceRun RunWithSummedSlopeResistance(const std::vector<Train *> &trains, uint ticks)
+{
+	SlopeResistanceRun run;
+	auto start = std::chrono::steady_clock::now();
+	for (uint tick = 0; tick < ticks; tick++) {
+		uint part = 0;
+		for (Train *t : trains) {
+			for (Train *u = t; u != nullptr; u = u->Next(), part++) {
+				uint16_t flags;
+				if (GetMockInclination(tick, part, flags)) {
+					ClrBit(u->gv_flags, GVF_GOINGUP_BIT);
+					ClrBit(u->gv_flags, GVF_GOINGDOWN_BIT);
+					u->gv_flags |= flags;
+				}
+			}
+			for (const Train *u = t; u != nullptr; u = u->Next()) run.checksum += u->GetPartSlopeResistance();
+		}
+	}
+	run.duration = std::chrono::steady_clock::now() - start;
+	return run;
+}
+
+/**
+ * Build trains of a diesel engine and wagons, and compare the cached slope resistance with adding it up each tick.
+ * @param num_trains The number of trains.
+ * @param num_wagons The number of wagons of each train.
+ * @param ticks The number of ticks to run.
+ * @param report Whether to print the time both ways took.
+ */
+static void CompareSlopeResistance(uint num_trains, uint num_wagons, uint ticks, bool report)
+{
+	MockGameInitialize(64, 64);
+	const uint8_t old_acceleration_model = _settings_game.vehicle.train_acceleration_model;
+	const uint8_t old_slope_steepness = _settings_game.vehicle.train_slope_steepness;
+	_settings_game.vehicle.train_acceleration_model = AM_REALISTIC;
+	_settings_game.vehicle.train_slope_steepness = 3;
+
+	const TileIndex tile = TileXY(10, 10);
+	MakeRailNormal(tile, OWNER_NONE, TRACK_BIT_X, RAILTYPE_RAIL);
+
+	std::vector<EngineID> engines(num_wagons + 1, FindMockRailEngine(RAILTYPE_RAIL, RAILVEH_WAGON));
+	engines[0] = FindMockRailEngine(RAILTYPE_RAIL, RAILVEH_SINGLEHEAD);
+
+	std::vector<Train *> trains;
+	for (uint i = 0; i < num_trains; i++) {
+		Train *t = BuildMockTrain(engines, tile);
+		REQUIRE(t != nullptr);
+		t->ConsistChanged(CCF_ARRANGE);
+		trains.push_back(t);
+	}
+
+	/* Both runs start with all trains on flat track. */
+	SlopeResistanceRun cached = RunWithCachedSlopeResistance(trains, ticks);
+	for (Train *t : trains) {
+		for (Train *u = t; u != nullptr; u = u->Next()) u->SetInclination(0);
+	}
+	SlopeResistanceRun summed = RunWithSummedSlopeResistance(trains, ticks);
+
+	CHECK(cached.checksum != 0);
+	CHECK(cached.checksum == summed.checksum);
+
+	if (report) {
+		using std::chrono::duration_cast, std::chrono::microseconds;
+		fmt::print("{} trains of {} wagons, {} ticks: cached total {} us per tick, adding up the parts {} us per tick\n",
+				num_trains, num_wagons, ticks,
+				duration_cast<microseconds>(cached.duration).count() / ticks, duration_cast<microseconds>(summed.duration).count() / ticks);
+	}
+
+	_settings_game.vehicle.train_acceleration_model = old_acceleration_model;
+	_settings_game.vehicle.train_slope_steepness = old_slope_steepness;
+	MockGameUninitialize();
+}
+
+TEST_CASE("GroundVehicle::GetSlopeResistance - cached total matches the parts")
+{
+	CompareSlopeResistance(10, 50, 256, false);
+}
+
+TEST_CASE("GroundVehicle::GetSlopeResistance - benchmark 10000 trains of 50 wagons", "[.benchmark]")
+{
+	CompareSlopeResistance(10000, 50, 256, true);
+}
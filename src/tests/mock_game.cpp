@@ -0,0 +1,135 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file mock_game.cpp Minimal game state to place tracks and vehicles on in tests. */
+
+#include "../stdafx.h"
+
+#include "mock_game.h"
+
+#include "../core/pool_type.hpp"
+#include "../engine_base.h"
+#include "../engine_func.h"
+#include "../map_func.h"
+#include "../rail.h"
+#include "../ship.h"
+#include "../train.h"
+
+#include "../safeguards.h"
+
+/**
+ * Set up an empty map with the original rail types and engines, and no other game state.
+ * Everything on the map is clear land until the test builds on it.
+ * @param size_x The size of the map along the X axis.
+ * @param size_y The size of the map along the Y axis.
+ */
+void MockGameInitialize(uint size_x, uint size_y)
+{
+	PoolBase::Clean(PoolType::Normal);
+	Map::Allocate(size_x, size_y);
+
+	ResetRailTypes();
+	InitRailTypes();
+
+	_engine_mngr.ResetToDefaultMapping();
+	SetupEngines();
+}
+
+/** Remove the vehicles, engines and everything else the test created. */
+void MockGameUninitialize()
+{
+	PoolBase::Clean(PoolType::Normal);
+}
+
+/**
+ * Find an original rail vehicle.
+ * @param railtype The rail type of the vehicle.
+ * @param railveh_type The kind of vehicle.
+ * @return The first engine of the kind, with power unless it is a wagon.
+ */
+EngineID FindMockRailEngine(RailType railtype, RailVehicleTypes railveh_type)
+{
+	for (const Engine *e : Engine::IterateType(VEH_TRAIN)) {
+		const RailVehicleInfo &rvi = e->u.rail;
+		if (rvi.railtype != railtype || rvi.railveh_type != railveh_type) continue;
+		if (railveh_type != RAILVEH_WAGON && rvi.power == 0) continue;
+		return e->index;
+	}
+	return EngineID::Invalid();
+}
+
+/**
+ * Build a train without going through the commands, so no company, depot or money is needed.
+ * All parts start at the same tile; the caller moves them where it wants them,
+ * and calls ConsistChanged once they are there.
+ * @param engines The engines of the parts, from front to back. The first must be a single headed engine.
+ * @param tile The tile to put all parts on.
+ * @return The front of the train, or \c nullptr when there is no room for more vehicles.
+ */
+Train *BuildMockTrain(std::span<const EngineID> engines, TileIndex tile)
+{
+	if (!Train::CanAllocateItem(engines.size())) return nullptr;
+
+	Train *front = nullptr;
+	Train *last = nullptr;
+	for (EngineID engine : engines) {
+		const RailVehicleInfo *rvi = RailVehInfo(engine);
+
+		Train *u = new Train();
+		u->engine_type = engine;
+		u->gcache.first_engine = EngineID::Invalid();
+		u->railtype = rvi->railtype;
+		u->owner = OWNER_NONE;
+		u->tile = tile;
+		u->track = TRACK_BIT_X;
+		u->direction = DIR_NE;
+		u->cargo_type = 0;
+
+		if (last == nullptr) {
+			assert(rvi->railveh_type == RAILVEH_SINGLEHEAD);
+			u->SetFrontEngine();
+			u->SetEngine();
+			front = u;
+		} else {
+			if (rvi->railveh_type == RAILVEH_WAGON) {
+				u->SetWagon();
+			} else {
+				u->SetEngine();
+			}
+			last->SetNext(u);
+		}
+		last = u;
+	}
+	return front;
+}
+
+/**
+ * Build a ship without going through the commands, so no company, depot or money is needed.
+ * @param tile The water tile to put the ship on.
+ * @param direction The direction the ship is sailing in.
+ * @return The ship, or \c nullptr when there is no room for more vehicles.
+ */
+Ship *BuildMockShip(TileIndex tile, DiagDirection direction)
+{
+	if (!Ship::CanAllocateItem()) return nullptr;
+
+	const Engine *engine = nullptr;
+	for (const Engine *e : Engine::IterateType(VEH_SHIP)) {
+		engine = e;
+		break;
+	}
+	assert(engine != nullptr);
+
+	Ship *v = new Ship();
+	v->engine_type = engine->index;
+	v->owner = OWNER_NONE;
+	v->tile = tile;
+	v->state = DiagDirToDiagTrackBits(direction);
+	v->direction = DiagDirToDir(direction);
+	v->cargo_type = 0;
+	return v;
+}
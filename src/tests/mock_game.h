@@ -0,0 +1,28 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file mock_game.h Minimal game state to place tracks and vehicles on in tests. */
+
+#ifndef MOCK_GAME_H
+#define MOCK_GAME_H
+
+#include "../direction_type.h"
+#include "../engine_type.h"
+#include "../rail_type.h"
+#include "../tile_type.h"
+
+struct Ship;
+struct Train;
+
+void MockGameInitialize(uint size_x, uint size_y);
+void MockGameUninitialize();
+
+EngineID FindMockRailEngine(RailType railtype, RailVehicleTypes railveh_type);
+Train *BuildMockTrain(std::span<const EngineID> engines, TileIndex tile);
+Ship *BuildMockShip(TileIndex tile, DiagDirection direction);
+
+#endif /* MOCK_GAME_H */
@@ -0,0 +1,59 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file random_func.cpp Test functionality from core/random_func. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../core/random_func.hpp"
+
+TEST_CASE("StreamRandomizer - same stream gives same numbers")
+{
+	StreamRandomizer a(1234, 1, 42, 1000);
+	StreamRandomizer b(1234, 1, 42, 1000);
+	for (int i = 0; i < 100; i++) CHECK(a.Next() == b.Next());
+}
+
+TEST_CASE("StreamRandomizer - independent of other streams")
+{
+	StreamRandomizer a(1234, 1, 42, 1000);
+	uint32_t first = a.Next();
+
+	/* Drawing from other streams does not change the numbers of this one. */
+	StreamRandomizer other(1234, 1, 43, 1000);
+	for (int i = 0; i < 10; i++) other.Next();
+	CHECK(StreamRandomizer(1234, 1, 42, 1000).Next() == first);
+}
+
+TEST_CASE("StreamRandomizer - streams differ")
+{
+	uint32_t value = StreamRandomizer(1234, 1, 42, 1000).Next();
+	CHECK(StreamRandomizer(1235, 1, 42, 1000).Next() != value);
+	CHECK(StreamRandomizer(1234, 2, 42, 1000).Next() != value);
+	CHECK(StreamRandomizer(1234, 1, 43, 1000).Next() != value);
+	CHECK(StreamRandomizer(1234, 1, 42, 1001).Next() != value);
+
+	StreamRandomizer a(1234, 1, 42, 1000);
+	CHECK(a.Next() != a.Next());
+}
+
+TEST_CASE("StreamRandomizer - distribution")
+{
+	/* Consecutive entities at consecutive ticks should still give evenly spread numbers. */
+	std::array<uint, 16> buckets{};
+	for (uint32_t entity = 0; entity < 64; entity++) {
+		for (uint64_t tick = 0; tick < 64; tick++) {
+			buckets[StreamRandomizer(0, 0, entity, tick).Next(16)]++;
+		}
+	}
+	for (uint count : buckets) {
+		CHECK(count > 256 - 64);
+		CHECK(count < 256 + 64);
+	}
+}
@@ -0,0 +1,173 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file signal.cpp Test and benchmark updating the signals of large signal blocks. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "mock_game.h"
+
+#include "../company_base.h"
+#include "../map_func.h"
+#include "../rail_map.h"
+#include "../signal_func.h"
+
+#include "../safeguards.h"
+
+/** A grid of signal blocks, each a square of junctions with two-way signals on every track leading into it. */
+struct MockSignalGrid {
+	static constexpr uint ORIGIN = 2; ///< Coordinate of the first junction tile of the first block.
+
+	uint blocks; ///< Number of blocks along each axis.
+	uint size; ///< Number of junction tiles along each axis of a block.
+
+	/**
+	 * Get the first coordinate of a block.
+	 * @param block The index of the block along the axis.
+	 * @return The coordinate of its first junction tile along the axis.
+	 */
+	uint Start(uint block) const { return ORIGIN + block * (this->size + 1); }
+
+	/**
+	 * Get the signal tiles around a block, with the trackdir of the signal that trains entering the block pass.
+	 * @param bx The X index of the block.
+	 * @param by The Y index of the block.
+	 * @return The signals.
+	 */
+	std::vector<std::pair<TileIndex, Trackdir>> GetEntrySignals(uint bx, uint by) const
+	{
+		std::vector<std::pair<TileIndex, Trackdir>> signals;
+		for (uint i = 0; i < this->size; i++) {
+			signals.emplace_back(TileXY(this->Start(bx) - 1, this->Start(by) + i), TRACKDIR_X_SW);
+			signals.emplace_back(TileXY(this->Start(bx) + this->size, this->Start(by) + i), TRACKDIR_X_NE);
+			signals.emplace_back(TileXY(this->Start(bx) + i, this->Start(by) - 1), TRACKDIR_Y_SE);
+			signals.emplace_back(TileXY(this->Start(bx) + i, this->Start(by) + this->size), TRACKDIR_Y_NW);
+		}
+		return signals;
+	}
+};
+
+/**
+ * Put a track with red two-way signals on a tile.
+ * @param tile The tile.
+ * @param track The track.
+ * @param type The type of the signals.
+ * @param owner The owner of the track.
+ */
+static void MakeMockSignals(TileIndex tile, Track track, SignalType type, Owner owner)
+{
+	MakeRailNormal(tile, owner, TrackToTrackBits(track), RAILTYPE_RAIL);
+	SetHasSignals(tile, true);
+	SetSignalType(tile, track, type);
+	SetSignalVariant(tile, track, SIG_ELECTRIC);
+	SetPresentSignals(tile, SignalOnTrack(track));
+	SetSignalStates(tile, 0);
+}
+
+/**
+ * Build a grid of signal blocks.
+ * @param blocks Number of blocks along each axis.
+ * @param size Number of junction tiles along each axis of a block.
+ * @param type The type of the signals between the blocks.
+ * @param owner The owner of the track.
+ * @return The grid.
+ */
+static MockSignalGrid BuildMockSignalGrid(uint blocks, uint size, SignalType type, Owner owner)
+{
+	MockSignalGrid grid{blocks, size};
+	for (uint by = 0; by < blocks; by++) {
+		for (uint bx = 0; bx < blocks; bx++) {
+			for (uint y = grid.Start(by); y < grid.Start(by) + size; y++) {
+				for (uint x = grid.Start(bx); x < grid.Start(bx) + size; x++) MakeRailNormal(TileXY(x, y), owner, TRACK_BIT_ALL, RAILTYPE_RAIL);
+			}
+			for (const auto &[tile, trackdir] : grid.GetEntrySignals(bx, by)) {
+				if (!IsTileType(tile, MP_RAILWAY)) MakeMockSignals(tile, TrackdirToTrack(trackdir), type, owner);
+			}
+		}
+	}
+	InvalidateSignalBlocks();
+	return grid;
+}
+
+/**
+ * Set up a map with a company to own the track.
+ * @param size The size of the map along each axis.
+ * @return The company.
+ */
+static Owner MockSignalGameInitialize(uint size)
+{
+	MockGameInitialize(size, size);
+	REQUIRE(Company::CanAllocateItem());
+	return (new Company())->index;
+}
+
+TEST_CASE("UpdateSignalsOnSegment - block with more signals and junctions than fit the old fixed sets")
+{
+	const Owner owner = MockSignalGameInitialize(64);
+
+	/* 1600 junction tiles, and 160 signals into the block. */
+	const MockSignalGrid grid = BuildMockSignalGrid(1, 40, SIGTYPE_BLOCK, owner);
+	const TileIndex tile = TileXY(grid.Start(0), grid.Start(0));
+
+	CHECK(UpdateSignalsOnSegment(tile, DIAGDIR_NE, owner) == SIGSEG_FREE);
+	for (const auto &[signal, trackdir] : grid.GetEntrySignals(0, 0)) {
+		CHECK(GetSignalStateByTrackdir(signal, trackdir) == SIGNAL_STATE_GREEN);
+	}
+
+	MockGameUninitialize();
+}
+
+/**
+ * Time updating all blocks of a grid of path signal blocks in a single batch.
+ * @param grid The grid.
+ * @param owner The owner of the track.
+ * @return The time it took.
+ */
+static std::chrono::steady_clock::duration UpdateMockSignalGrid(const MockSignalGrid &grid, Owner owner)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (uint by = 0; by < grid.blocks; by++) {
+		for (uint bx = 0; bx < grid.blocks; bx++) AddTrackToSignalBuffer(TileXY(grid.Start(bx), grid.Start(by)), TRACK_X, owner);
+	}
+	UpdateSignalsInBuffer();
+	return std::chrono::steady_clock::now() - start;
+}
+
+TEST_CASE("UpdateSignalsInBuffer - benchmark 256 path signal blocks of 1024 junctions", "[.benchmark]")
+{
+	const Owner owner = MockSignalGameInitialize(1024);
+
+	/* Each block has 128 path signals into it; the whole network has 33792 signals. */
+	const MockSignalGrid grid = BuildMockSignalGrid(16, 32, SIGTYPE_PBS, owner);
+	const uint num_blocks = grid.blocks * grid.blocks;
+
+	using std::chrono::duration_cast, std::chrono::microseconds;
+	auto explored = UpdateMockSignalGrid(grid, owner);
+	auto recorded = UpdateMockSignalGrid(grid, owner);
+
+	/* Path signals at junctions stay red until a train reserves a path. */
+	for (const auto &[signal, trackdir] : grid.GetEntrySignals(grid.blocks / 2, grid.blocks / 2)) {
+		CHECK(GetSignalStateByTrackdir(signal, trackdir) == SIGNAL_STATE_RED);
+	}
+
+	fmt::print("{} path signal blocks of {} junctions in one batch: exploring {} us per block, recorded {} us per block\n",
+			num_blocks, grid.size * grid.size,
+			duration_cast<microseconds>(explored).count() / num_blocks, duration_cast<microseconds>(recorded).count() / num_blocks);
+
+	/* One block at a time, as when a train enters or leaves a block. */
+	InvalidateSignalBlocks();
+	auto start = std::chrono::steady_clock::now();
+	for (uint by = 0; by < grid.blocks; by++) {
+		for (uint bx = 0; bx < grid.blocks; bx++) CHECK(UpdateSignalsOnSegment(TileXY(grid.Start(bx), grid.Start(by)), DIAGDIR_NE, owner) == SIGSEG_PBS);
+	}
+	fmt::print("{} path signal blocks of {} junctions one at a time: exploring {} us per block\n",
+			num_blocks, grid.size * grid.size, duration_cast<microseconds>(std::chrono::steady_clock::now() - start).count() / num_blocks);
+
+	MockGameUninitialize();
+}
@@ -0,0 +1,77 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file train_cmd.cpp Test updating the cached values of trains. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "mock_game.h"
+
+#include "../map_func.h"
+#include "../rail_map.h"
+#include "../train.h"
+
+#include "../safeguards.h"
+
+TEST_CASE("Train::RailTypeChanged - same caches as ConsistChanged while crossing to another rail type")
+{
+	MockGameInitialize(64, 64);
+
+	/* Electrified rail in the west, normal rail in the east. */
+	static const uint BOUNDARY_X = 32;
+	for (uint x = 1; x < Map::MaxX(); x++) {
+		MakeRailNormal(TileXY(x, 10), OWNER_NONE, TRACK_BIT_X, x < BOUNDARY_X ? RAILTYPE_ELECTRIC : RAILTYPE_RAIL);
+	}
+
+	/* An electric engine only has power on electrified rail, a diesel engine has power on both. */
+	const EngineID electric = FindMockRailEngine(RAILTYPE_ELECTRIC, RAILVEH_SINGLEHEAD);
+	const EngineID diesel = FindMockRailEngine(RAILTYPE_RAIL, RAILVEH_SINGLEHEAD);
+	const EngineID wagon = FindMockRailEngine(RAILTYPE_RAIL, RAILVEH_WAGON);
+	REQUIRE(electric != EngineID::Invalid());
+	REQUIRE(diesel != EngineID::Invalid());
+	REQUIRE(wagon != EngineID::Invalid());
+
+	const std::vector<EngineID> engines = {electric, wagon, wagon, diesel, wagon, wagon, wagon, wagon};
+	Train *t = BuildMockTrain(engines, TileXY(1, 10));
+	REQUIRE(t != nullptr);
+
+	/* The front part is the most eastern one. */
+	auto move_train = [t](uint front_x) {
+		uint x = front_x;
+		for (Train *u = t; u != nullptr; u = u->Next(), x--) {
+			const TileIndex tile = TileXY(x, 10);
+			const bool rail_type_changed = GetRailType(tile) != GetRailType(u->tile);
+			u->tile = tile;
+			if (rail_type_changed) t->RailTypeChanged();
+		}
+	};
+
+	const uint start_x = BOUNDARY_X - 2;
+	uint x = start_x;
+	for (Train *u = t; u != nullptr; u = u->Next(), x--) u->tile = TileXY(x, 10);
+	t->ConsistChanged(CCF_ARRANGE);
+	const uint32_t electrified_power = t->gcache.cached_power;
+
+	for (uint front_x = start_x + 1; front_x < BOUNDARY_X + engines.size() + 2; front_x++) {
+		move_train(front_x);
+
+		const GroundVehicleCache gcache = t->gcache;
+		const uint16_t max_speed = t->vcache.cached_max_speed;
+		const uint8_t acceleration = t->acceleration;
+		t->ConsistChanged(CCF_TRACK);
+		CHECK(gcache == t->gcache);
+		CHECK(max_speed == t->vcache.cached_max_speed);
+		CHECK(acceleration == t->acceleration);
+	}
+
+	/* Off the electrified rail only the diesel engine has power. */
+	CHECK(t->gcache.cached_power < electrified_power);
+
+	MockGameUninitialize();
+}
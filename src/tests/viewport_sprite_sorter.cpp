@@ -0,0 +1,97 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file viewport_sprite_sorter.cpp Test that the viewport sprite sorters give the same order as the original sorter. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../viewport_sprite_sorter.h"
+
+#include <random>
+
+/**
+ * Create parent sprites the way a viewport adds them: tile by tile, with a
+ * ground sprite for each tile and some buildings and vehicles on top of them.
+ * @param tiles Size of the square of tiles.
+ * @param seed Seed for the placement of the buildings and vehicles.
+ * @return The sprites.
+ */
+static std::vector<ParentSpriteToDraw> MakeSprites(int tiles, uint seed)
+{
+	std::mt19937 random(seed);
+	std::vector<ParentSpriteToDraw> sprites;
+
+	auto add = [&sprites](int x, int y, int z, int w, int h, int dz) {
+		ParentSpriteToDraw &ps = sprites.emplace_back();
+		ps.xmin = x;
+		ps.ymin = y;
+		ps.zmin = z;
+		ps.xmax = x + w - 1;
+		ps.ymax = y + h - 1;
+		ps.zmax = z + dz - 1;
+	};
+
+	for (int row = 0; row < tiles * 2; row++) {
+		for (int x = std::max(0, row - tiles + 1); x <= std::min(row, tiles - 1); x++) {
+			int y = row - x;
+			int z = (random() % 4) * 8;
+			add(x * 16, y * 16, z, 16, 16, 1);
+			switch (random() % 8) {
+				case 0: add(x * 16 + 1, y * 16 + 1, z, 14, 14, 8 + random() % 64); break; // building
+				case 1: add(x * 16 + random() % 8, y * 16 + 4, z, 8, 3, 6); break; // vehicle
+				case 2: add(x * 16, y * 16, z + 48, 32, 16, 2); break; // bridge
+				case 3: add(x * 16 + 8, y * 16 + 8, z, 0, 0, 0); break; // box with min > max
+				default: break;
+			}
+		}
+	}
+
+	return sprites;
+}
+
+/**
+ * Sort a copy of the sprites.
+ * @param sorter The sorter to use.
+ * @param sprites The sprites to sort.
+ * @return The original positions of the sprites, in the sorted order.
+ */
+static std::vector<size_t> SortSprites(VpSpriteSorter sorter, std::vector<ParentSpriteToDraw> sprites)
+{
+	ParentSpriteToSortVector psdv;
+	for (ParentSpriteToDraw &ps : sprites) psdv.push_back(&ps);
+
+	sorter(&psdv);
+
+	std::vector<size_t> result;
+	for (const ParentSpriteToDraw *ps : psdv) result.push_back(ps - sprites.data());
+	return result;
+}
+
+#ifdef WITH_SSE
+TEST_CASE("ViewportSortParentSprites - AVX2 sorter gives the same order as the original sorter")
+{
+	if (!ViewportSortParentSpritesAVX2Checker()) return;
+
+	for (int tiles : {1, 2, 5, 16, 64}) {
+		for (uint seed = 0; seed < 8; seed++) {
+			std::vector<ParentSpriteToDraw> sprites = MakeSprites(tiles, seed);
+			CHECK(SortSprites(&ViewportSortParentSpritesAVX2, sprites) == SortSprites(&ViewportSortParentSprites, sprites));
+		}
+	}
+}
+
+TEST_CASE("ViewportSortParentSprites - AVX2 sorter with sprites in reverse order")
+{
+	if (!ViewportSortParentSpritesAVX2Checker()) return;
+
+	std::vector<ParentSpriteToDraw> sprites = MakeSprites(32, 1);
+	std::reverse(sprites.begin(), sprites.end());
+	CHECK(SortSprites(&ViewportSortParentSpritesAVX2, sprites) == SortSprites(&ViewportSortParentSprites, sprites));
+}
+#endif /* WITH_SSE */
@@ -0,0 +1,50 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file worker_pool.cpp Test running jobs on the worker threads. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../worker_pool.h"
+
+TEST_CASE("RunWorkerJobs - no jobs")
+{
+	size_t runs = 0;
+	RunWorkerJobs(0, [&runs](size_t) { runs++; });
+	CHECK(runs == 0);
+}
+
+TEST_CASE("RunWorkerJobs - every job runs once")
+{
+	for (size_t count : {1, 2, 7, 1000}) {
+		std::vector<uint> runs(count);
+		RunWorkerJobs(count, [&runs](size_t index) { runs[index]++; });
+		for (size_t i = 0; i < count; i++) CHECK(runs[i] == 1);
+	}
+}
+
+TEST_CASE("RunWorkerJobs - batches after each other")
+{
+	std::vector<uint64_t> results(100);
+	for (uint64_t batch = 1; batch <= 10; batch++) {
+		RunWorkerJobs(results.size(), [&results, batch](size_t index) { results[index] += batch * index; });
+	}
+	for (size_t i = 0; i < results.size(); i++) CHECK(results[i] == 55 * i);
+}
+
+TEST_CASE("WorkerPool - first batch runs while the workers start")
+{
+	/* The workers are started by the first batch, and might only get to wait for work after it was handed out. */
+	for (int i = 0; i < 20; i++) {
+		WorkerPool pool(3);
+		std::vector<uint> runs(100);
+		pool.Run(runs.size(), [&runs](size_t index) { runs[index]++; });
+		for (size_t j = 0; j < runs.size(); j++) CHECK(runs[j] == 1);
+	}
+}
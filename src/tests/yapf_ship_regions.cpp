@@ -0,0 +1,215 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file yapf_ship_regions.cpp Test and benchmark the cache of routes over water regions. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "mock_game.h"
+
+#include "../clear_map.h"
+#include "../map_func.h"
+#include "../pathfinder/water_regions.h"
+#include "../pathfinder/yapf/yapf.h"
+#include "../pathfinder/yapf/yapf_ship_regions.h"
+#include "../ship.h"
+#include "../void_map.h"
+#include "../water_map.h"
+
+#include "../safeguards.h"
+
+/**
+ * Turn the whole map into sea, with the edges of the map void like in a game.
+ * @param island Whether there is land at a water region.
+ */
+static void MakeMockOcean(std::function<bool(int, int)> island)
+{
+	for (const auto tile : Map::Iterate()) {
+		if (TileX(tile) == Map::MaxX() || TileY(tile) == Map::MaxY()) {
+			MakeVoid(tile);
+		} else if (island(TileX(tile) / WATER_REGION_EDGE_LENGTH, TileY(tile) / WATER_REGION_EDGE_LENGTH)) {
+			MakeClear(tile, CLEAR_GRASS, 3);
+		} else {
+			MakeSea(tile);
+		}
+	}
+}
+
+/**
+ * Get a tile in the middle of a water region, away from its edges.
+ * @param x The X coordinate of the water region.
+ * @param y The Y coordinate of the water region.
+ * @return The tile.
+ */
+static TileIndex GetMockRegionTile(int x, int y)
+{
+	return TileXY(x * WATER_REGION_EDGE_LENGTH + WATER_REGION_EDGE_LENGTH / 2, y * WATER_REGION_EDGE_LENGTH + WATER_REGION_EDGE_LENGTH / 2);
+}
+
+/**
+ * Change a tile from sea to land or the other way around, like when a company builds or removes something on the water.
+ * @param tile The tile.
+ */
+static void ToggleMockSea(TileIndex tile)
+{
+	if (IsTileType(tile, MP_WATER)) {
+		MakeClear(tile, CLEAR_GRASS, 3);
+	} else {
+		MakeSea(tile);
+	}
+	InvalidateWaterRegion(tile);
+}
+
+TEST_CASE("YapfShipFindWaterRegionPath - only changes to regions the search looked at drop the route")
+{
+	MockGameInitialize(128, 128);
+	MakeMockOcean([](int, int) { return false; });
+
+	Ship *v = BuildMockShip(GetMockRegionTile(1, 1), DIAGDIR_SW);
+	REQUIRE(v != nullptr);
+	v->dest_tile = GetMockRegionTile(2, 1);
+
+	auto find_route = [v]() {
+		const WaterRegionRouteCacheStatistics before = GetWaterRegionRouteCacheStatistics();
+		CHECK(YapfShipFindWaterRegionPath(v, v->tile, 4).size() == 2);
+		const WaterRegionRouteCacheStatistics after = GetWaterRegionRouteCacheStatistics();
+		CHECK(after.lookups == before.lookups + 1);
+		return after.hits > before.hits;
+	};
+
+	CHECK_FALSE(find_route());
+	CHECK(find_route());
+
+	/* Nothing on the other side of the map can change this route. */
+	const TileIndex far_tile = GetMockRegionTile(6, 6);
+	GetWaterRegionPatchInfo(far_tile);
+	uint32_t version = GetWaterRegionsVersion();
+	ToggleMockSea(far_tile);
+	CHECK(GetWaterRegionsVersion() != version);
+	CHECK(find_route());
+
+	/* A change to the region the route ends in can. */
+	version = GetWaterRegionsVersion();
+	ToggleMockSea(GetMockRegionTile(2, 1) + TileDiffXY(3, 3));
+	CHECK(GetWaterRegionsVersion() != version);
+	CHECK_FALSE(find_route());
+	CHECK(find_route());
+
+	/* So can a change to a region next to the route, as it decides where the route can go. */
+	version = GetWaterRegionsVersion();
+	ToggleMockSea(GetMockRegionTile(2, 0));
+	CHECK(GetWaterRegionsVersion() != version);
+	CHECK_FALSE(find_route());
+
+	MockGameUninitialize();
+}
+
+/** Result of letting ships sail the ocean for a while. */
+struct ShipSailingRun {
+	uint decisions = 0; ///< Number of times a ship chose a track.
+	WaterRegionRouteCacheStatistics routes{}; ///< Lookups and hits of routes over water regions for those decisions.
+	std::chrono::steady_clock::duration duration{}; ///< Time the decisions took.
+};
+
+/**
+ * Let each ship choose a track once in every water region it enters, and sail it to the next region on its route.
+ * A ship that arrives turns back to where it came from.
+ * @param ships The ships with their ports.
+ * @param rounds The number of water regions each ship sails through.
+ * @param between_rounds Called after every round, to change the water.
+ * @return What the decisions of the ships cost.
+ */
+static ShipSailingRun SailMockShips(std::vector<std::pair<Ship *, TileIndex>> &ships, uint rounds, std::function<void(uint)> between_rounds)
+{
+	ShipSailingRun run;
+	for (uint round = 0; round < rounds; round++) {
+		for (auto &[v, origin] : ships) {
+			const WaterRegionRouteCacheStatistics before = GetWaterRegionRouteCacheStatistics();
+			const auto start = std::chrono::steady_clock::now();
+			bool path_found;
+			YapfShipChooseTrack(v, v->tile, path_found, v->path);
+			run.duration += std::chrono::steady_clock::now() - start;
+			const WaterRegionRouteCacheStatistics after = GetWaterRegionRouteCacheStatistics();
+			run.routes.lookups += after.lookups - before.lookups;
+			run.routes.hits += after.hits - before.hits;
+			run.decisions++;
+			v->path.clear();
+
+			const std::vector<WaterRegionPatchDesc> route = YapfShipFindWaterRegionPath(v, v->tile, 2);
+			if (route.size() < 2) {
+				std::swap(v->dest_tile, origin);
+				continue;
+			}
+
+			const WaterRegionDesc from(route[0]);
+			const WaterRegionDesc to(route[1]);
+			const DiagDirection direction = to.x > from.x ? DIAGDIR_SW : to.x < from.x ? DIAGDIR_NE : to.y > from.y ? DIAGDIR_SE : DIAGDIR_NW;
+			v->tile = GetMockRegionTile(to.x, to.y);
+			v->state = DiagDirToDiagTrackBits(direction);
+			v->direction = DiagDirToDir(direction);
+		}
+		between_rounds(round);
+	}
+	return run;
+}
+
+/**
+ * Print what the decisions of the ships cost.
+ * @param name The name of the run.
+ * @param run The run.
+ */
+static void ReportShipSailingRun(std::string_view name, const ShipSailingRun &run)
+{
+	using std::chrono::duration_cast, std::chrono::microseconds;
+	fmt::print("{}: {} decisions, {} us per decision, {} of {} routes over water regions from the cache ({}%)\n",
+			name, run.decisions, duration_cast<microseconds>(run.duration).count() / run.decisions,
+			run.routes.hits, run.routes.lookups, run.routes.hits * 100 / std::max<uint64_t>(run.routes.lookups, 1));
+}
+
+TEST_CASE("YapfShipChooseTrack - benchmark 512 ships between 16 ports on a 1024x1024 ocean", "[.benchmark]")
+{
+	MockGameInitialize(1024, 1024);
+	const uint32_t old_curve45_penalty = _settings_game.pf.yapf.ship_curve45_penalty;
+	const uint32_t old_curve90_penalty = _settings_game.pf.yapf.ship_curve90_penalty;
+	_settings_game.pf.yapf.ship_curve45_penalty = 1 * YAPF_TILE_LENGTH;
+	_settings_game.pf.yapf.ship_curve90_penalty = 6 * YAPF_TILE_LENGTH;
+
+	/* Islands of 2x2 water regions, every 8 water regions, leave lanes of open sea in between. */
+	MakeMockOcean([](int x, int y) { return x % 8 >= 3 && x % 8 < 5 && y % 8 >= 3 && y % 8 < 5; });
+
+	/* The ports are spread over the ocean, in the lanes. */
+	std::vector<TileIndex> ports;
+	for (int y = 0; y < 4; y++) {
+		for (int x = 0; x < 4; x++) ports.push_back(GetMockRegionTile(x * 16 + 1 + y, y * 16 + 6 + x));
+	}
+
+	std::vector<std::pair<Ship *, TileIndex>> ships;
+	for (uint i = 0; i < 512; i++) {
+		const TileIndex origin = ports[i % ports.size()];
+		Ship *v = BuildMockShip(origin, DIAGDIR_SW);
+		REQUIRE(v != nullptr);
+		v->dest_tile = ports[(i * 7 + i / ports.size() + 1) % ports.size()];
+		if (v->dest_tile == origin) v->dest_tile = ports[(i + 1) % ports.size()];
+		ships.emplace_back(v, origin);
+	}
+
+	ReportShipSailingRun("First voyages", SailMockShips(ships, 32, [](uint) {}));
+	ReportShipSailingRun("Same lanes again", SailMockShips(ships, 32, [](uint) {}));
+
+	/* Every round something is built or removed in a different water region somewhere on the ocean. */
+	ReportShipSailingRun("A water region changes every round", SailMockShips(ships, 32, [](uint round) {
+		const int x = (round * 13 + 5) % (Map::SizeX() / WATER_REGION_EDGE_LENGTH);
+		const int y = (round * 29 + 11) % (Map::SizeY() / WATER_REGION_EDGE_LENGTH);
+		ToggleMockSea(GetMockRegionTile(x, y) + TileDiffXY(3, 3));
+	}));
+
+	_settings_game.pf.yapf.ship_curve45_penalty = old_curve45_penalty;
+	_settings_game.pf.yapf.ship_curve90_penalty = old_curve90_penalty;
+	MockGameUninitialize();
+}
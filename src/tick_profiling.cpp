@@ -0,0 +1,230 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file tick_profiling.cpp Hierarchical profiling of the game loop, tick by tick. */
+
+#include "stdafx.h"
+#include "tick_profiling.h"
+#include "fileio_func.h"
+#include "console_func.h"
+#include "3rdparty/fmt/chrono.h"
+#include "timer/timer_game_tick.h"
+
+#include "safeguards.h"
+
+static TickProfiler::Tick _current_tick; ///< The tick that is being recorded.
+static uint32_t _current_node; ///< Index of the innermost zone that has been entered in the current tick.
+static std::vector<TickProfiler::Tick> _slowest_ticks; ///< Slowest ticks so far, as a heap with the fastest of them at the front.
+static size_t _keep_ticks; ///< Number of slowest ticks to keep.
+static uint64_t _stop_counter; ///< Tick counter at which to stop profiling, or 0 to profile until stopped.
+static uint64_t _ticks_profiled; ///< Number of ticks that have been profiled.
+static uint64_t _total_time; ///< Total time of all profiled ticks (nanoseconds).
+
+/**
+ * Order ticks so the fastest one ends up at the front of the heap.
+ * @param a The first tick.
+ * @param b The second tick.
+ * @return True iff \a a took longer than \a b.
+ */
+static bool TickSlowerThan(const TickProfiler::Tick &a, const TickProfiler::Tick &b)
+{
+	return a.GetTime() > b.GetTime();
+}
+
+/**
+ * Get the time elapsed since the given moment.
+ * @param start The moment.
+ * @return Elapsed time in nanoseconds.
+ */
+static uint64_t GetNanosecondsSince(TickProfiler::TimePoint start)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/**
+ * Start profiling.
+ * @param keep Number of slowest ticks to keep.
+ * @param ticks Number of ticks after which profiling stops, or 0 to profile until stopped.
+ */
+/* static */ void TickProfiler::Start(size_t keep, uint64_t ticks)
+{
+	_slowest_ticks.clear();
+	_keep_ticks = std::max<size_t>(keep, 1);
+	_stop_counter = ticks == 0 ? 0 : TimerGameTick::counter + ticks;
+	_ticks_profiled = 0;
+	_total_time = 0;
+	TickProfiler::enabled = true;
+}
+
+/**
+ * Stop profiling and write the slowest ticks to a file.
+ * When called during a tick, this happens at the end of that tick.
+ */
+/* static */ void TickProfiler::Stop()
+{
+	if (!TickProfiler::enabled) return;
+
+	TickProfiler::enabled = false;
+	if (!TickProfiler::recording) TickProfiler::Finish();
+}
+
+/**
+ * Stop profiling and discard all collected data.
+ */
+/* static */ void TickProfiler::Abort()
+{
+	TickProfiler::enabled = false;
+	_keep_ticks = 0;
+	_slowest_ticks.clear();
+}
+
+/**
+ * Start recording a tick, if profiling is enabled.
+ */
+/* static */ void TickProfiler::BeginTick()
+{
+	if (!TickProfiler::enabled) return;
+
+	TickProfiler::recording = true;
+	_current_tick.counter = TimerGameTick::counter;
+	_current_tick.nodes.clear();
+	_current_tick.nodes.push_back({{"tick", 0}, INVALID_NODE, INVALID_NODE, INVALID_NODE, 1, 0, std::chrono::high_resolution_clock::now()});
+	_current_node = 0;
+}
+
+/**
+ * Finish recording a tick, and keep it when it is one of the slowest.
+ */
+/* static */ void TickProfiler::EndTick()
+{
+	if (!TickProfiler::recording) return;
+
+	assert(_current_node == 0);
+	Node &root = _current_tick.nodes.front();
+	root.time = GetNanosecondsSince(root.start);
+	TickProfiler::recording = false;
+
+	_ticks_profiled++;
+	_total_time += root.time;
+
+	if (_slowest_ticks.size() < _keep_ticks) {
+		_slowest_ticks.push_back(std::move(_current_tick));
+		std::push_heap(_slowest_ticks.begin(), _slowest_ticks.end(), TickSlowerThan);
+		_current_tick = {};
+	} else if (_keep_ticks > 0 && root.time > _slowest_ticks.front().GetTime()) {
+		std::pop_heap(_slowest_ticks.begin(), _slowest_ticks.end(), TickSlowerThan);
+		/* Swap rather than copy, so the storage of the dropped tick is reused for the next one. */
+		std::swap(_slowest_ticks.back(), _current_tick);
+		std::push_heap(_slowest_ticks.begin(), _slowest_ticks.end(), TickSlowerThan);
+	}
+
+	if (TickProfiler::enabled && _stop_counter != 0 && TimerGameTick::counter >= _stop_counter) TickProfiler::enabled = false;
+	if (!TickProfiler::enabled) TickProfiler::Finish();
+}
+
+/**
+ * Enter a zone in the current tick.
+ * @param label The zone.
+ */
+/* static */ void TickProfiler::Enter(Label label)
+{
+	std::vector<Node> &nodes = _current_tick.nodes;
+
+	uint32_t index = nodes[_current_node].first_child;
+	while (index != INVALID_NODE && nodes[index].label != label) index = nodes[index].next_sibling;
+
+	if (index == INVALID_NODE) {
+		index = static_cast<uint32_t>(nodes.size());
+		nodes.push_back({label, _current_node, INVALID_NODE, nodes[_current_node].first_child, 0, 0, {}});
+		nodes[_current_node].first_child = index;
+	}
+
+	Node &node = nodes[index];
+	node.calls++;
+	node.start = std::chrono::high_resolution_clock::now();
+	_current_node = index;
+}
+
+/**
+ * Leave the innermost zone of the current tick.
+ */
+/* static */ void TickProfiler::Leave()
+{
+	assert(_current_node != 0);
+	Node &node = _current_tick.nodes[_current_node];
+	node.time += GetNanosecondsSince(node.start);
+	_current_node = node.parent;
+}
+
+/**
+ * Get the name of a zone as it is written to the output.
+ * @param node The zone.
+ * @return The name, with the number of calls when there was more than one.
+ */
+static std::string GetZoneName(const TickProfiler::Node &node)
+{
+	std::string_view name = node.label.name;
+	if (node.label.line != 0) {
+		/* Only keep the file name of source locations. */
+		size_t pos = name.find_last_of("/\\");
+		if (pos != std::string_view::npos) name = name.substr(pos + 1);
+		if (node.calls > 1) return fmt::format("{}:{} ({} calls)", name, node.label.line, node.calls);
+		return fmt::format("{}:{}", name, node.label.line);
+	}
+	if (node.calls > 1) return fmt::format("{} ({} calls)", name, node.calls);
+	return std::string(name);
+}
+
+/**
+ * Write a zone and all zones entered from it as folded stacks.
+ * @param f The file to write to.
+ * @param tick The tick the zone belongs to.
+ * @param index Index of the zone in the tick.
+ * @param stack The folded stack of the zones the zone was entered from.
+ */
+static void WriteFoldedStacks(FileHandle &f, const TickProfiler::Tick &tick, uint32_t index, const std::string &stack)
+{
+	const TickProfiler::Node &node = tick.nodes[index];
+	std::string node_stack = index == 0 ? fmt::format("tick {}", tick.counter) : fmt::format("{};{}", stack, GetZoneName(node));
+
+	uint64_t self = node.time;
+	for (uint32_t child = node.first_child; child != TickProfiler::INVALID_NODE; child = tick.nodes[child].next_sibling) {
+		self -= std::min(self, tick.nodes[child].time);
+		WriteFoldedStacks(f, tick, child, node_stack);
+	}
+
+	if (self > 0) fmt::print(f, "{} {}\n", node_stack, self);
+}
+
+/**
+ * Write the slowest ticks to a file, and reset the profiler.
+ */
+/* static */ void TickProfiler::Finish()
+{
+	if (_keep_ticks == 0) return;
+
+	if (_slowest_ticks.empty()) {
+		IConsolePrint(CC_DEBUG, "Finished tick profile, no ticks recorded, not writing a file.");
+		TickProfiler::Abort();
+		return;
+	}
+
+	std::sort_heap(_slowest_ticks.begin(), _slowest_ticks.end(), TickSlowerThan);
+
+	std::string filename = fmt::format("{}tickprofile-{:%Y%m%d-%H%M}.txt", FiosGetScreenshotDir(), fmt::localtime(time(nullptr)));
+	IConsolePrint(CC_DEBUG, "Finished tick profile over {} ticks, average {} us, slowest {} us.", _ticks_profiled, _total_time / _ticks_profiled / 1000, _slowest_ticks.front().GetTime() / 1000);
+	IConsolePrint(CC_DEBUG, "Writing the {} slowest ticks as folded stacks in nanoseconds to '{}'.", _slowest_ticks.size(), filename);
+
+	auto f = FioFOpenFile(filename, "wt", Subdirectory::NO_DIRECTORY);
+	if (!f.has_value()) {
+		IConsolePrint(CC_ERROR, "Failed to open '{}' for writing.", filename);
+	} else {
+		for (const Tick &tick : _slowest_ticks) WriteFoldedStacks(*f, tick, 0, {});
+	}
+
+	TickProfiler::Abort();
+}
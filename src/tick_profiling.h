@@ -0,0 +1,121 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file tick_profiling.h Hierarchical profiling of the game loop, tick by tick. */
+
+#ifndef TICK_PROFILING_H
+#define TICK_PROFILING_H
+
+#include <chrono>
+
+/**
+ * Profiler of the state game loop.
+ *
+ * While it is enabled every game tick is recorded as a tree of named zones,
+ * with the time spent in and the number of calls of each zone. The slowest
+ * ticks are kept, and written as folded stacks for flame graph tools when
+ * the profiler is stopped.
+ */
+struct TickProfiler {
+	using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+	/** Identification of a zone: either a plain name, or a location in the source. */
+	struct Label {
+		const char *name; ///< Name of the zone, or the file name of the source location. Must be a string with static storage.
+		uint32_t line; ///< Line in the file of the source location, or 0 for a plain name.
+
+		bool operator==(const Label &other) const = default;
+	};
+
+	/** A zone within a recorded tick. */
+	struct Node {
+		Label label; ///< The zone.
+		uint32_t parent; ///< Index of the zone this zone was entered from.
+		uint32_t first_child; ///< Index of the first zone entered from this zone, or INVALID_NODE.
+		uint32_t next_sibling; ///< Index of the next zone entered from the same parent, or INVALID_NODE.
+		uint32_t calls; ///< Number of times this zone was entered.
+		uint64_t time; ///< Total time spent in this zone (nanoseconds).
+		TimePoint start; ///< Time this zone was last entered.
+	};
+
+	/** A recorded tick. */
+	struct Tick {
+		uint64_t counter; ///< Value of TimerGameTick::counter at the start of the tick.
+		std::vector<Node> nodes; ///< Zones entered during the tick; the first one is the tick itself.
+
+		/**
+		 * Get the total time the tick took.
+		 * @return Time in nanoseconds.
+		 */
+		uint64_t GetTime() const { return this->nodes.front().time; }
+	};
+
+	static constexpr uint32_t INVALID_NODE = UINT32_MAX; ///< Index of no node.
+	static constexpr size_t DEFAULT_KEEP_TICKS = 10; ///< Default number of slowest ticks to keep.
+
+	static void Start(size_t keep, uint64_t ticks);
+	static void Stop();
+	static void Abort();
+	static bool IsEnabled() { return TickProfiler::enabled; }
+
+	static void BeginTick();
+	static void EndTick();
+
+	/**
+	 * Check whether zones are currently being recorded.
+	 * @return True iff a tick is being recorded.
+	 */
+	static inline bool IsRecording() { return TickProfiler::recording; }
+
+	static void Enter(Label label);
+	static void Leave();
+
+private:
+	static void Finish();
+
+	static inline bool enabled = false; ///< Whether ticks are to be recorded.
+	static inline bool recording = false; ///< Whether the current tick is being recorded.
+};
+
+/**
+ * Scoped zone of the tick profiler.
+ * When the profiler is not recording this costs a single test of a flag.
+ */
+class TickProfilerZone {
+public:
+	/**
+	 * Enter a zone with a plain name.
+	 * @param name Name of the zone; it must have static storage.
+	 */
+	inline TickProfilerZone(const char *name) : active(TickProfiler::IsRecording())
+	{
+		if (this->active) TickProfiler::Enter({name, 0});
+	}
+
+	/**
+	 * Enter a zone named after a location in the source.
+	 * @param location The location, usually where a timer or callback was defined.
+	 */
+	inline TickProfilerZone(const std::source_location &location) : active(TickProfiler::IsRecording())
+	{
+		if (this->active) TickProfiler::Enter({location.file_name(), location.line()});
+	}
+
+	/** Leave the zone. */
+	inline ~TickProfilerZone()
+	{
+		if (this->active) TickProfiler::Leave();
+	}
+
+	TickProfilerZone(const TickProfilerZone &) = delete;
+	TickProfilerZone &operator=(const TickProfilerZone &) = delete;
+
+private:
+	bool active; ///< Whether the zone was entered while recording.
+};
+
+#endif /* TICK_PROFILING_H */
@@ -29,9 +29,10 @@ public:
 	 * Create a new timer.
 	 *
 	 * @param period The period of the timer.
+	 * @param location Where the timer is defined, to identify it when profiling.
 	 */
-	[[nodiscard]] BaseTimer(const TPeriod period) :
-		period(period)
+	[[nodiscard]] BaseTimer(const TPeriod period, const std::source_location &location) :
+		period(period), location(location)
 	{
 		TimerManager<TTimerType>::RegisterTimer(*this);
 	}
@@ -48,6 +49,7 @@ public:
 
 	TPeriod period; ///< The period of the timer.
 	TStorage storage = {}; ///< The storage of the timer.
+	const std::source_location location; ///< Where the timer is defined.
 
 protected:
 	/**
@@ -83,9 +85,10 @@ public:
 	 *
 	 * @param interval The interval between each callback.
 	 * @param callback The callback to call when the interval has passed.
+	 * @param location Where the timer is defined; leave it to the default.
 	 */
-	[[nodiscard]] IntervalTimer(const TPeriod interval, std::function<void(uint)> callback) :
-		BaseTimer<TTimerType>(interval),
+	[[nodiscard]] IntervalTimer(const TPeriod interval, std::function<void(uint)> callback, const std::source_location location = std::source_location::current()) :
+		BaseTimer<TTimerType>(interval, location),
 		callback(std::move(callback))
 	{
 	}
@@ -126,9 +129,10 @@ public:
 	 * @param timeout The timeout after which the timer will fire.
 	 * @param callback The callback to call when the timeout has passed.
 	 * @param start Whether to start the timer immediately. If false, you can call Reset() to start it.
+	 * @param location Where the timer is defined; leave it to the default.
 	 */
-	[[nodiscard]] TimeoutTimer(const TPeriod timeout, std::function<void()> callback, bool start = false) :
-		BaseTimer<TTimerType>(timeout),
+	[[nodiscard]] TimeoutTimer(const TPeriod timeout, std::function<void()> callback, bool start = false, const std::source_location location = std::source_location::current()) :
+		BaseTimer<TTimerType>(timeout, location),
 		fired(!start),
 		callback(std::move(callback))
 	{
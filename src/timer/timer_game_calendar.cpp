@@ -25,6 +25,7 @@
 #include "timer.h"
 #include "timer_game_calendar.h"
 #include "../vehicle_base.h"
+#include "../tick_profiling.h"
 
 #include "../safeguards.h"
 
@@ -78,6 +79,7 @@ template <>
 void IntervalTimer<TimerGameCalendar>::Elapsed(TimerGameCalendar::TElapsed trigger)
 {
 	if (trigger == this->period.trigger) {
+		TickProfilerZone zone(this->location);
 		this->callback(1);
 	}
 }
@@ -88,6 +90,7 @@ void TimeoutTimer<TimerGameCalendar>::Elapsed(TimerGameCalendar::TElapsed trigge
 	if (this->fired) return;
 
 	if (trigger == this->period.trigger) {
+		TickProfilerZone zone(this->location);
 		this->callback();
 		this->fired = true;
 	}
@@ -30,6 +30,7 @@
 #include "timer_game_tick.h"
 #include "../vehicle_base.h"
 #include "../linkgraph/linkgraph.h"
+#include "../tick_profiling.h"
 
 #include "../safeguards.h"
 
@@ -105,6 +106,7 @@ template <>
 void IntervalTimer<TimerGameEconomy>::Elapsed(TimerGameEconomy::TElapsed trigger)
 {
 	if (trigger == this->period.trigger) {
+		TickProfilerZone zone(this->location);
 		this->callback(1);
 	}
 }
@@ -115,6 +117,7 @@ void TimeoutTimer<TimerGameEconomy>::Elapsed(TimerGameEconomy::TElapsed trigger)
 	if (this->fired) return;
 
 	if (trigger == this->period.trigger) {
+		TickProfilerZone zone(this->location);
 		this->callback();
 		this->fired = true;
 	}
@@ -13,6 +13,7 @@
 #include "../stdafx.h"
 #include "timer.h"
 #include "timer_game_tick.h"
+#include "../tick_profiling.h"
 
 #include "../safeguards.h"
 
@@ -32,6 +33,7 @@ void IntervalTimer<TimerGameTick>::Elapsed(TimerGameTick::TElapsed delta)
 	}
 
 	if (count > 0) {
+		TickProfilerZone zone(this->location);
 		this->callback(count);
 	}
 }
@@ -45,6 +47,7 @@ void TimeoutTimer<TimerGameTick>::Elapsed(TimerGameTick::TElapsed delta)
 	this->storage.elapsed += delta;
 
 	if (this->storage.elapsed >= this->period.value) {
+		TickProfilerZone zone(this->location);
 		this->callback();
 		this->fired = true;
 	}
@@ -159,12 +159,8 @@ static void FillTimetableArrivalDepartureTable(const Vehicle *v, VehicleOrderID
 		}
 
 		++i;
-		order = order->next;
-		if (i >= v->GetNumOrders()) {
-			i = 0;
-			assert(order == nullptr);
-			order = v->orders->GetFirstOrder();
-		}
+		if (i >= v->GetNumOrders()) i = 0;
+		order = v->orders->GetOrderAt(i);
 	} while (i != start);
 
 	/* When loading at a scheduled station we still have to treat the
@@ -468,7 +464,7 @@ struct TimetableWindow : Window {
 					order = v->GetOrder(0);
 					final_order = true;
 				} else {
-					order = order->next;
+					order = v->GetOrder(order_id);
 				}
 			} else {
 				TextColour colour;
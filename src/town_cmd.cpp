@@ -18,6 +18,7 @@
 #include "company_func.h"
 #include "industry.h"
 #include "station_base.h"
+#include "station_func.h"
 #include "waypoint_base.h"
 #include "station_kdtree.h"
 #include "company_base.h"
@@ -2510,6 +2511,7 @@ static inline void ClearMakeHouseTile(TileIndex tile, Town *t, uint8_t counter,
 
 	IncreaseBuildingCount(t, type);
 	MakeHouseTile(tile, t->index, counter, stage, type, random_bits, is_protected);
+	AddTileAcceptanceToStations(tile);
 	if (HouseSpec::Get(type)->building_flags.Test(BuildingFlag::IsAnimated)) AddAnimatedTile(tile, false);
 
 	MarkTileDirtyByTile(tile);
@@ -2955,6 +2957,8 @@ CommandCost CmdPlaceHouse(DoCommandFlags flags, TileIndex tile, HouseID house, b
 static void DoClearTownHouseHelper(TileIndex tile, Town *t, HouseID house)
 {
 	assert(IsTileType(tile, MP_HOUSE));
+	RemoveTileAcceptanceFromStations(tile);
+	InvalidateHouseTileStations(tile);
 	DecreaseBuildingCount(t, house);
 	DoClearSquare(tile);
 
@@ -4085,6 +4089,26 @@ static IntervalTimer<TimerGameEconomy> _economy_towns_monthly({TimerGameEconomy:
 		for (auto &supplied : t->supplied) supplied.NewMonth();
 		for (auto &received : t->received) received.NewMonth();
 
+		/* When spread, growth and rating are updated during the month, based on the statistics of the month that just ended. */
+		if (_economy.spread_monthly_loop) continue;
+
+		UpdateTownGrowth(t);
+		UpdateTownRating(t);
+
+		SetWindowDirty(WC_TOWN_VIEW, t->index);
+	}
+});
+
+/** Monthly growth and rating updates of today's part of the towns, when they are spread over the month. */
+static IntervalTimer<TimerGameEconomy> _economy_towns_month_slice({TimerGameEconomy::DAY, TimerGameEconomy::Priority::TOWN}, [](auto)
+{
+	std::optional<uint> slice = GetEconomyMonthSlice();
+	if (!slice.has_value()) return;
+
+	for (size_t index = *slice; index < Town::GetPoolSize(); index += ECONOMY_MONTH_SLICES) {
+		Town *t = Town::GetIfValid(index);
+		if (t == nullptr) continue;
+
 		UpdateTownGrowth(t);
 		UpdateTownRating(t);
 
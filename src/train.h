@@ -81,6 +81,8 @@ struct TrainCache {
 	int16_t cached_curve_speed_mod = 0; ///< curve speed modifier of the entire train
 	uint16_t cached_max_curve_speed = 0; ///< max consist speed limited by curves
 
+	bool cached_unstable_callbacks = false; ///< the cached values depend on NewGRF callbacks whose result can change while the consist stays the same
+
 	auto operator<=>(const TrainCache &) const = default;
 };
 
@@ -135,6 +137,7 @@ struct Train final : public GroundVehicle<Train, VEH_TRAIN> {
 	uint16_t GetCurveSpeedLimit() const;
 
 	void ConsistChanged(ConsistChangeFlags allowed_changes);
+	void RailTypeChanged();
 
 	int UpdateSpeed();
 
@@ -108,6 +108,7 @@ void CheckTrainsLengths()
 void Train::ConsistChanged(ConsistChangeFlags allowed_changes)
 {
 	uint16_t max_speed = UINT16_MAX;
+	uint unstable_callbacks = GetUnstableVehicleCallbackCount();
 
 	assert(this->IsFrontEngine() || this->IsFreeWagon());
 
@@ -239,6 +240,9 @@ void Train::ConsistChanged(ConsistChangeFlags allowed_changes)
 	/* recalculate cached weights and power too (we do this *after* the rest, so it is known which wagons are powered and need extra weight added) */
 	this->CargoChanged();
 
+	/* Unless a callback can give another result, only the rail type under the parts can change the cached values. */
+	this->tcache.cached_unstable_callbacks = GetUnstableVehicleCallbackCount() != unstable_callbacks;
+
 	if (this->IsFrontEngine()) {
 		this->UpdateAcceleration();
 		SetWindowDirty(WC_VEHICLE_DETAILS, this->index);
@@ -248,6 +252,24 @@ void Train::ConsistChanged(ConsistChangeFlags allowed_changes)
 	}
 }
 
+/**
+ * Recalculates the cached stuff of a train after some of its parts moved to a tile with another rail type.
+ * Only the power and track speed depend on the rail type under the parts, so only those are recalculated,
+ * unless NewGRF callbacks of the consist can give another result than when the consist was last changed.
+ */
+void Train::RailTypeChanged()
+{
+	assert(this->IsFrontEngine() || this->IsFreeWagon());
+
+	if (this->tcache.cached_unstable_callbacks) {
+		this->ConsistChanged(CCF_TRACK);
+		return;
+	}
+
+	this->PowerChanged();
+	if (this->IsFrontEngine()) this->UpdateAcceleration();
+}
+
 /**
  * Get the stop location of (the center) of the front vehicle of a train at
  * a platform of a station.
@@ -1554,35 +1576,33 @@ static void MarkTrainAsStuck(Train *v)
 	}
 }
 
+/**
+ * Get the up/down flags of a vehicle after it has been reversed.
+ * @param flags The flags before reversing.
+ * @return #GVF_GOINGDOWN_BIT if it was going up, #GVF_GOINGUP_BIT if it was going down, otherwise nothing.
+ */
+static uint16_t ReverseInclination(uint16_t flags)
+{
+	if (HasBit(flags, GVF_GOINGUP_BIT)) return 1U << GVF_GOINGDOWN_BIT;
+	if (HasBit(flags, GVF_GOINGDOWN_BIT)) return 1U << GVF_GOINGUP_BIT;
+	return 0;
+}
+
 /**
  * Swap the two up/down flags in two ways:
- * - Swap values of \a swap_flag1 and \a swap_flag2, and
+ * - Swap values of the flags of \a a and \a b, and
  * - If going up previously (#GVF_GOINGUP_BIT set), the #GVF_GOINGDOWN_BIT is set, and vice versa.
- * @param[in,out] swap_flag1 First train flag.
- * @param[in,out] swap_flag2 Second train flag.
+ * @param[in,out] a First train part.
+ * @param[in,out] b Second train part.
  */
-static void SwapTrainFlags(uint16_t *swap_flag1, uint16_t *swap_flag2)
+static void SwapTrainFlags(Train *a, Train *b)
 {
-	uint16_t flag1 = *swap_flag1;
-	uint16_t flag2 = *swap_flag2;
-
-	/* Clear the flags */
-	ClrBit(*swap_flag1, GVF_GOINGUP_BIT);
-	ClrBit(*swap_flag1, GVF_GOINGDOWN_BIT);
-	ClrBit(*swap_flag2, GVF_GOINGUP_BIT);
-	ClrBit(*swap_flag2, GVF_GOINGDOWN_BIT);
+	uint16_t flag1 = a->gv_flags;
+	uint16_t flag2 = b->gv_flags;
 
 	/* Reverse the rail-flags (if needed) */
-	if (HasBit(flag1, GVF_GOINGUP_BIT)) {
-		SetBit(*swap_flag2, GVF_GOINGDOWN_BIT);
-	} else if (HasBit(flag1, GVF_GOINGDOWN_BIT)) {
-		SetBit(*swap_flag2, GVF_GOINGUP_BIT);
-	}
-	if (HasBit(flag2, GVF_GOINGUP_BIT)) {
-		SetBit(*swap_flag1, GVF_GOINGDOWN_BIT);
-	} else if (HasBit(flag2, GVF_GOINGDOWN_BIT)) {
-		SetBit(*swap_flag1, GVF_GOINGUP_BIT);
-	}
+	b->SetInclination(ReverseInclination(flag1));
+	a->SetInclination(ReverseInclination(flag2));
 }
 
 /**
@@ -1650,7 +1670,7 @@ void ReverseTrainSwapVeh(Train *v, int l, int r)
 		Swap(a->tile,  b->tile);
 		Swap(a->z_pos, b->z_pos);
 
-		SwapTrainFlags(&a->gv_flags, &b->gv_flags);
+		SwapTrainFlags(a, b);
 
 		UpdateStatusAfterSwap(a);
 		UpdateStatusAfterSwap(b);
@@ -1658,7 +1678,7 @@ void ReverseTrainSwapVeh(Train *v, int l, int r)
 		/* Swap GVF_GOINGUP_BIT/GVF_GOINGDOWN_BIT.
 		 * This is a little bit redundant way, a->gv_flags will
 		 * be (re)set twice, but it reduces code duplication */
-		SwapTrainFlags(&a->gv_flags, &a->gv_flags);
+		SwapTrainFlags(a, a);
 		UpdateStatusAfterSwap(a);
 	}
 }
@@ -1684,7 +1704,7 @@ bool TrainOnCrossing(TileIndex tile)
 {
 	assert(IsLevelCrossingTile(tile));
 
-	return HasVehicleOnPos(tile, nullptr, &TrainOnTileEnum);
+	return HasVehicleOnPos(tile, VEH_TRAIN, nullptr, &TrainOnTileEnum);
 }
 
 
@@ -1722,12 +1742,12 @@ static bool TrainApproachingCrossing(TileIndex tile)
 	DiagDirection dir = AxisToDiagDir(GetCrossingRailAxis(tile));
 	TileIndex tile_from = tile + TileOffsByDiagDir(dir);
 
-	if (HasVehicleOnPos(tile_from, &tile, &TrainApproachingCrossingEnum)) return true;
+	if (HasVehicleOnPos(tile_from, VEH_TRAIN, &tile, &TrainApproachingCrossingEnum)) return true;
 
 	dir = ReverseDiagDir(dir);
 	tile_from = tile + TileOffsByDiagDir(dir);
 
-	return HasVehicleOnPos(tile_from, &tile, &TrainApproachingCrossingEnum);
+	return HasVehicleOnPos(tile_from, VEH_TRAIN, &tile, &TrainApproachingCrossingEnum);
 }
 
 /**
@@ -3465,7 +3485,7 @@ bool TrainController(Train *v, Vehicle *nomove, bool reverse)
 					v->tile = gp.new_tile;
 
 					if (GetTileRailType(gp.new_tile) != GetTileRailType(gp.old_tile)) {
-						v->First()->ConsistChanged(CCF_TRACK);
+						v->First()->RailTypeChanged();
 					}
 
 					v->track = chosen_track;
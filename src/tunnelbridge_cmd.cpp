@@ -564,6 +564,8 @@ CommandCost CmdBuildBridge(DoCommandFlags flags, TileIndex tile_end, TileIndex t
 		YapfNotifyTrackLayoutChange(tile_start, track);
 	}
 
+	if (flags.Test(DoCommandFlag::Execute) && transport_type == TRANSPORT_ROAD) YapfNotifyRoadLayoutChange(tile_start);
+
 	/* Human players that build bridges get a selection to choose from (DoCommandFlag::QueryCost)
 	 * It's unnecessary to execute this command every time for every bridge.
 	 * So it is done only for humans and cost is computed in bridge_gui.cpp.
@@ -768,6 +770,7 @@ CommandCost CmdBuildTunnel(DoCommandFlags flags, TileIndex start_tile, Transport
 			RoadType tram_rt = RoadTypeIsTram(roadtype) ? roadtype : INVALID_ROADTYPE;
 			MakeRoadTunnel(start_tile, company, direction,                 road_rt, tram_rt);
 			MakeRoadTunnel(end_tile,   company, ReverseDiagDir(direction), road_rt, tram_rt);
+			YapfNotifyRoadLayoutChange(start_tile);
 		}
 		DirtyCompanyInfrastructureWindows(company);
 	}
@@ -896,6 +899,8 @@ static CommandCost DoClearTunnel(TileIndex tile, DoCommandFlags flags)
 
 			DoClearSquare(tile);
 			DoClearSquare(endtile);
+
+			YapfNotifyRoadLayoutChange(tile);
 		}
 	}
 
@@ -960,6 +965,7 @@ static CommandCost DoClearBridge(TileIndex tile, DoCommandFlags flags)
 			/* A full diagonal road tile has two road bits. */
 			UpdateCompanyRoadInfrastructure(GetRoadTypeRoad(tile), GetRoadOwner(tile, RTT_ROAD), -(int)(len * 2 * TUNNELBRIDGE_TRACKBIT_FACTOR));
 			UpdateCompanyRoadInfrastructure(GetRoadTypeTram(tile), GetRoadOwner(tile, RTT_TRAM), -(int)(len * 2 * TUNNELBRIDGE_TRACKBIT_FACTOR));
+			YapfNotifyRoadLayoutChange(tile);
 		} else { // Aqueduct
 			if (Company::IsValidID(owner)) Company::Get(owner)->infrastructure.water -= len * TUNNELBRIDGE_TRACKBIT_FACTOR;
 		}
@@ -1854,12 +1860,8 @@ static void ChangeTileOwner_TunnelBridge(TileIndex tile, Owner old_owner, Owner
 template <typename T>
 static void PrepareToEnterBridge(T *gv)
 {
-	if (HasBit(gv->gv_flags, GVF_GOINGUP_BIT)) {
-		gv->z_pos++;
-		ClrBit(gv->gv_flags, GVF_GOINGUP_BIT);
-	} else {
-		ClrBit(gv->gv_flags, GVF_GOINGDOWN_BIT);
-	}
+	if (HasBit(gv->gv_flags, GVF_GOINGUP_BIT)) gv->z_pos++;
+	gv->SetInclination(0);
 }
 
 /**
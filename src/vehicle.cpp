@@ -47,10 +47,12 @@
 #include "bridge_map.h"
 #include "tunnel_map.h"
 #include "depot_map.h"
+#include "signal_func.h"
 #include "gamelog.h"
 #include "linkgraph/linkgraph.h"
 #include "linkgraph/refresh.h"
 #include "framerate_type.h"
+#include "tick_profiling.h"
 #include "autoreplace_cmd.h"
 #include "misc_cmd.h"
 #include "train_cmd.h"
@@ -381,13 +383,15 @@ const int TOTAL_HASH_MASK = TOTAL_HASH_SIZE - 1;
  * Profiling results show that 0 is fastest. */
 const int HASH_RES = 0;
 
-static std::array<Vehicle *, TOTAL_HASH_SIZE> _vehicle_tile_hash{};
+/** Tile location hash of the vehicles, one for each type of vehicle, so lookups for a single type do not visit the others. */
+static std::array<std::array<Vehicle *, TOTAL_HASH_SIZE>, VEH_END> _vehicle_tile_hash{};
 
-static Vehicle *VehicleFromTileHash(int xl, int yl, int xu, int yu, void *data, VehicleFromPosProc *proc, bool find_first)
+static Vehicle *VehicleFromTileHash(VehicleType type, int xl, int yl, int xu, int yu, void *data, VehicleFromPosProc *proc, bool find_first)
 {
+	const auto &hash = _vehicle_tile_hash[type];
 	for (int y = yl; ; y = (y + (1 << HASH_BITS)) & (HASH_MASK << HASH_BITS)) {
 		for (int x = xl; ; x = (x + 1) & HASH_MASK) {
-			Vehicle *v = _vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
+			Vehicle *v = hash[(x + y) & TOTAL_HASH_MASK];
 			for (; v != nullptr; v = v->hash_tile_next) {
 				Vehicle *a = proc(v, data);
 				if (find_first && a != nullptr) return a;
@@ -406,13 +410,14 @@ static Vehicle *VehicleFromTileHash(int xl, int yl, int xu, int yu, void *data,
  * @note Do not call this function directly!
  * @param x    The X location on the map
  * @param y    The Y location on the map
+ * @param type The type of vehicles to look for, or #VEH_INVALID for all types.
  * @param data Arbitrary data passed to proc
  * @param proc The proc that determines whether a vehicle will be "found".
  * @param find_first Whether to return on the first found or iterate over
  *                   all vehicles
  * @return the best matching or first vehicle (depending on find_first).
  */
-static Vehicle *VehicleFromPosXY(int x, int y, void *data, VehicleFromPosProc *proc, bool find_first)
+static Vehicle *VehicleFromPosXY(int x, int y, VehicleType type, void *data, VehicleFromPosProc *proc, bool find_first)
 {
 	const int COLL_DIST = 6;
 
@@ -422,7 +427,13 @@ static Vehicle *VehicleFromPosXY(int x, int y, void *data, VehicleFromPosProc *p
 	int yl = GB((y - COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS) << HASH_BITS;
 	int yu = GB((y + COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS) << HASH_BITS;
 
-	return VehicleFromTileHash(xl, yl, xu, yu, data, proc, find_first);
+	if (type != VEH_INVALID) return VehicleFromTileHash(type, xl, yl, xu, yu, data, proc, find_first);
+
+	for (VehicleType t = VEH_BEGIN; t != VEH_END; t++) {
+		Vehicle *a = VehicleFromTileHash(t, xl, yl, xu, yu, data, proc, find_first);
+		if (find_first && a != nullptr) return a;
+	}
+	return nullptr;
 }
 
 /**
@@ -441,7 +452,21 @@ static Vehicle *VehicleFromPosXY(int x, int y, void *data, VehicleFromPosProc *p
  */
 void FindVehicleOnPosXY(int x, int y, void *data, VehicleFromPosProc *proc)
 {
-	VehicleFromPosXY(x, y, data, proc, false);
+	VehicleFromPosXY(x, y, VEH_INVALID, data, proc, false);
+}
+
+/**
+ * Find a vehicle of a specific type from a specific location.
+ * This works like #FindVehicleOnPosXY, but \a proc is only called for vehicles of the given type.
+ * @param x    The X location on the map
+ * @param y    The Y location on the map
+ * @param type The type of vehicles to look for.
+ * @param data Arbitrary data passed to proc
+ * @param proc The proc that determines whether a vehicle will be "found".
+ */
+void FindVehicleOnPosXY(int x, int y, VehicleType type, void *data, VehicleFromPosProc *proc)
+{
+	VehicleFromPosXY(x, y, type, data, proc, false);
 }
 
 /**
@@ -457,30 +482,50 @@ void FindVehicleOnPosXY(int x, int y, void *data, VehicleFromPosProc *proc)
  */
 bool HasVehicleOnPosXY(int x, int y, void *data, VehicleFromPosProc *proc)
 {
-	return VehicleFromPosXY(x, y, data, proc, true) != nullptr;
+	return VehicleFromPosXY(x, y, VEH_INVALID, data, proc, true) != nullptr;
+}
+
+/**
+ * Checks whether a vehicle of a specific type is on a specific location.
+ * This works like #HasVehicleOnPosXY, but \a proc is only called for vehicles of the given type.
+ * @param x    The X location on the map
+ * @param y    The Y location on the map
+ * @param type The type of vehicles to look for.
+ * @param data Arbitrary data passed to proc
+ * @param proc The proc that determines whether a vehicle will be "found".
+ * @return True if proc returned non-nullptr.
+ */
+bool HasVehicleOnPosXY(int x, int y, VehicleType type, void *data, VehicleFromPosProc *proc)
+{
+	return VehicleFromPosXY(x, y, type, data, proc, true) != nullptr;
 }
 
 /**
  * Helper function for FindVehicleOnPos/HasVehicleOnPos.
  * @note Do not call this function directly!
  * @param tile The location on the map
+ * @param type The type of vehicles to look for, or #VEH_INVALID for all types.
  * @param data Arbitrary data passed to \a proc.
  * @param proc The proc that determines whether a vehicle will be "found".
  * @param find_first Whether to return on the first found or iterate over
  *                   all vehicles
  * @return the best matching or first vehicle (depending on find_first).
  */
-static Vehicle *VehicleFromPos(TileIndex tile, void *data, VehicleFromPosProc *proc, bool find_first)
+static Vehicle *VehicleFromPos(TileIndex tile, VehicleType type, void *data, VehicleFromPosProc *proc, bool find_first)
 {
 	int x = GB(TileX(tile), HASH_RES, HASH_BITS);
 	int y = GB(TileY(tile), HASH_RES, HASH_BITS) << HASH_BITS;
 
-	Vehicle *v = _vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
-	for (; v != nullptr; v = v->hash_tile_next) {
-		if (v->tile != tile) continue;
+	VehicleType first = type == VEH_INVALID ? VEH_BEGIN : type;
+	VehicleType last = type == VEH_INVALID ? VEH_END : static_cast<VehicleType>(type + 1);
+	for (VehicleType t = first; t != last; t++) {
+		Vehicle *v = _vehicle_tile_hash[t][(x + y) & TOTAL_HASH_MASK];
+		for (; v != nullptr; v = v->hash_tile_next) {
+			if (v->tile != tile) continue;
 
-		Vehicle *a = proc(v, data);
-		if (find_first && a != nullptr) return a;
+			Vehicle *a = proc(v, data);
+			if (find_first && a != nullptr) return a;
+		}
 	}
 
 	return nullptr;
@@ -501,7 +546,20 @@ static Vehicle *VehicleFromPos(TileIndex tile, void *data, VehicleFromPosProc *p
  */
 void FindVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc)
 {
-	VehicleFromPos(tile, data, proc, false);
+	VehicleFromPos(tile, VEH_INVALID, data, proc, false);
+}
+
+/**
+ * Find a vehicle of a specific type from a specific location.
+ * This works like #FindVehicleOnPos, but \a proc is only called for vehicles of the given type.
+ * @param tile The location on the map
+ * @param type The type of vehicles to look for.
+ * @param data Arbitrary data passed to \a proc.
+ * @param proc The proc that determines whether a vehicle will be "found".
+ */
+void FindVehicleOnPos(TileIndex tile, VehicleType type, void *data, VehicleFromPosProc *proc)
+{
+	VehicleFromPos(tile, type, data, proc, false);
 }
 
 /**
@@ -516,7 +574,61 @@ void FindVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc)
  */
 bool HasVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc)
 {
-	return VehicleFromPos(tile, data, proc, true) != nullptr;
+	return VehicleFromPos(tile, VEH_INVALID, data, proc, true) != nullptr;
+}
+
+/**
+ * Checks whether a vehicle of a specific type is on a specific location.
+ * This works like #HasVehicleOnPos, but \a proc is only called for vehicles of the given type.
+ * @param tile The location on the map
+ * @param type The type of vehicles to look for.
+ * @param data Arbitrary data passed to \a proc.
+ * @param proc The \a proc that determines whether a vehicle will be "found".
+ * @return True if proc returned non-nullptr.
+ */
+bool HasVehicleOnPos(TileIndex tile, VehicleType type, void *data, VehicleFromPosProc *proc)
+{
+	return VehicleFromPos(tile, type, data, proc, true) != nullptr;
+}
+
+/**
+ * Checks whether a vehicle of a specific type is listed at a specific location in the tile hash.
+ * This works like #HasVehicleOnPos, except for a vehicle that is being moved to another tile:
+ * it is found at the tile it was at when the hash was last updated, until the hash is updated again.
+ * @param tile The location on the map
+ * @param type The type of vehicles to look for.
+ * @param data Arbitrary data passed to \a proc.
+ * @param proc The \a proc that determines whether a vehicle will be "found".
+ * @return True if proc returned non-nullptr.
+ */
+bool HasVehicleInTileHash(TileIndex tile, VehicleType type, void *data, VehicleFromPosProc *proc)
+{
+	int x = GB(TileX(tile), HASH_RES, HASH_BITS);
+	int y = GB(TileY(tile), HASH_RES, HASH_BITS) << HASH_BITS;
+
+	for (Vehicle *v = _vehicle_tile_hash[type][(x + y) & TOTAL_HASH_MASK]; v != nullptr; v = v->hash_tile_next) {
+		if (v->hash_tile == tile && proc(v, data) != nullptr) return true;
+	}
+	return false;
+}
+
+/**
+ * Count the vehicles of a specific type that are listed at a specific location in the tile hash.
+ * @see HasVehicleInTileHash
+ * @param tile The location on the map
+ * @param type The type of vehicles to count.
+ * @return The number of vehicles.
+ */
+uint CountVehiclesInTileHash(TileIndex tile, VehicleType type)
+{
+	int x = GB(TileX(tile), HASH_RES, HASH_BITS);
+	int y = GB(TileY(tile), HASH_RES, HASH_BITS) << HASH_BITS;
+
+	uint count = 0;
+	for (const Vehicle *v = _vehicle_tile_hash[type][(x + y) & TOTAL_HASH_MASK]; v != nullptr; v = v->hash_tile_next) {
+		if (v->hash_tile == tile) count++;
+	}
+	return count;
 }
 
 /**
@@ -548,7 +660,7 @@ CommandCost EnsureNoVehicleOnGround(TileIndex tile)
 	 * error message only (which may be different for different machines).
 	 * Such a message does not affect MP synchronisation.
 	 */
-	Vehicle *v = VehicleFromPos(tile, &z, &EnsureNoVehicleProcZ, true);
+	Vehicle *v = VehicleFromPos(tile, VEH_INVALID, &z, &EnsureNoVehicleProcZ, true);
 	if (v != nullptr) return CommandCost(STR_ERROR_TRAIN_IN_THE_WAY + v->type);
 	return CommandCost();
 }
@@ -575,8 +687,8 @@ CommandCost TunnelBridgeIsFree(TileIndex tile, TileIndex endtile, const Vehicle
 	 * error message only (which may be different for different machines).
 	 * Such a message does not affect MP synchronisation.
 	 */
-	Vehicle *v = VehicleFromPos(tile, const_cast<Vehicle *>(ignore), &GetVehicleTunnelBridgeProc, true);
-	if (v == nullptr) v = VehicleFromPos(endtile, const_cast<Vehicle *>(ignore), &GetVehicleTunnelBridgeProc, true);
+	Vehicle *v = VehicleFromPos(tile, VEH_INVALID, const_cast<Vehicle *>(ignore), &GetVehicleTunnelBridgeProc, true);
+	if (v == nullptr) v = VehicleFromPos(endtile, VEH_INVALID, const_cast<Vehicle *>(ignore), &GetVehicleTunnelBridgeProc, true);
 
 	if (v != nullptr) return CommandCost(STR_ERROR_TRAIN_IN_THE_WAY + v->type);
 	return CommandCost();
@@ -608,13 +720,20 @@ CommandCost EnsureNoTrainOnTrackBits(TileIndex tile, TrackBits track_bits)
 	 * error message only (which may be different for different machines).
 	 * Such a message does not affect MP synchronisation.
 	 */
-	Vehicle *v = VehicleFromPos(tile, &track_bits, &EnsureNoTrainOnTrackProc, true);
+	Vehicle *v = VehicleFromPos(tile, VEH_TRAIN, &track_bits, &EnsureNoTrainOnTrackProc, true);
 	if (v != nullptr) return CommandCost(STR_ERROR_TRAIN_IN_THE_WAY + v->type);
 	return CommandCost();
 }
 
 static void UpdateVehicleTileHash(Vehicle *v, bool remove)
 {
+	/* Signal blocks count the trains listed at their tiles, also when the hash chain stays the same. */
+	TileIndex new_tile = remove ? INVALID_TILE : v->tile;
+	if (v->hash_tile != new_tile) {
+		if (v->type == VEH_TRAIN) MoveTrainInSignalBlocks(v->hash_tile, new_tile);
+		v->hash_tile = new_tile;
+	}
+
 	Vehicle **old_hash = v->hash_tile_current;
 	Vehicle **new_hash;
 
@@ -623,7 +742,7 @@ static void UpdateVehicleTileHash(Vehicle *v, bool remove)
 	} else {
 		int x = GB(TileX(v->tile), HASH_RES, HASH_BITS);
 		int y = GB(TileY(v->tile), HASH_RES, HASH_BITS) << HASH_BITS;
-		new_hash = &_vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
+		new_hash = &_vehicle_tile_hash[v->type][(x + y) & TOTAL_HASH_MASK];
 	}
 
 	if (old_hash == new_hash) return;
@@ -674,9 +793,14 @@ static void UpdateVehicleViewportHash(Vehicle *v, int x, int y, int old_x, int o
 
 void ResetVehicleHash()
 {
-	for (Vehicle *v : Vehicle::Iterate()) { v->hash_tile_current = nullptr; }
+	for (Vehicle *v : Vehicle::Iterate()) {
+		v->hash_tile_current = nullptr;
+		v->hash_tile = INVALID_TILE;
+	}
 	_vehicle_viewport_hash = {};
 	_vehicle_tile_hash = {};
+	/* The signal blocks counted the trains in the hash. */
+	InvalidateSignalBlocks();
 }
 
 void ResetVehicleColourMap()
@@ -977,6 +1101,17 @@ static void RunEconomyVehicleDayProc()
 	}
 }
 
+/** Names of the tick of each type of vehicle for the tick profiler. */
+static const char * const _vehicle_tick_zone_names[] = {
+	"Tick_Train",
+	"Tick_RoadVehicle",
+	"Tick_Ship",
+	"Tick_Aircraft",
+	"Tick_EffectVehicle",
+	"Tick_DisasterVehicle",
+};
+static_assert(lengthof(_vehicle_tick_zone_names) == VEH_END);
+
 void CallVehicleTicks()
 {
 	_vehicles_to_autoreplace.clear();
@@ -985,6 +1120,7 @@ void CallVehicleTicks()
 
 	{
 		PerformanceMeasurer framerate(PFE_GL_ECONOMY);
+		TickProfilerZone zone("LoadUnloadStation");
 		for (Station *st : Station::Iterate()) LoadUnloadStation(st);
 	}
 	PerformanceAccumulator::Reset(PFE_GL_TRAINS);
@@ -996,7 +1132,12 @@ void CallVehicleTicks()
 		[[maybe_unused]] VehicleID vehicle_index = v->index;
 
 		/* Vehicle could be deleted in this tick */
-		if (!v->Tick()) {
+		bool alive;
+		{
+			TickProfilerZone zone(_vehicle_tick_zone_names[v->type]);
+			alive = v->Tick();
+		}
+		if (!alive) {
 			assert(Vehicle::Get(vehicle_index) == nullptr);
 			continue;
 		}
@@ -2175,8 +2316,8 @@ void Vehicle::DeleteUnreachedImplicitOrders()
 			order = this->GetOrder(this->cur_implicit_order_index);
 		} else {
 			/* Skip non-implicit orders, e.g. service-orders */
-			order = order->next;
 			this->cur_implicit_order_index++;
+			order = this->GetOrder(this->cur_implicit_order_index);
 		}
 
 		/* Wrap around */
@@ -2267,8 +2408,8 @@ void Vehicle::BeginLoading()
 								order = this->GetOrder(this->cur_implicit_order_index);
 							} else {
 								/* Skip non-implicit orders, e.g. service-orders */
-								order = order->next;
 								this->cur_implicit_order_index++;
+								order = this->GetOrder(this->cur_implicit_order_index);
 							}
 
 							/* Wrap around */
@@ -2280,12 +2421,11 @@ void Vehicle::BeginLoading()
 						}
 					}
 				} else if (!suppress_implicit_orders &&
-						((this->orders == nullptr ? OrderList::CanAllocateItem() : this->orders->GetNumOrders() < MAX_VEH_ORDER_ID)) &&
-						Order::CanAllocateItem()) {
+						((this->orders == nullptr ? OrderList::CanAllocateItem() : this->orders->GetNumOrders() < MAX_VEH_ORDER_ID))) {
 					/* Insert new implicit order */
-					Order *implicit_order = new Order();
-					implicit_order->MakeImplicit(this->last_station_visited);
-					InsertOrder(this, implicit_order, this->cur_implicit_order_index);
+					Order implicit_order;
+					implicit_order.MakeImplicit(this->last_station_visited);
+					InsertOrder(this, std::move(implicit_order), this->cur_implicit_order_index);
 					if (this->cur_implicit_order_index > 0) --this->cur_implicit_order_index;
 
 					/* InsertOrder disabled creation of implicit orders for all vehicles with the same implicit order.
@@ -2961,7 +3101,7 @@ void Vehicle::AddToShared(Vehicle *shared_chain)
 	if (shared_chain->orders == nullptr) {
 		assert(shared_chain->previous_shared == nullptr);
 		assert(shared_chain->next_shared == nullptr);
-		this->orders = shared_chain->orders = new OrderList(nullptr, shared_chain);
+		this->orders = shared_chain->orders = new OrderList({}, shared_chain);
 	}
 
 	this->next_shared     = shared_chain->next_shared;
@@ -3277,13 +3417,9 @@ bool VehiclesHaveSameEngineList(const Vehicle *v1, const Vehicle *v2)
  */
 bool VehiclesHaveSameOrderList(const Vehicle *v1, const Vehicle *v2)
 {
-	const Order *o1 = v1->GetFirstOrder();
-	const Order *o2 = v2->GetFirstOrder();
-	while (true) {
-		if (o1 == nullptr && o2 == nullptr) return true;
-		if (o1 == nullptr || o2 == nullptr) return false;
-		if (!o1->Equals(*o2)) return false;
-		o1 = o1->next;
-		o2 = o2->next;
+	if (v1->GetNumOrders() != v2->GetNumOrders()) return false;
+	for (VehicleOrderID i = 0; i < v1->GetNumOrders(); i++) {
+		if (!v1->GetOrder(i)->Equals(*v2->GetOrder(i))) return false;
 	}
+	return true;
 }
@@ -24,6 +24,7 @@
 #include "saveload/saveload.h"
 #include "timer/timer_game_calendar.h"
 #include "core/mem_func.hpp"
+#include "newgrf_callbacks.h"
 
 const uint TILE_AXIAL_DISTANCE = 192;  // Logical length of the tile in any DiagDirection used in vehicle movement.
 const uint TILE_CORNER_DISTANCE = 128;  // Logical length of the tile corner crossing in any non-diagonal direction used in vehicle movement.
@@ -64,6 +65,37 @@ struct NewGRFCache {
 	auto operator<=>(const NewGRFCache &) const = default;
 };
 
+/**
+ * Results of NewGRF callbacks of a vehicle whose sprite group chain only depends on stable variables.
+ * @see VarStability
+ */
+struct NewGRFCallbackCache {
+	/** A single cached callback result. */
+	struct Entry {
+		CallbackID callback = CBID_NO_CALLBACK; ///< Resolved callback, #CBID_NO_CALLBACK if the entry is unused.
+		EngineID engine = EngineID::Invalid(); ///< Engine the callback was resolved for.
+		uint32_t param1 = 0; ///< First parameter (var 10) of the callback.
+		uint32_t param2 = 0; ///< Second parameter (var 18) of the callback.
+		CargoType cargo_type = INVALID_CARGO; ///< Cargo type of the vehicle when resolving, it is changed temporarily during refits.
+		uint8_t cargo_subtype = 0; ///< Cargo subtype of the vehicle when resolving.
+		bool date_dependent = false; ///< Whether the result is only valid for #date and #date_fract.
+		TimerGameCalendar::Date date{}; ///< Calendar date the result was resolved at.
+		TimerGameCalendar::DateFract date_fract = 0; ///< Calendar date fraction the result was resolved at.
+		uint16_t result = 0; ///< Result of the callback.
+	};
+
+	static constexpr size_t NUM_ENTRIES = 4; ///< Number of callback results that can be cached per vehicle.
+
+	std::array<Entry, NUM_ENTRIES> entries{}; ///< Cached results.
+	uint8_t next_entry = 0; ///< Entry to overwrite when storing a new result.
+
+	/** Forget all cached results. */
+	inline void Clear()
+	{
+		for (Entry &entry : this->entries) entry.callback = CBID_NO_CALLBACK;
+	}
+};
+
 /** Meaning of the various bits of the visual effect. */
 enum VisualEffect : uint8_t {
 	VE_OFFSET_START        = 0, ///< First bit that contains the offset (0 = front, 8 = centre, 15 = rear)
@@ -189,6 +221,7 @@ extern VehiclePool _vehicle_pool;
 /* Some declarations of functions, so we can make them friendly */
 struct GroundVehicleCache;
 struct LoadgameState;
+struct OldOrderSaveLoadItem;
 extern bool LoadOldVehicle(LoadgameState &ls, int num);
 extern void FixOldVehicles(LoadgameState &ls);
 
@@ -265,6 +298,7 @@ public:
 	Vehicle *hash_tile_next = nullptr; ///< NOSAVE: Next vehicle in the tile location hash.
 	Vehicle **hash_tile_prev = nullptr; ///< NOSAVE: Previous vehicle in the tile location hash.
 	Vehicle **hash_tile_current = nullptr; ///< NOSAVE: Cache of the current hash chain.
+	TileIndex hash_tile = INVALID_TILE; ///< NOSAVE: Tile the vehicle is listed at in the tile location hash.
 
 	SpriteID colourmap{}; ///< NOSAVE: cached colour mapping
 
@@ -338,10 +372,11 @@ public:
 
 	union {
 		OrderList *orders = nullptr; ///< Pointer to the order list for this vehicle
-		Order *old_orders; ///< Only used during conversion of old save games
+		OldOrderSaveLoadItem *old_orders; ///< Only used during conversion of old save games
 	};
 
 	NewGRFCache grf_cache{}; ///< Cache of often used calculated NewGRF values
+	mutable NewGRFCallbackCache grf_callback_cache{}; ///< NOSAVE: Cache of NewGRF callback results, invalidated together with #grf_cache.
 	VehicleCache vcache{}; ///< Cache of often used vehicle values.
 
 	GroupID group_id = GroupID::Invalid(); ///< Index of group Pool array
@@ -476,6 +511,7 @@ public:
 	inline void InvalidateNewGRFCache()
 	{
 		this->grf_cache.cache_valid = 0;
+		this->grf_callback_cache.Clear();
 	}
 
 	/**
@@ -1017,7 +1053,7 @@ public:
 
 	/**
 	 * Iterator to iterate orders
-	 * Supports deletion of current order
+	 * Does not support deletion of orders while iterating
 	 */
 	struct OrderIterator {
 		typedef Order value_type;
@@ -1026,35 +1062,29 @@ public:
 		typedef size_t difference_type;
 		typedef std::forward_iterator_tag iterator_category;
 
-		explicit OrderIterator(OrderList *list) : list(list), prev(nullptr)
-		{
-			this->order = (this->list == nullptr) ? nullptr : this->list->GetFirstOrder();
-		}
+		explicit OrderIterator(Order *order) : order(order) {}
 
 		bool operator==(const OrderIterator &other) const { return this->order == other.order; }
 		Order * operator*() const { return this->order; }
 		OrderIterator & operator++()
 		{
-			this->prev = (this->prev == nullptr) ? this->list->GetFirstOrder() : this->prev->next;
-			this->order = (this->prev == nullptr) ? nullptr : this->prev->next;
+			++this->order;
 			return *this;
 		}
 
 	private:
-		OrderList *list;
 		Order *order;
-		Order *prev;
 	};
 
 	/**
 	 * Iterable ensemble of orders
 	 */
 	struct IterateWrapper {
-		OrderList *list;
-		IterateWrapper(OrderList *list = nullptr) : list(list) {}
-		OrderIterator begin() { return OrderIterator(this->list); }
-		OrderIterator end() { return OrderIterator(nullptr); }
-		bool empty() { return this->begin() == this->end(); }
+		std::span<Order> orders;
+		IterateWrapper(OrderList *list = nullptr) : orders(list == nullptr ? std::span<Order>{} : list->GetOrders()) {}
+		OrderIterator begin() { return OrderIterator(this->orders.data()); }
+		OrderIterator end() { return OrderIterator(this->orders.data() + this->orders.size()); }
+		bool empty() { return this->orders.empty(); }
 	};
 
 	/**
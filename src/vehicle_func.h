@@ -42,9 +42,15 @@ typedef Vehicle *VehicleFromPosProc(Vehicle *v, void *data);
 void VehicleServiceInDepot(Vehicle *v);
 uint CountVehiclesInChain(const Vehicle *v);
 void FindVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc);
+void FindVehicleOnPos(TileIndex tile, VehicleType type, void *data, VehicleFromPosProc *proc);
 void FindVehicleOnPosXY(int x, int y, void *data, VehicleFromPosProc *proc);
+void FindVehicleOnPosXY(int x, int y, VehicleType type, void *data, VehicleFromPosProc *proc);
 bool HasVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc);
+bool HasVehicleOnPos(TileIndex tile, VehicleType type, void *data, VehicleFromPosProc *proc);
+bool HasVehicleInTileHash(TileIndex tile, VehicleType type, void *data, VehicleFromPosProc *proc);
+uint CountVehiclesInTileHash(TileIndex tile, VehicleType type);
 bool HasVehicleOnPosXY(int x, int y, void *data, VehicleFromPosProc *proc);
+bool HasVehicleOnPosXY(int x, int y, VehicleType type, void *data, VehicleFromPosProc *proc);
 void CallVehicleTicks();
 uint8_t CalcPercentVehicleFilled(const Vehicle *v, StringID *colour);
 
@@ -16,23 +16,28 @@
 /**
  * Find vehicles matching an order.
  * This can be used, e.g. to find all vehicles that stop at a particular station.
+ * Only order lists with an order to the given destination are searched, so the order predicate
+ * must only match orders to that destination. The functions must not change any orders.
+ * @param kind The kind of destination of the orders.
+ * @param destination The destination of the orders.
  * @param veh_pred Vehicle selection predicate. This is called only for the first vehicle using the order list.
  * @param ord_pred Order selection predicate.
  * @param veh_func Called for each vehicle that matches both vehicle and order predicates.
  **/
 template <class VehiclePredicate, class OrderPredicate, class VehicleFunc>
-void FindVehiclesWithOrder(VehiclePredicate veh_pred, OrderPredicate ord_pred, VehicleFunc veh_func)
+void FindVehiclesWithOrder(OrderDestinationKind kind, DestinationID destination, VehiclePredicate veh_pred, OrderPredicate ord_pred, VehicleFunc veh_func)
 {
-	for (const OrderList *orderlist : OrderList::Iterate()) {
+	for (const auto &[id, count] : GetOrderListsWithDestination(kind, destination)) {
+		const OrderList *orderlist = OrderList::Get(id);
 
 		/* We assume all vehicles sharing an order list match the condition. */
 		Vehicle *v = orderlist->GetFirstSharedVehicle();
 		if (!veh_pred(v)) continue;
 
 		/* Vehicle is a candidate, search for a matching order. */
-		for (const Order *order = orderlist->GetFirstOrder(); order != nullptr; order = order->next) {
+		for (const Order &order : orderlist->GetOrders()) {
 
-			if (!ord_pred(order)) continue;
+			if (!ord_pred(&order)) continue;
 
 			/* An order matches, we can add all shared vehicles to the list. */
 			for (; v != nullptr; v = v->NextShared()) {
@@ -31,11 +31,26 @@ std::optional<std::string_view> VideoDriver_Null::Start(const StringList &parm)
 	this->UpdateAutoResolution();
 
 	this->ticks = GetDriverParamInt(parm, "ticks", 1000);
+
+	const char *blitter = GetDriverParam(parm, "blitter");
+	this->benchmark = blitter != nullptr;
+	if (this->benchmark) {
+		/* Draw into memory with the given blitter, so its drawing performance can be measured. */
+		if (BlitterFactory::SelectBlitter(blitter) == nullptr) return "Failed to select the blitter to benchmark";
+		int bpp = BlitterFactory::GetCurrentBlitter()->GetScreenDepth();
+		if (bpp != 0) this->video_mem = std::make_unique<uint8_t[]>(static_cast<size_t>(_cur_resolution.width) * _cur_resolution.height * (bpp / 8));
+	}
+
 	_screen.width  = _screen.pitch = _cur_resolution.width;
 	_screen.height = _cur_resolution.height;
-	_screen.dst_ptr = nullptr;
+	_screen.dst_ptr = this->video_mem.get();
 	ScreenSizeChanged();
 
+	if (this->benchmark) {
+		BlitterFactory::GetCurrentBlitter()->PostResize();
+		return std::nullopt;
+	}
+
 	/* Do not render, nor blit */
 	Debug(misc, 1, "Forcing blitter 'null'...");
 	BlitterFactory::SelectBlitter("null");
@@ -50,10 +65,26 @@ void VideoDriver_Null::MainLoop()
 {
 	uint i;
 
+	std::chrono::steady_clock::duration draw_time{};
 	for (i = 0; i < this->ticks; i++) {
 		::GameLoop();
 		::InputLoop();
-		::UpdateWindows();
+
+		if (this->benchmark) {
+			/* Redraw everything, so each tick draws the same amount of pixels. */
+			MarkWholeScreenDirty();
+			auto start = std::chrono::steady_clock::now();
+			::UpdateWindows();
+			draw_time += std::chrono::steady_clock::now() - start;
+		} else {
+			::UpdateWindows();
+		}
+	}
+
+	if (this->benchmark && this->ticks != 0) {
+		auto us = std::chrono::duration_cast<std::chrono::microseconds>(draw_time).count();
+		Debug(driver, 0, "Blitter '{}' drew {} frames of {}x{} in {} us, {} us per frame",
+				BlitterFactory::GetCurrentBlitter()->GetName(), this->ticks, _screen.width, _screen.height, us, us / this->ticks);
 	}
 
 	/* If requested, make a save just before exit. The normal exit-flow is
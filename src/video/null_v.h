@@ -16,6 +16,8 @@
 class VideoDriver_Null : public VideoDriver {
 private:
 	uint ticks = 0; ///< Amount of ticks to run.
+	bool benchmark = false; ///< Whether to draw the whole screen every tick and measure how long that takes.
+	std::unique_ptr<uint8_t[]> video_mem; ///< Memory to draw into when benchmarking a blitter.
 
 public:
 	std::optional<std::string_view> Start(const StringList &param) override;
@@ -186,7 +186,7 @@ struct ViewportDrawer {
 	Point foundation_offset[FOUNDATION_PART_END];    ///< Pixel offset for ground sprites on the foundations.
 };
 
-static bool MarkViewportDirty(const Viewport *vp, int left, int top, int right, int bottom);
+static bool MarkViewportDirty(const Window *w, int left, int top, int right, int bottom);
 
 static ViewportDrawer _vd;
 
@@ -1555,7 +1555,7 @@ void ViewportSign::MarkDirty(ZoomLevel maxzoom) const
 		if (vp != nullptr && vp->zoom <= maxzoom) {
 			assert(vp->width != 0);
 			Rect &zl = zoomlevels[vp->zoom];
-			MarkViewportDirty(vp, zl.left, zl.top, zl.right, zl.bottom);
+			MarkViewportDirty(w, zl.left, zl.top, zl.right, zl.bottom);
 		}
 	}
 }
@@ -1568,13 +1568,13 @@ static void ViewportDrawTileSprites(const TileSpriteToDrawVector *tstdv)
 }
 
 /** This fallback sprite checker always exists. */
-static bool ViewportSortParentSpritesChecker()
+bool ViewportSortParentSpritesChecker()
 {
 	return true;
 }
 
 /** Sort parent sprites pointer array replicating the way original sorter did it. */
-static void ViewportSortParentSprites(ParentSpriteToSortVector *psdv)
+void ViewportSortParentSprites(ParentSpriteToSortVector *psdv)
 {
 	if (psdv->size() < 2) return;
 
@@ -2025,7 +2025,7 @@ void UpdateViewportPosition(Window *w, uint32_t delta_ms)
 
 /**
  * Marks a viewport as dirty for repaint if it displays (a part of) the area the needs to be repainted.
- * @param vp     The viewport to mark as dirty
+ * @param w      The window of the viewport to mark as dirty
  * @param left   Left edge of area to repaint
  * @param top    Top edge of area to repaint
  * @param right  Right edge of area to repaint
@@ -2033,8 +2033,10 @@ void UpdateViewportPosition(Window *w, uint32_t delta_ms)
  * @return true if the viewport contains a dirty block
  * @ingroup dirty
  */
-static bool MarkViewportDirty(const Viewport *vp, int left, int top, int right, int bottom)
+static bool MarkViewportDirty(const Window *w, int left, int top, int right, int bottom)
 {
+	const Viewport *vp = w->viewport;
+
 	/* Rounding wrt. zoom-out level */
 	right  += (1 << vp->zoom) - 1;
 	bottom += (1 << vp->zoom) - 1;
@@ -2053,7 +2055,7 @@ static bool MarkViewportDirty(const Viewport *vp, int left, int top, int right,
 
 	if (top >= vp->virtual_height) return false;
 
-	AddDirtyBlock(
+	AddDirtyBlock(w,
 		UnScaleByZoomLower(left, vp->zoom) + vp->left,
 		UnScaleByZoomLower(top, vp->zoom) + vp->top,
 		UnScaleByZoom(right, vp->zoom) + vp->left + 1,
@@ -2080,7 +2082,7 @@ bool MarkAllViewportsDirty(int left, int top, int right, int bottom)
 		Viewport *vp = w->viewport;
 		if (vp != nullptr) {
 			assert(vp->width != 0);
-			if (MarkViewportDirty(vp, left, top, right, bottom)) dirty = true;
+			if (MarkViewportDirty(w, left, top, right, bottom)) dirty = true;
 		}
 	}
 
@@ -3572,6 +3574,7 @@ struct ViewportSSCSS {
 /** List of sorters ordered from best to worst. */
 static ViewportSSCSS _vp_sprite_sorters[] = {
 #ifdef WITH_SSE
+	{ &ViewportSortParentSpritesAVX2Checker, &ViewportSortParentSpritesAVX2 },
 	{ &ViewportSortParentSpritesSSE41Checker, &ViewportSortParentSpritesSSE41 },
 #endif
 	{ &ViewportSortParentSpritesChecker, &ViewportSortParentSprites }
@@ -45,9 +45,14 @@ typedef bool (*VpSorterChecker)();
 /** Type for the actual viewport sprite sorter. */
 typedef void (*VpSpriteSorter)(ParentSpriteToSortVector *psd);
 
+bool ViewportSortParentSpritesChecker();
+void ViewportSortParentSprites(ParentSpriteToSortVector *psdv);
+
 #ifdef WITH_SSE
 bool ViewportSortParentSpritesSSE41Checker();
 void ViewportSortParentSpritesSSE41(ParentSpriteToSortVector *psdv);
+bool ViewportSortParentSpritesAVX2Checker();
+void ViewportSortParentSpritesAVX2(ParentSpriteToSortVector *psdv);
 #endif
 
 void InitializeSpriteSorter();
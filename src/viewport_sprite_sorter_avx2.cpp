@@ -0,0 +1,313 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file viewport_sprite_sorter_avx2.cpp Sprite sorter that buckets the sprites and uses AVX2. */
+
+#ifdef WITH_SSE
+
+#include "stdafx.h"
+#include "cpu.h"
+#include "core/bitmath_func.hpp"
+#include <immintrin.h>
+#include "viewport_sprite_sorter.h"
+
+#include "safeguards.h"
+
+/**
+ * The sprites that still have to be sorted, stored as structure of arrays so
+ * the bounding boxes of 8 sprites can be tested at once. The sprites are
+ * bucketed in a grid by their xmin and ymin, so only the buckets with
+ * xmin <= s->xmax and ymin <= s->ymax have to be tested for sprite s.
+ * The buckets of a column are stored after each other. Sprites are removed
+ * by moving the last sprite of their bucket in their place.
+ */
+class SpriteSortBuckets {
+public:
+	static constexpr uint LANES = 8; ///< Number of sprites that are tested at once.
+
+	std::vector<int32_t> xmin, ymin, zmin; ///< Minimal world coordinates of the bounding boxes.
+	std::vector<int32_t> xmax, ymax, zmax; ///< Maximal world coordinates of the bounding boxes.
+	std::vector<int32_t> sum;              ///< Sum of all coordinates of the bounding boxes, for the drawing order of overlapping boxes.
+	std::vector<uint32_t> id;              ///< Index of the sprite in the vector to sort.
+
+	std::vector<uint32_t> begin;  ///< First slot of each bucket.
+	std::vector<uint32_t> end;    ///< One past the last used slot of each bucket.
+	std::vector<uint32_t> slot;   ///< Slot of each sprite.
+	std::vector<uint32_t> bucket; ///< Bucket of each sprite.
+
+	std::vector<uint> first_row; ///< No bucket in a column before this row has any sprites.
+	uint first_column = 0;       ///< No column before this one has any sprites.
+
+	int32_t min_x = 0; ///< Lowest xmin of all sprites.
+	int32_t min_y = 0; ///< Lowest ymin of all sprites.
+	uint columns = 0;  ///< Number of buckets in X direction.
+	uint rows = 0;     ///< Number of buckets in Y direction.
+	uint shift = 0;    ///< Amount of bits to shift a coordinate to get its bucket.
+
+	explicit SpriteSortBuckets(const ParentSpriteToSortVector &sprites);
+
+	/**
+	 * Get the column of the buckets of an X coordinate, clamped to the existing columns.
+	 * @param x The X coordinate.
+	 * @return The column.
+	 */
+	inline uint GetColumn(int32_t x) const
+	{
+		if (x < this->min_x) return 0;
+		return std::min<uint>((static_cast<uint32_t>(x) - static_cast<uint32_t>(this->min_x)) >> this->shift, this->columns - 1);
+	}
+
+	/**
+	 * Get the row of the buckets of a Y coordinate, clamped to the existing rows.
+	 * @param y The Y coordinate.
+	 * @return The row.
+	 */
+	inline uint GetRow(int32_t y) const
+	{
+		if (y < this->min_y) return 0;
+		return std::min<uint>((static_cast<uint32_t>(y) - static_cast<uint32_t>(this->min_y)) >> this->shift, this->rows - 1);
+	}
+
+	/**
+	 * Remove a sprite from its bucket.
+	 * @param index Index of the sprite in the vector to sort.
+	 */
+	inline void Remove(uint index)
+	{
+		uint b = this->bucket[index];
+		uint to = this->slot[index];
+		uint from = --this->end[b];
+		if (to != from) {
+			this->xmin[to] = this->xmin[from];
+			this->ymin[to] = this->ymin[from];
+			this->zmin[to] = this->zmin[from];
+			this->xmax[to] = this->xmax[from];
+			this->ymax[to] = this->ymax[from];
+			this->zmax[to] = this->zmax[from];
+			this->sum[to] = this->sum[from];
+			this->id[to] = this->id[from];
+			this->slot[this->id[to]] = to;
+		}
+	}
+
+	void FindPreceding(const ParentSpriteToDraw *s, std::vector<uint32_t> &preceding);
+};
+
+/**
+ * Put all sprites in their buckets.
+ * @param sprites The sprites to sort.
+ */
+SpriteSortBuckets::SpriteSortBuckets(const ParentSpriteToSortVector &sprites)
+{
+	const size_t count = sprites.size();
+
+	int32_t max_x = INT32_MIN;
+	int32_t max_y = INT32_MIN;
+	this->min_x = INT32_MAX;
+	this->min_y = INT32_MAX;
+	for (const ParentSpriteToDraw *p : sprites) {
+		this->min_x = std::min(this->min_x, p->xmin);
+		this->min_y = std::min(this->min_y, p->ymin);
+		max_x = std::max(max_x, p->xmin);
+		max_y = std::max(max_y, p->ymin);
+	}
+
+	/* Aim for a few sprites per bucket; the buckets are tested as a whole. */
+	const uint32_t range_x = static_cast<uint32_t>(max_x) - static_cast<uint32_t>(this->min_x);
+	const uint32_t range_y = static_cast<uint32_t>(max_y) - static_cast<uint32_t>(this->min_y);
+	const uint64_t wanted_buckets = count / 8 + 1;
+	while ((static_cast<uint64_t>(range_x >> this->shift) + 1) * ((range_y >> this->shift) + 1) > wanted_buckets) this->shift++;
+	this->columns = (range_x >> this->shift) + 1;
+	this->rows = (range_y >> this->shift) + 1;
+	const size_t buckets = static_cast<size_t>(this->columns) * this->rows;
+
+	this->bucket.resize(count);
+	this->begin.assign(buckets + 1, 0);
+	for (size_t i = 0; i < count; i++) {
+		this->bucket[i] = this->GetColumn(sprites[i]->xmin) * this->rows + this->GetRow(sprites[i]->ymin);
+		this->begin[this->bucket[i] + 1]++;
+	}
+	for (size_t b = 0; b < buckets; b++) this->begin[b + 1] += this->begin[b];
+	this->end.assign(this->begin.begin(), this->begin.end() - 1);
+	this->begin.pop_back();
+	this->first_row.assign(this->columns, 0);
+
+	/* Pad the arrays, so the last sprites can be loaded as a full set of lanes. */
+	const size_t size = count + LANES;
+	for (auto *v : {&this->xmin, &this->ymin, &this->zmin, &this->xmax, &this->ymax, &this->zmax, &this->sum}) v->assign(size, 0);
+	this->id.assign(size, 0);
+	this->slot.resize(count);
+
+	for (size_t i = 0; i < count; i++) {
+		const ParentSpriteToDraw *p = sprites[i];
+		uint to = this->end[this->bucket[i]]++;
+		this->xmin[to] = p->xmin;
+		this->ymin[to] = p->ymin;
+		this->zmin[to] = p->zmin;
+		this->xmax[to] = p->xmax;
+		this->ymax[to] = p->ymax;
+		this->zmax[to] = p->zmax;
+		this->sum[to] = p->xmin + p->xmax + p->ymin + p->ymax + p->zmin + p->zmax;
+		this->id[to] = static_cast<uint32_t>(i);
+		this->slot[i] = to;
+	}
+}
+
+/**
+ * Find the sprites that have to be drawn before the given sprite, in the same way as the original sorter.
+ * The given sprite has to be removed already.
+ * @param s The sprite.
+ * @param[out] preceding The indices of the sprites that are drawn before the sprite.
+ */
+GNU_TARGET("avx2")
+void SpriteSortBuckets::FindPreceding(const ParentSpriteToDraw *s, std::vector<uint32_t> &preceding)
+{
+	const __m256i s_xmax = _mm256_set1_epi32(s->xmax);
+	const __m256i s_ymax = _mm256_set1_epi32(s->ymax);
+	const __m256i s_zmax = _mm256_set1_epi32(s->zmax);
+	const __m256i s_xmin = _mm256_set1_epi32(s->xmin);
+	const __m256i s_ymin = _mm256_set1_epi32(s->ymin);
+	const __m256i s_zmin = _mm256_set1_epi32(s->zmin);
+	const __m256i s_sum = _mm256_set1_epi32(s->xmin + s->xmax + s->ymin + s->ymax + s->zmin + s->zmax);
+	const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+	while (this->first_column < this->columns && this->first_row[this->first_column] == this->rows) this->first_column++;
+
+	/* We only need sprites with xmin <= s->xmax && ymin <= s->ymax. */
+	const uint last_column = this->GetColumn(s->xmax);
+	const uint last_row = this->GetRow(s->ymax);
+
+	for (uint column = this->first_column; column <= last_column; column++) {
+		const uint column_bucket = column * this->rows;
+		uint &row = this->first_row[column];
+		while (row < this->rows && this->begin[column_bucket + row] == this->end[column_bucket + row]) row++;
+
+		for (uint b = column_bucket + row; b <= column_bucket + last_row; b++) {
+			const uint bucket_end = this->end[b];
+			const __m256i last_slot = _mm256_set1_epi32(bucket_end - 1);
+			for (uint i = this->begin[b]; i < bucket_end; i += LANES) {
+				#define LOAD_LANES(v) _mm256_loadu_si256((const __m256i *)&this->v[i])
+				/* Sprites with p->xmin > s->xmax || p->ymin > s->ymax || p->zmin > s->zmax are never in front. */
+				__m256i skip = _mm256_cmpgt_epi32(LOAD_LANES(xmin), s_xmax);
+				skip = _mm256_or_si256(skip, _mm256_cmpgt_epi32(LOAD_LANES(ymin), s_ymax));
+				skip = _mm256_or_si256(skip, _mm256_cmpgt_epi32(LOAD_LANES(zmin), s_zmax));
+
+				/* Overlapping sprites are behind when their X+Y+Z is at least that of the current sprite. */
+				__m256i apart = _mm256_cmpgt_epi32(s_xmin, LOAD_LANES(xmax));
+				apart = _mm256_or_si256(apart, _mm256_cmpgt_epi32(s_ymin, LOAD_LANES(ymax)));
+				apart = _mm256_or_si256(apart, _mm256_cmpgt_epi32(s_zmin, LOAD_LANES(zmax)));
+				const __m256i behind = _mm256_andnot_si256(apart, _mm256_andnot_si256(_mm256_cmpgt_epi32(s_sum, LOAD_LANES(sum)), _mm256_set1_epi32(-1)));
+				#undef LOAD_LANES
+
+				/* Lanes past the end of the bucket are not sprites of this bucket. */
+				const __m256i unused = _mm256_cmpgt_epi32(_mm256_add_epi32(lanes, _mm256_set1_epi32(i)), last_slot);
+
+				uint mask = ~static_cast<uint>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_or_si256(_mm256_or_si256(skip, behind), unused)))) & 0xFF;
+				while (mask != 0) {
+					uint bit = FindFirstBit(mask);
+					preceding.push_back(this->id[i + bit]);
+					mask &= mask - 1;
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Sort parent sprites in the same order as the original sorter, but by looking up the preceding sprites in buckets.
+ * @param psdv The sprites to sort.
+ */
+void ViewportSortParentSpritesAVX2(ParentSpriteToSortVector *psdv)
+{
+	if (psdv->size() < 2) return;
+
+	/* The same ordering as the original sorter. The stack and orders refer to
+	 * the sprites by their index in the copy of the vector to sort, as the
+	 * vector itself is overwritten by the output. */
+	const uint32_t ORDER_COMPARED = UINT32_MAX; // Sprite was compared but we still need to compare the ones preceding it
+	const uint32_t ORDER_RETURNED = UINT32_MAX - 1; // Mark sorted sprite in case there are other occurrences of it in the stack
+	const ParentSpriteToSortVector sprites = *psdv;
+	SpriteSortBuckets buckets(sprites);
+
+	std::vector<uint32_t> order(sprites.size());
+	std::vector<uint32_t> sprite_order;
+	sprite_order.reserve(sprites.size() * 2);
+	uint32_t next_order = 0;
+	for (size_t i = sprites.size(); i-- != 0;) {
+		sprite_order.push_back(static_cast<uint32_t>(i));
+		order[i] = next_order++;
+	}
+
+	std::vector<uint32_t> preceding; // Temporarily stores sprites that precede current
+	auto out = psdv->begin(); // Iterator to output sorted sprites
+
+	while (!sprite_order.empty()) {
+		const uint32_t si = sprite_order.back();
+		sprite_order.pop_back();
+
+		/* Sprite is already sorted, ignore it. */
+		if (order[si] == ORDER_RETURNED) continue;
+
+		/* Sprite was already compared, just need to output it. */
+		if (order[si] == ORDER_COMPARED) {
+			*(out++) = sprites[si];
+			order[si] = ORDER_RETURNED;
+			continue;
+		}
+
+		const ParentSpriteToDraw *s = sprites[si];
+		buckets.Remove(si);
+		preceding.clear();
+		buckets.FindPreceding(s, preceding);
+
+		if (preceding.empty()) {
+			/* No preceding sprites, add current one to the output */
+			*(out++) = sprites[si];
+			order[si] = ORDER_RETURNED;
+			continue;
+		}
+
+		/* Optimization for the case when we only have 1 sprite to move. */
+		if (preceding.size() == 1) {
+			const uint32_t pi = preceding[0];
+			const ParentSpriteToDraw *p = sprites[pi];
+			/* We can only output the preceding sprite if there can't be any other sprites preceding it. */
+			if (p->xmax <= s->xmax && p->ymax <= s->ymax && p->zmax <= s->zmax) {
+				order[pi] = ORDER_RETURNED;
+				order[si] = ORDER_RETURNED;
+				buckets.Remove(pi);
+				*(out++) = sprites[pi];
+				*(out++) = sprites[si];
+				continue;
+			}
+		}
+
+		/* Sort all preceding sprites by order and assign new orders in reverse (as original sorter did). */
+		std::sort(preceding.begin(), preceding.end(), [&order](uint32_t a, uint32_t b) {
+			return order[a] > order[b];
+		});
+
+		order[si] = ORDER_COMPARED;
+		sprite_order.push_back(si); // Still need to output so push it back for now
+
+		for (uint32_t pi : preceding) {
+			order[pi] = next_order++;
+			sprite_order.push_back(pi);
+		}
+	}
+}
+
+/**
+ * Check whether the current CPU supports AVX2.
+ * @return True iff the CPU supports AVX2.
+ */
+bool ViewportSortParentSpritesAVX2Checker()
+{
+	return HasAVX2Support();
+}
+
+#endif /* WITH_SSE */
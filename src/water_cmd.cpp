@@ -14,6 +14,7 @@
 #include "town.h"
 #include "news_func.h"
 #include "depot_base.h"
+#include "depot_kdtree.h"
 #include "depot_func.h"
 #include "water.h"
 #include "industry_map.h"
@@ -164,6 +165,7 @@ CommandCost CmdBuildShipDepot(DoCommandFlags flags, TileIndex tile, Axis axis)
 		MarkTileDirtyByTile(tile);
 		MarkTileDirtyByTile(tile2);
 		MakeDefaultName(depot);
+		AddDepotToKdtree(depot);
 	}
 
 	return cost;
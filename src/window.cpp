@@ -918,8 +918,9 @@ static void DrawOverlappedWindow(Window *w, int left, int top, int right, int bo
  * @param top Top edge of the rectangle that should be repainted
  * @param right Right edge of the rectangle that should be repainted
  * @param bottom Bottom edge of the rectangle that should be repainted
+ * @param only_changed Only repaint the part of the windows whose content changed, see Window::redraw_area.
  */
-void DrawOverlappedWindowForAll(int left, int top, int right, int bottom)
+void DrawOverlappedWindowForAll(int left, int top, int right, int bottom, bool only_changed)
 {
 	DrawPixelInfo bk;
 	AutoRestoreBackup dpi_backup(_cur_dpi, &bk);
@@ -931,7 +932,19 @@ void DrawOverlappedWindowForAll(int left, int top, int right, int bottom)
 				left < w->left + w->width &&
 				top < w->top + w->height) {
 			/* Window w intersects with the rectangle => needs repaint */
-			DrawOverlappedWindow(w, std::max(left, w->left), std::max(top, w->top), std::min(right, w->left + w->width), std::min(bottom, w->top + w->height));
+			int l = std::max(left, w->left);
+			int t = std::max(top, w->top);
+			int r = std::min(right, w->left + w->width);
+			int b = std::min(bottom, w->top + w->height);
+			if (only_changed) {
+				/* The rest of the window is still on the screen, as windows are opaque. */
+				l = std::max(l, w->left + w->redraw_area.left);
+				t = std::max(t, w->top + w->redraw_area.top);
+				r = std::min(r, w->left + w->redraw_area.right + 1);
+				b = std::min(b, w->top + w->redraw_area.bottom + 1);
+				if (l >= r || t >= b) continue;
+			}
+			DrawOverlappedWindow(w, l, t, r, b);
 		}
 	}
 }
@@ -317,6 +317,10 @@ public:
 	Owner owner = INVALID_OWNER; ///< The owner of the content shown in this window. Company colour is acquired from this variable.
 
 	ViewportData *viewport = nullptr; ///< Pointer to viewport data, if present.
+
+	static constexpr Rect NO_DIRTY_AREA{0, 0, -1, -1}; ///< Empty dirty area.
+	mutable Rect dirty_area = NO_DIRTY_AREA; ///< Part of the window, relative to its top left corner, whose content changed since the last redraw.
+	mutable Rect redraw_area = NO_DIRTY_AREA; ///< Part of the window, relative to its top left corner, that the current redraw repaints.
 	const NWidgetCore *nested_focus = nullptr; ///< Currently focused nested widget, or \c nullptr if no nested widget has focus.
 	std::map<WidgetID, QueryString*> querystrings{}; ///< QueryString associated to WWT_EDITBOX widgets.
 	std::unique_ptr<NWidgetBase> nested_root{}; ///< Root of the nested tree.
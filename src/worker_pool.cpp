@@ -0,0 +1,130 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file worker_pool.cpp Threads for running independent jobs of the game loop in parallel. */
+
+#include "stdafx.h"
+#include "worker_pool.h"
+#include "thread.h"
+
+#include "safeguards.h"
+
+/** Maximum number of threads, besides the game thread, to run jobs on. */
+static const uint MAX_WORKER_THREADS = 8;
+
+/** Stop the worker threads. */
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> guard(this->lock);
+		this->stop = true;
+	}
+	this->work_available.notify_all();
+	for (std::thread &thread : this->threads) {
+		if (thread.joinable()) thread.join();
+	}
+}
+
+/** Start the worker threads. */
+void WorkerPool::Start()
+{
+	this->started = true;
+
+	/* Workers wait for the batch after the current one, even when they start after it has been handed out. */
+	uint64_t last_batch = this->batch;
+	for (uint i = 0; i < this->workers; i++) {
+		std::thread thread;
+		if (!StartNewThread(&thread, "ottd:worker", [this, last_batch]() { this->WorkerThread(last_batch); })) break;
+		this->threads.push_back(std::move(thread));
+	}
+	Debug(misc, 1, "Started {} worker threads", this->threads.size());
+}
+
+/** Run jobs of the current batch until there are none left. */
+void WorkerPool::RunJobs()
+{
+	for (size_t i = this->next++; i < this->count; i = this->next++) {
+		(*this->job)(i);
+	}
+}
+
+/**
+ * Main loop of a worker thread.
+ * @param last_batch The number of the batch before the first one this thread has to work on.
+ */
+void WorkerPool::WorkerThread(uint64_t last_batch)
+{
+	std::unique_lock<std::mutex> guard(this->lock);
+	for (;;) {
+		this->work_available.wait(guard, [this, last_batch]() { return this->stop || this->batch != last_batch; });
+		if (this->stop) return;
+		last_batch = this->batch;
+
+		guard.unlock();
+		this->RunJobs();
+		guard.lock();
+
+		if (--this->busy == 0) this->work_done.notify_one();
+	}
+}
+
+/**
+ * Run a batch of jobs on the worker threads and the calling thread, and wait till all are done.
+ * @param count The number of jobs.
+ * @param job The function to run each job.
+ */
+void WorkerPool::Run(size_t count, const WorkerJob &job)
+{
+	if (!this->started) this->Start();
+
+	if (this->threads.empty() || count < 2) {
+		for (size_t i = 0; i < count; i++) job(i);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(this->lock);
+		this->job = &job;
+		this->count = count;
+		this->next = 0;
+		this->busy = this->threads.size();
+		this->batch++;
+	}
+	this->work_available.notify_all();
+
+	this->RunJobs();
+
+	std::unique_lock<std::mutex> guard(this->lock);
+	this->work_done.wait(guard, [this]() { return this->busy == 0; });
+	this->job = nullptr;
+	this->count = 0;
+}
+
+/**
+ * Get the number of worker threads for the game, one less than there are cores as the game thread runs jobs as well.
+ * @return The number of worker threads.
+ */
+static uint GetWorkerThreadCount()
+{
+	uint cores = std::thread::hardware_concurrency();
+	return std::min(cores > 1 ? cores - 1 : 0, MAX_WORKER_THREADS);
+}
+
+static WorkerPool _worker_pool(GetWorkerThreadCount()); ///< The pool of worker threads of the game.
+
+/**
+ * Run a batch of independent jobs in parallel, and wait till all are done.
+ * The order in which the jobs run, and the thread they run on, is undefined. So
+ * jobs must not depend on each other, and must not change any game state that
+ * other jobs might read, or the game goes out of sync between clients.
+ * @param count The number of jobs.
+ * @param job The function to run each job, gets the index of the job.
+ */
+void RunWorkerJobs(size_t count, const WorkerJob &job)
+{
+	_worker_pool.Run(count, job);
+}
@@ -0,0 +1,61 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file worker_pool.h Threads for running independent jobs of the game loop in parallel. */
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * Type of the function that runs a single job.
+ * The job gets the index of the job, from 0 up to the number of jobs.
+ */
+using WorkerJob = std::function<void(size_t)>;
+
+/**
+ * Threads that wait for jobs, and run them together with the thread that hands them out.
+ * The threads are started when jobs are first handed out, and live until the pool is destroyed.
+ */
+class WorkerPool {
+public:
+	/**
+	 * Create the pool.
+	 * @param workers The number of threads to start, besides the thread that hands out the jobs.
+	 */
+	explicit WorkerPool(uint workers) : workers(workers) {}
+	~WorkerPool();
+
+	void Run(size_t count, const WorkerJob &job);
+
+private:
+	uint workers; ///< The number of worker threads to start.
+	std::vector<std::thread> threads{}; ///< The worker threads.
+	bool started = false; ///< Whether starting the worker threads has been attempted.
+
+	std::mutex lock{}; ///< Lock for the state below, except #next.
+	std::condition_variable work_available{}; ///< Signalled when a batch of jobs is handed out, or the threads must stop.
+	std::condition_variable work_done{}; ///< Signalled when the last worker thread has finished its part of a batch.
+	const WorkerJob *job = nullptr; ///< Function to run the jobs of the current batch.
+	size_t count = 0; ///< Number of jobs in the current batch.
+	std::atomic<size_t> next{0}; ///< Index of the next job of the current batch to run.
+	size_t busy = 0; ///< Number of worker threads that are still working on the current batch.
+	uint64_t batch = 0; ///< Number of the current batch.
+	bool stop = false; ///< Whether the worker threads must stop.
+
+	void Start();
+	void RunJobs();
+	void WorkerThread(uint64_t last_batch);
+};
+
+void RunWorkerJobs(size_t count, const WorkerJob &job);
+
+#endif /* WORKER_POOL_H */